@@ -0,0 +1,157 @@
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * pluggable memory allocation used by every table, column and hash table.
+ *
+ * by default everything goes through malloc/realloc/free. a custom allocator
+ * can be set globally with dt_set_default_allocator() (used by every table/column
+ * created afterwards) or per table with dt_table_create_with_allocator().
+ */
+
+struct dt_allocator
+{
+	// allocate [size] bytes. returns NULL on failure.
+	void* (*allocate)(void* context, size_t size);
+
+	// resize [ptr] (previously [old_size] bytes) to [new_size] bytes and return the
+	// (possibly moved) pointer. returns NULL on failure, leaving [ptr] untouched.
+	void* (*reallocate)(void* context, void* ptr, size_t old_size, size_t new_size);
+
+	// release [ptr]. may be a no-op (e.g., for arenas).
+	void (*deallocate)(void* context, void* ptr);
+
+	// user data passed to each of the callbacks above
+	void* context;
+
+	// (optional) allocate [size] bytes aligned to [alignment] (a power of two).
+	// the memory must be releasable with deallocate(). returns NULL on failure.
+	// if NULL, aligned buffers are over-allocated with allocate() instead.
+	void* (*allocate_aligned)(void* context, size_t alignment, size_t size);
+};
+
+// alignment (in bytes) of column value buffers, null value (validity) buffers and
+// selection buffers (e.g., from dt_column_filter). the size of these buffers is also
+// padded to a multiple of this, so vector loads past the last element stay in bounds.
+#define DT_BUFFER_ALIGNMENT 64
+
+// return the allocator used for newly-created tables/columns (malloc-based unless changed).
+const struct dt_allocator*
+dt_get_default_allocator(void);
+
+// set the allocator used for newly-created tables/columns.
+// existing tables/columns keep the allocator they were created with.
+// pass NULL to restore the malloc-based allocator.
+// the allocator must outlive every table/column created with it.
+void
+dt_set_default_allocator(
+	const struct dt_allocator* const allocator);
+
+// wrappers around the allocator callbacks (used internally but exposed to the public).
+void*
+dt_alloc(
+	const struct dt_allocator* const allocator,
+	const size_t size);
+
+// same as dt_alloc but zeroes the memory (like calloc)
+void*
+dt_calloc(
+	const struct dt_allocator* const allocator,
+	const size_t n_items,
+	const size_t item_size);
+
+void*
+dt_realloc(
+	const struct dt_allocator* const allocator,
+	void* ptr,
+	const size_t old_size,
+	const size_t new_size);
+
+void
+dt_free(
+	const struct dt_allocator* const allocator,
+	void* ptr);
+
+// duplicate a NULL-terminated string using [allocator].
+// returns NULL on failure.
+char*
+dt_strdup(
+	const struct dt_allocator* const allocator,
+	const char* const str);
+
+// round [size] up to a (non-zero) multiple of DT_BUFFER_ALIGNMENT
+size_t
+dt_padded_size(
+	const size_t size);
+
+// allocate a zeroed buffer of [n_items] * [item_size] bytes aligned to DT_BUFFER_ALIGNMENT
+// and padded with dt_padded_size(). the padding is zeroed as well.
+// must be released with dt_aligned_free() using the same allocator.
+// returns NULL on failure.
+void*
+dt_aligned_calloc(
+	const struct dt_allocator* const allocator,
+	const size_t n_items,
+	const size_t item_size);
+
+// resize an aligned buffer (previously [old_size] bytes) to [new_size] bytes.
+// the first min(old_size, new_size) bytes are kept and everything after them
+// (including the padding) is zeroed. the alignment is preserved, which the allocator's
+// reallocate() can't guarantee: the buffer is always moved (allocated, copied and freed).
+// returns NULL on failure, leaving [ptr] untouched.
+void*
+dt_aligned_realloc(
+	const struct dt_allocator* const allocator,
+	void* ptr,
+	const size_t old_size,
+	const size_t new_size);
+
+// release a buffer from dt_aligned_calloc/dt_aligned_realloc (NULL is ignored)
+void
+dt_aligned_free(
+	const struct dt_allocator* const allocator,
+	void* ptr);
+
+/*
+ * a bump (arena) allocator for short-lived tables (filter outputs, join scratch,
+ * hash bins, etc.)
+ *
+ * allocations are carved out of large blocks and individual frees are no-ops;
+ * everything is released at once with dt_arena_reset() or dt_arena_free().
+ * an arena is NOT thread-safe; use one arena per thread/request.
+ */
+struct dt_arena;
+
+// create a new arena that allocates blocks of (at least) [block_size] bytes.
+// pass 0 to use a default block size.
+// returns NULL on failure.
+struct dt_arena*
+dt_arena_create(
+	const size_t block_size);
+
+// get the allocator backed by [arena] (to pass to dt_table_create_with_allocator, etc.)
+const struct dt_allocator*
+dt_arena_allocator(
+	struct dt_arena* const arena);
+
+// total number of bytes handed out by the arena since it was created/reset
+size_t
+dt_arena_bytes_used(
+	const struct dt_arena* const arena);
+
+// release every allocation made from the arena in one shot (the first block is kept
+// for reuse). every table/column allocated from the arena becomes invalid and must
+// NOT be used (or freed) afterwards.
+void
+dt_arena_reset(
+	struct dt_arena* const arena);
+
+// free the arena and all of its memory.
+void
+dt_arena_free(
+	struct dt_arena** const arena);
+
+#endif
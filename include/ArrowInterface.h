@@ -0,0 +1,96 @@
+#ifndef ARROW_INTERFACE_H
+#define ARROW_INTERFACE_H
+
+#include <stdint.h>
+
+#include "DataTable.h"
+
+/*
+ * tables exchanged with other libraries (pyarrow, DuckDB, Polars, ...) through the Arrow C
+ * data interface (https://arrow.apache.org/docs/format/CDataInterface.html), without any
+ * Arrow dependency: a table is a struct array ("+s") with one child per column.
+ *
+ * column types map to Arrow types as follows:
+ *   INT8 ... INT64, UINT8 ... UINT64   int8 ... int64, uint8 ... uint64
+ *   FLOAT, DOUBLE                      float32, float64
+ *   BOOL                               boolean
+ *   DATE                               date32 (days)
+ *   TIMESTAMP                          timestamp[unit, tz=UTC] (any time zone when importing)
+ *   STRING                             utf8 (large_utf8 past 2GB of text; both when importing)
+ *
+ * numbers, dates and timestamps use the same layout in both, so their buffers are shared
+ * instead of copied (except for chunked columns, which are copied into one buffer). null
+ * values are converted between index lists and validity bitmaps, BOOL values are copied when
+ * importing (Arrow doesn't guarantee whole 64-bit words) and STRING values are always copied:
+ * Arrow strings are packed in one buffer of bytes, not null-terminated.
+ */
+
+// the structures of the Arrow C data interface ABI (the guard is shared with other headers
+// defining them, e.g. Arrow's own abi.h)
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema
+{
+	// array type description
+	const char* format;
+	const char* name;
+	const char* metadata;
+	int64_t flags;
+	int64_t n_children;
+	struct ArrowSchema** children;
+	struct ArrowSchema* dictionary;
+
+	// release callback
+	void (*release)(struct ArrowSchema*);
+	// opaque producer-specific data
+	void* private_data;
+};
+
+struct ArrowArray
+{
+	// array data description
+	int64_t length;
+	int64_t null_count;
+	int64_t offset;
+	int64_t n_buffers;
+	int64_t n_children;
+	const void** buffers;
+	struct ArrowArray** children;
+	struct ArrowArray* dictionary;
+
+	// release callback
+	void (*release)(struct ArrowArray*);
+	// opaque producer-specific data
+	void* private_data;
+};
+
+#endif
+
+// fill [schema] and [array] with a struct array of the columns of [table], to be handed to
+// a consumer which calls their release callbacks when it's done with them.
+// the values of most columns are shared (see above): [table] must outlive [array] and must
+// not be modified until [array] is released.
+// returns DT_ALLOC_ERROR if couldn't allocate memory ([schema] and [array] are left untouched).
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_table_export_arrow(
+	const struct DataTable* const table,
+	struct ArrowSchema* const schema,
+	struct ArrowArray* const array);
+
+// create a table from a struct array (e.g. a record batch exported by pyarrow) described by
+// [schema]. [schema] is only read (the caller still releases it); [array] is moved into the
+// table (its release callback is set to NULL), which shares its buffers (see above) like
+// a view (see dt_column_wrap) and releases it when freed. on failure [array] isn't moved.
+// returns NULL on failure (e.g. a column of an unsupported type, or out of memory)
+struct DataTable*
+dt_table_import_arrow(
+	const struct ArrowSchema* const schema,
+	struct ArrowArray* const array);
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef COMPRESSED_COLUMN_H
+#define COMPRESSED_COLUMN_H
+
+#include <stdio.h>
+
+#include "DataColumn.h"
+#include "DataTable.h"
+
+/*
+ * lightweight, read-only compressed encodings for integer columns
+ * (INT8 ... INT64, UINT8 ... UINT64, DATE and TIMESTAMP).
+ *
+ * aggregates, filters and decoding work directly on the encoded data:
+ * min/max only read the per-block (or per-run) headers, sums and filters
+ * unpack offsets without materializing the whole column and blocks that
+ * can't match a filter are skipped entirely.
+ *
+ * null values are stored as 0 (the same as in the column they came from) and
+ * their indices are kept, so decompressing gives back an identical column.
+ */
+
+enum dt_encoding_e
+{
+	// (value, run length) pairs. best for low-cardinality or sorted columns with repeats.
+	DT_ENCODING_RLE,
+	// first value + bit-packed differences between consecutive values.
+	// best for sorted IDs and timestamps.
+	DT_ENCODING_DELTA,
+	// frame-of-reference: per block minimum + bit-packed offsets from it.
+	// best for values within a small range (e.g., counters).
+	DT_ENCODING_FOR
+};
+
+#define DT_N_ENCODINGS 3
+
+// number of values per bit-packed block (DT_ENCODING_DELTA and DT_ENCODING_FOR)
+#define DT_COMPRESSION_BLOCK_SIZE 1024
+
+// a block of up to DT_COMPRESSION_BLOCK_SIZE bit-packed values.
+// values are stored as order-preserving unsigned keys (see CompressedColumn.c)
+struct CompressedBlock
+{
+	size_t n_values;
+
+	// smallest/largest key in the block (used to skip blocks and for min/max)
+	uint64_t min;
+	uint64_t max;
+
+	// DT_ENCODING_FOR: the block minimum.
+	// DT_ENCODING_DELTA: the first key of the block.
+	uint64_t reference;
+
+	// DT_ENCODING_DELTA: the smallest difference, which is subtracted before packing
+	uint64_t delta_reference;
+
+	// number of bits per packed value (0 - 64)
+	uint8_t bit_width;
+	uint64_t* packed;
+};
+
+// treat every member as read-only
+struct CompressedColumn
+{
+	enum data_type_e type;
+	// TIMESTAMP columns only
+	enum dt_time_unit_e time_unit;
+	enum dt_encoding_e encoding;
+	size_t n_values;
+
+	// DT_ENCODING_DELTA and DT_ENCODING_FOR
+	struct CompressedBlock* blocks;
+	size_t n_blocks;
+
+	// DT_ENCODING_RLE
+	uint64_t* run_values;
+	size_t* run_lengths;
+	size_t n_runs;
+
+	// copied from the source column
+	size_t* null_value_indices;
+	size_t n_null_values;
+
+	const struct dt_allocator* allocator;
+};
+
+// compress an integer column with the given encoding.
+// the compressed column uses the same allocator as [column].
+// returns NULL if the column isn't an integer type or if couldn't allocate memory.
+struct CompressedColumn*
+dt_column_compress(
+	const struct DataColumn* const column,
+	const enum dt_encoding_e encoding);
+
+// free a compressed column and set it to NULL
+void
+dt_compressed_column_free(
+	struct CompressedColumn** const column);
+
+// number of bytes held by the compressed column (headers included)
+size_t
+dt_compressed_column_size(
+	const struct CompressedColumn* const column);
+
+// decode every value into [buffer] which must hold n_values values of the column's type
+void
+dt_compressed_column_decode(
+	const struct CompressedColumn* const column,
+	void* buffer);
+
+// decode back into a regular column (null values included).
+// returns NULL if couldn't allocate memory.
+struct DataColumn*
+dt_compressed_column_decompress(
+	const struct CompressedColumn* const column);
+
+// same as dt_column_sum: add every value to [result] (of the column's type)
+void
+dt_compressed_column_sum(
+	const struct CompressedColumn* const column,
+	void* result);
+
+// same as dt_column_max/dt_column_min: store the largest/smallest value into [result].
+// only the block/run headers are read.
+void
+dt_compressed_column_max(
+	const struct CompressedColumn* const column,
+	void* result);
+
+void
+dt_compressed_column_min(
+	const struct CompressedColumn* const column,
+	void* result);
+
+// same as dt_column_filter: returns an array of 0/1 (one per value) marking the values
+// equal to [value] (a pointer to a value of the column's type).
+// release it with dt_aligned_free(column->allocator, array).
+// returns NULL if couldn't allocate memory.
+size_t*
+dt_compressed_column_filter_equal(
+	const struct CompressedColumn* const column,
+	const void* const value);
+
+// same as dt_compressed_column_filter_equal but marks values within [lower, upper] (inclusive)
+size_t*
+dt_compressed_column_filter_range(
+	const struct CompressedColumn* const column,
+	const void* const lower,
+	const void* const upper);
+
+struct CompressionReport
+{
+	enum dt_encoding_e encoding;
+	size_t uncompressed_bytes;
+	size_t compressed_bytes;
+
+	// uncompressed_bytes / compressed_bytes
+	double ratio;
+
+	// wall-clock time to compress/decode the whole column
+	double compress_seconds;
+	double decode_seconds;
+};
+
+// compress [column] with every encoding and fill reports[0 ... DT_N_ENCODINGS - 1]
+// (indexed by enum dt_encoding_e) with the resulting size and speed.
+// returns DT_TYPE_MISMATCH if the column isn't an integer type.
+// returns DT_ALLOC_ERROR if couldn't allocate memory.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_column_compression_report(
+	const struct DataColumn* const column,
+	struct CompressionReport* const reports);
+
+// print the compression report of every integer column in [table] to [stream]
+void
+dt_table_print_compression_report(
+	const struct DataTable* const table,
+	FILE* stream);
+
+#endif
@@ -0,0 +1,230 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "Allocator.h"
+#include "StatusCodes.h"
+
+/*
+ * low-level CSV input and tokenizing used by dt_table_read_csv.
+ *
+ * the whole input is made available as one read-only buffer (memory-mapped when
+ * the file allows it, otherwise read in large blocks) and every record is split
+ * in a single pass into spans (offset, length) pointing into that buffer, so
+ * neither the line length nor the number of columns is limited.
+ *
+ * with SSE2 or AVX2 (see dt_csv_detect_simd), 64-byte blocks are classified with vector
+ * compares into bitmasks of delimiters, quotes and line breaks and quoted regions are
+ * resolved with a prefix-XOR of the quote mask, so fields are found without looking at
+ * every character. records with quotes in the middle of a field (see below) are handed
+ * to the one-character-at-a-time tokenizer, which gives the same result for everything else.
+ *
+ * quoting follows RFC-4180: a field starting with a double quote may contain
+ * delimiters, newlines and doubled quotes ("") which stand for a single quote.
+ * for compatibility, a quote (' or ") appearing in the middle of an unquoted
+ * field still protects delimiters up to the matching quote and is kept verbatim.
+ *
+ * gzip and zstd inputs are recognized by their first bytes and decompressed block by
+ * block with zlib and libzstd when the library was built with them (see
+ * dt_csv_compression_supported).
+ *
+ * streams are read (and decompressed) ahead of the parser by their own thread into a
+ * ring of 1MB blocks, so the disk (or network) and the decompression keep working while
+ * the previous blocks are parsed.
+ */
+
+// compression of a CSV input or output
+enum dt_csv_compression_e
+{
+	DT_CSV_COMPRESSION_NONE,
+	DT_CSV_COMPRESSION_GZIP,
+	DT_CSV_COMPRESSION_ZSTD
+};
+
+// reads (and decompresses) a dt_csv_stream ahead of the parser (see CsvReader.c)
+struct dt_csv_decoder;
+
+// an entire CSV input
+struct dt_csv_source
+{
+	const char* data;
+	size_t size;
+
+	// set when [data] is a memory mapping, otherwise it's a buffer
+	// allocated with [allocator] (the default allocator at open time)
+	bool is_mapped;
+	const struct dt_allocator* allocator;
+};
+
+// an input read front to back in blocks (e.g. a pipe, or a file larger than memory).
+// [window] holds the bytes read but not yet dropped with dt_csv_stream_read
+struct dt_csv_stream
+{
+	struct dt_csv_source window;
+	size_t capacity;
+
+	FILE* file;
+	bool is_eof;
+
+	// stdin is left open by dt_csv_stream_close
+	bool owns_file;
+
+	// the window is filled from the blocks read ahead by [decoder] (decompressed if needed)
+	enum dt_csv_compression_e compression;
+	struct dt_csv_decoder* decoder;
+};
+
+// a single field: [length] bytes starting at [offset] in the source data.
+// quoted fields include their enclosing quotes (see dt_csv_span_copy).
+struct dt_csv_span
+{
+	size_t offset;
+	size_t length;
+	bool is_quoted;
+};
+
+// instruction sets used to find delimiters, quotes and line breaks 64 bytes at a time
+enum dt_csv_simd_e
+{
+	// one character at a time
+	DT_CSV_SIMD_NONE,
+	DT_CSV_SIMD_SSE2,
+	DT_CSV_SIMD_AVX2
+};
+
+// the fields of the last tokenized record. the span array grows as needed
+// and is reused between records.
+struct dt_csv_record
+{
+	struct dt_csv_span* spans;
+	size_t n_spans;
+	size_t capacity;
+	const struct dt_allocator* allocator;
+
+	// set to dt_csv_detect_simd() by dt_csv_record_init; can be lowered (e.g. to compare results)
+	enum dt_csv_simd_e simd;
+
+	// character classes of the last 64-byte block scanned, reused by the next record.
+	// block_data is NULL until a block is scanned; set it back to NULL if the data
+	// at the same address changes
+	const char* block_data;
+	size_t block_offset;
+	char block_delim;
+	uint64_t block_masks[4];
+};
+
+// compression of an input starting with the [size] bytes at [data] (from its magic number)
+enum dt_csv_compression_e
+dt_csv_compression_from_data(
+	const void* const data,
+	const size_t size);
+
+// compression of a file to be written to [filepath] (from its extension: .gz or .zst)
+enum dt_csv_compression_e
+dt_csv_compression_from_path(
+	const char* const filepath);
+
+// whether the library was built with the library handling [compression] (zlib or libzstd)
+bool
+dt_csv_compression_supported(
+	const enum dt_csv_compression_e compression);
+
+// map (or read) the file at [filepath] into [source]. compressed files are decompressed
+// into memory.
+// returns DT_FAILURE if the file can't be opened or read (or decompressed).
+// returns DT_ALLOC_ERROR if couldn't allocate memory.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_csv_source_open(
+	const char* const filepath,
+	struct dt_csv_source* const source);
+
+// release the data of [source]
+void
+dt_csv_source_close(
+	struct dt_csv_source* const source);
+
+// open the file at [filepath], or stdin if [filepath] is NULL or "-", to be read with
+// dt_csv_stream_read. the window starts empty.
+// returns DT_FAILURE if the file can't be opened or is compressed with an unsupported format.
+// returns DT_ALLOC_ERROR if couldn't allocate memory.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_csv_stream_open(
+	const char* const filepath,
+	struct dt_csv_stream* const stream);
+
+// drop the first [consumed] bytes of the window, move the rest to its start and append the next
+// block of the input after it (growing the window if less than half a block is free), or set
+// stream->is_eof at the end of the input. records tokenized from the window before must be
+// reset (see dt_csv_record) since the data moves.
+// returns DT_FAILURE on a read error (or corrupt compressed data).
+// returns DT_ALLOC_ERROR if couldn't grow the window.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_csv_stream_read(
+	struct dt_csv_stream* const stream,
+	const size_t consumed);
+
+// release the window of [stream] and close its file
+void
+dt_csv_stream_close(
+	struct dt_csv_stream* const stream);
+
+// prepare an empty [record] whose spans are allocated with [allocator]
+void
+dt_csv_record_init(
+	struct dt_csv_record* const record,
+	const struct dt_allocator* const allocator);
+
+// release the spans of [record]
+void
+dt_csv_record_free(
+	struct dt_csv_record* const record);
+
+// the best instruction set supported by this CPU (checked at run time).
+// DT_CSV_SIMD_NONE on other architectures and compilers.
+enum dt_csv_simd_e
+dt_csv_detect_simd(void);
+
+// split the record starting at [*position] of [data] (of [size] bytes) into [record]
+// and move [*position] past its line ending (\n, \r\n or \r).
+// a blank line gives a record with zero spans.
+// an unterminated quoted field runs to the end of [data].
+// returns DT_ALLOC_ERROR if couldn't grow the span array, DT_SUCCESS otherwise.
+enum status_code_e
+dt_csv_tokenize_record(
+	const char* const data,
+	const size_t size,
+	const char delim,
+	size_t* const position,
+	struct dt_csv_record* const record);
+
+// guess where the first record after [offset] starts by scanning a window of [data] ahead of it
+// instead of tokenizing everything before it (used to split the input between threads).
+// the first (not doubled) double quote that can only open a quoted field (after a delimiter or
+// line break) or only close one (before a delimiter or line break) tells whether [offset] is
+// inside quotes; without one, [offset] is assumed to be outside quotes.
+// the guess can be wrong for unusual quoting, so callers must check it (e.g. that tokenizing
+// the preceding range ended exactly there). returns [size] if no line break is found.
+size_t
+dt_csv_speculate_record_start(
+	const char* const data,
+	const size_t size,
+	const char delim,
+	const size_t offset);
+
+// write the value of [span] into [dest] (at least span->length + 1 bytes) with the
+// enclosing quotes removed and doubled quotes unescaped, followed by a null terminator.
+// returns the length of the value.
+size_t
+dt_csv_span_copy(
+	const char* const data,
+	const struct dt_csv_span* const span,
+	char* const dest);
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef CSV_WRITER_H
+#define CSV_WRITER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "Allocator.h"
+#include "CsvReader.h"
+#include "StatusCodes.h"
+
+/*
+ * low-level CSV output used by dt_table_to_csv.
+ *
+ * files whose name ends with .gz or .zst (see dt_csv_compression_from_path) are
+ * compressed block by block with zlib or libzstd as they are written, when the library
+ * was built with them (see dt_csv_compression_supported).
+ */
+
+// compresses a dt_csv_output (see CsvWriter.c)
+struct dt_csv_encoder;
+
+// a file written front to back
+struct dt_csv_output
+{
+	FILE* file;
+
+	// stdout is left open by dt_csv_output_close
+	bool owns_file;
+
+	// the file had no data when opened (it was created, truncated or empty)
+	bool is_empty;
+
+	// set for compressed outputs, which are written through the encoder
+	enum dt_csv_compression_e compression;
+	struct dt_csv_encoder* encoder;
+};
+
+// create (or truncate, or append to if [append]) the file at [filepath], or stdout if
+// [filepath] is NULL or "-", to be written with dt_csv_output_write. appending to a compressed
+// file starts a new gzip member or zstd frame, which readers decompress as a continuation.
+// returns DT_FAILURE if the file can't be opened or its compression isn't supported.
+// returns DT_ALLOC_ERROR if couldn't allocate memory.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_csv_output_open(
+	const char* const filepath,
+	const bool append,
+	struct dt_csv_output* const output);
+
+// append the [size] bytes at [data] to [output] (compressed if needed)
+// returns DT_FAILURE on a write (or compression) error.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_csv_output_write(
+	struct dt_csv_output* const output,
+	const void* const data,
+	const size_t size);
+
+// write everything given to dt_csv_output_write so far (flushing the compressor so that it
+// can be decompressed) to the file and wait until it's stored on the device (fsync).
+// returns DT_FAILURE if the data couldn't be written or stored.
+// returns DT_SUCCESS otherwise (also for pipes and terminals, which can't be synced).
+enum status_code_e
+dt_csv_output_sync(
+	struct dt_csv_output* const output);
+
+// finish the compressed data of [output] and close its file
+// returns DT_FAILURE if the end of the output couldn't be written.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_csv_output_close(
+	struct dt_csv_output* const output);
+
+#endif
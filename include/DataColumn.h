@@ -9,6 +9,9 @@
 #include <stdarg.h>
 
 #include "StatusCodes.h"
+#include "Allocator.h"
+#include "DateTime.h"
+#include "NumberParsing.h"
 
 enum data_type_e
 {
@@ -22,7 +25,13 @@ enum data_type_e
 	UINT16,
 	UINT32,
 	UINT64,
-	STRING
+	STRING,
+	// stored as packed bits (see struct DataColumn); values are passed as bool
+	BOOL,
+	// days since 1970-01-01 (int32_t)
+	DATE,
+	// [time_unit]s since 1970-01-01T00:00:00 UTC (int64_t), see DateTime.h
+	TIMESTAMP
 };
 
 // convert data type enum to string representation.
@@ -38,6 +47,35 @@ void
 dt_string_dealloc(
 	void* item);
 
+// parse "true"/"false"/"1"/"0" (case-insensitive) into [value].
+// returns false (and leaves [value] untouched) if [str] isn't a boolean.
+bool
+dt_parse_bool(
+	const char* const str,
+	bool* const value);
+
+/*
+ * buffer guarantee: [value] (for columns that are not views), [null_value_indices] and
+ * the selection arrays returned by dt_column_filter all start on a DT_BUFFER_ALIGNMENT
+ * (64-byte) boundary and their allocation is padded to a multiple of DT_BUFFER_ALIGNMENT
+ * bytes with the padding zeroed. vector code may therefore use aligned loads and read
+ * a full vector past the last element (up to the padded end) without a scalar tail loop.
+ *
+ * a view's [value] starts at its parent's buffer + offset * type_size, so it is only
+ * aligned when that offset is a multiple of DT_BUFFER_ALIGNMENT.
+ * for chunked columns the same guarantee applies to every chunk.
+ *
+ * the cost of the guarantee: realloc() doesn't preserve the alignment, so growing a
+ * contiguous column always moves its values into a new buffer (a full copy) instead of
+ * possibly growing in place. appends grow the capacity geometrically to keep this amortized
+ * O(1); reserve the final size up front (dt_column_reserve, dt_table_reserve) or make the
+ * column chunked (chunks are never moved) to avoid the copies altogether.
+ *
+ * BOOL columns store one bit per value in 64-bit words ([value] is a uint64_t array,
+ * value i is bit (i + bit_offset) % 64 of word (i + bit_offset) / 64). values are
+ * passed in and out as bool; pointers returned by dt_column_get_value_ptr (and
+ * handed to filter callbacks) point to a shared, read-only true/false value.
+ */
 struct DataColumn
 {
 	enum data_type_e type;
@@ -53,6 +91,31 @@ struct DataColumn
 	size_t* null_value_indices;
 	size_t n_null_values;
 	size_t null_value_capacity;
+
+	// true if [value] points into the buffer of another column (see dt_column_view).
+	// views do NOT own their values and never free them.
+	bool is_view;
+
+	// every allocation made by (or on behalf of) this column goes through this allocator
+	const struct dt_allocator* allocator;
+
+	// chunked layout (see dt_column_make_chunked). if chunk_size > 0, [value] is NULL and
+	// the values live in [n_chunks] separately allocated chunks of chunk_size values each
+	// (chunk_size is a power of two, 1 << chunk_shift). growing the column only adds
+	// chunks, so existing values are never moved or copied.
+	// chunk_offset is the position of the first value (non-zero for views).
+	void** chunks;
+	size_t n_chunks;
+	size_t chunk_capacity;
+	size_t chunk_size;
+	size_t chunk_shift;
+	size_t chunk_offset;
+
+	// BOOL columns only: position of the first bit within [value] (non-zero for views)
+	size_t bit_offset;
+
+	// TIMESTAMP columns only: unit of the stored values (DT_DEFAULT_TIME_UNIT unless changed)
+	enum dt_time_unit_e time_unit;
 };
 
 // pass a NULL-initialized DataTable to allocate [capacity] number of items.
@@ -65,6 +128,16 @@ dt_column_create(
 	const size_t capacity,
 	const enum data_type_e type);
 
+// same as dt_column_create but every allocation of the column goes through [allocator]
+// (see Allocator.h). the allocator must outlive the column.
+// returns DT_ALLOC_ERROR if couldn't properly allocate memory, DT_SUCCESS otherwise.
+enum status_code_e
+dt_column_create_with_allocator(
+	struct DataColumn** column,
+	const size_t capacity,
+	const enum data_type_e type,
+	const struct dt_allocator* const allocator);
+
 // copy the address of a value into a specified position.
 // if value is NULL, 0 will be written instead.
 // returns DT_INDEX_ERROR if index is out of bounds, DT_SUCCESS otherwise.
@@ -82,6 +155,25 @@ dt_column_append_value(
 	struct DataColumn* const column,
 	const void * const value);
 
+// append [n_values] values from one contiguous buffer of the column's type with a
+// single copy (for STRING, [values] is an array of const char* and each string is copied).
+// [validity] is optional: if non-NULL, values where validity[i] is false are stored as null.
+// returns DT_ALLOC_ERROR if there was a problem resizing, DT_SUCCESS otherwise.
+enum status_code_e
+dt_column_append_values(
+	struct DataColumn* const column,
+	const void* const values,
+	const size_t n_values,
+	const bool* const validity);
+
+// make sure [capacity] values fit in the column without reallocating.
+// the number of values is NOT changed.
+// returns DT_ALLOC_ERROR if there was a problem resizing, DT_SUCCESS otherwise.
+enum status_code_e
+dt_column_reserve(
+	struct DataColumn* const column,
+	const size_t capacity);
+
 // append two columns together (dest is modified in place)
 // returns DT_ALLOC_ERR if there was a problem reallocating memory
 // returns DT_TYPE_MISMATCH if column types are not the same
@@ -91,6 +183,17 @@ dt_column_append(
 	struct DataColumn* const dest,
 	const struct DataColumn* const src);
 
+// move every value of [src] (null values included) to the end of [dest] and leave [src] empty.
+// STRING values are handed over instead of copied, so nothing is allocated per value.
+// returns DT_TYPE_MISMATCH if column types are not the same
+// returns DT_BAD_ARG if [src] is a view (it doesn't own its values)
+// returns DT_ALLOC_ERROR if there was a problem reallocating memory
+// returns DT_SUCCESS otherwise
+enum status_code_e
+dt_column_append_move(
+	struct DataColumn* const dest,
+	struct DataColumn* const src);
+
 // fetch the item at specified position and copy its contents into value pointer.
 // returns DT_INDEX_ERROR if index is out of bounds, DT_SUCCESS otherwise.
 enum status_code_e
@@ -139,6 +242,7 @@ dt_column_copy(
 	const struct DataColumn* const column);
 
 // iterate each row of column and apply a user callback (with optional user data) and return an array of 0/1s indicating if the row should be kept or not. The size of the returned array is the same as column->n_values. 
+// the array is allocated with the column's allocator; release it with dt_aligned_free(column->allocator, array).
 // if an allocation error occurrs, NULL is returned 
 size_t*
 dt_column_filter(
@@ -157,6 +261,23 @@ dt_column_subset_by_boolean(
 	const size_t* const boolean_idx);
 
 
+// same as dt_column_filter but returns a BOOL column (one bit per row) marking the rows
+// to keep, which is 64x smaller than the size_t array and can be combined with
+// dt_column_and/dt_column_or/dt_column_not.
+// returns NULL on failure (e.g., allocation issue).
+struct DataColumn*
+dt_column_filter_to_mask(
+	const struct DataColumn* const column,
+	bool (*filter_callback)(void* item, void* user_data),
+	void* user_data);
+
+// same as dt_column_subset_by_boolean but takes a BOOL column (of the same size) as the mask.
+// returns NULL on failure (e.g., allocation issue, mask isn't a BOOL column or has a different size).
+struct DataColumn*
+dt_column_subset_by_mask(
+	const struct DataColumn* const column,
+	const struct DataColumn* const mask);
+
 // subset a column by specific indices which returns a newly-allocated column or returns NULL on failure (e.g., if one of the indices is out of bounds).
 struct DataColumn*
 dt_column_subset_by_index(
@@ -173,6 +294,60 @@ dt_column_drop_by_index(
 	const size_t* const sorted_indices_ascending,
 	const size_t n_indices);
 
+// create a lightweight view over [length] rows of [column] starting at [offset].
+// the view references the parent's value buffer (NOT a copy), so the parent must
+// outlive the view and must not be resized or freed while the view is in use.
+// any mutation of the view (set, append, cast, etc.) first copies the referenced
+// values into a buffer owned by the view (copy-on-write), leaving the parent untouched.
+// returns NULL on failure (e.g., offset/length out of bounds or allocation issue).
+struct DataColumn*
+dt_column_view(
+	const struct DataColumn* const column,
+	const size_t offset,
+	const size_t length);
+
+// create a view (see dt_column_view) over [n_values] values of [type] stored in a buffer that
+// isn't owned by a column, e.g. a memory-mapped file: [values] holds the values as they're stored
+// in a column (char* for STRING, one bit per value in 64-bit words for BOOL) and [validity] is
+// optional, a bitmap with bit i (bit i % 8 of byte i / 8) cleared if value i is null.
+// both start at value [offset]. the buffers must outlive the column, which never writes to
+// or frees them (the values are copied first if the column is modified).
+// returns NULL on failure (e.g. allocation issue).
+struct DataColumn*
+dt_column_wrap(
+	const enum data_type_e type,
+	const void* const values,
+	const uint8_t* const validity,
+	const size_t offset,
+	const size_t n_values,
+	const struct dt_allocator* const allocator);
+
+// if [column] is a view, copy the referenced values into a buffer owned by the
+// column so it can be safely modified. no-op if the column already owns its values.
+// returns DT_ALLOC_ERROR if couldn't allocate memory, DT_SUCCESS otherwise.
+enum status_code_e
+dt_column_materialize(
+	struct DataColumn* const column);
+
+// switch the column to the chunked layout: values are stored in chunks of [chunk_size]
+// values (rounded up to a power of two) and appending never moves existing values,
+// which avoids the copy (and 2x memory spike) of reallocating one huge buffer.
+// every operation works on chunked columns; columns derived from them (copies,
+// filters, etc.) use the regular contiguous layout.
+// returns DT_BAD_ARG if chunk_size is 0.
+// returns DT_TYPE_MISMATCH for BOOL columns (their bits are always contiguous).
+// returns DT_ALLOC_ERROR if couldn't allocate memory, DT_SUCCESS otherwise.
+enum status_code_e
+dt_column_make_chunked(
+	struct DataColumn* const column,
+	const size_t chunk_size);
+
+// switch a chunked column back to a single contiguous buffer (no-op if already contiguous).
+// returns DT_ALLOC_ERROR if couldn't allocate memory, DT_SUCCESS otherwise.
+enum status_code_e
+dt_column_make_contiguous(
+	struct DataColumn* const column);
+
 // resize a column to new size with n_values.
 // returns DT_ALLOC_ERROR if reallocation fails, DT_SUCCESS otherwise.
 // if new size is bigger, values are defaulted to 0.
@@ -239,6 +414,7 @@ dt_column_union_multiple(
 
 // sum all the values in a column and store result into [result].
 // the type is determined by column->type.
+// for BOOL columns the number of true values is added to a size_t [result].
 void
 dt_column_sum(
 	const struct DataColumn* const column,
@@ -305,10 +481,63 @@ dt_column_divide(
 	struct DataColumn* const dest,
 	const struct DataColumn* src);
 
-// cast a column data type to another type
+// for each row in [dest], combine the value with the corresponding row from [src].
+// dest &= src, dest |= src, dest ^= src (for each row).
+// both columns must be BOOL; bits are combined 64 at a time.
+// returns DT_SIZE_MISMATCH if columns are different sizes.
+// returns DT_TYPE_MISMATCH if either column isn't BOOL.
+// returns DT_ALLOC_ERROR if [dest] is a view and couldn't be materialized.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_column_and(
+	struct DataColumn* const dest,
+	const struct DataColumn* const src);
+
+enum status_code_e
+dt_column_or(
+	struct DataColumn* const dest,
+	const struct DataColumn* const src);
+
+enum status_code_e
+dt_column_xor(
+	struct DataColumn* const dest,
+	const struct DataColumn* const src);
+
+// negate every value of a BOOL column in place.
+// returns DT_TYPE_MISMATCH if the column isn't BOOL.
+// returns DT_ALLOC_ERROR if [column] is a view and couldn't be materialized.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_column_not(
+	struct DataColumn* const column);
+
+// cast a column data type to another type.
+// BOOL casts to 1/0 (numeric) or "true"/"false" (STRING); numeric values cast to
+// BOOL are true when non-zero and strings are parsed with dt_parse_bool.
 void
 dt_column_cast(
 	struct DataColumn* const column,
 	const enum data_type_e new_type);
 
+// change the unit of a TIMESTAMP column and rescale every value to it.
+// converting to a coarser unit rounds down (towards the earlier time).
+// returns DT_TYPE_MISMATCH if the column isn't TIMESTAMP.
+// returns DT_ALLOC_ERROR if [column] is a view and couldn't be materialized.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_column_set_time_unit(
+	struct DataColumn* const column,
+	const enum dt_time_unit_e unit);
+
+// narrow an integer or DOUBLE column to the smallest type that holds every value exactly,
+// based on the observed minimum/maximum (e.g., UINT64 values within 0 - 255 become UINT8).
+// signedness is kept and DOUBLE becomes FLOAT only if every value round-trips.
+// the values are converted in place and the buffer shrinks to the new size.
+// other types are left untouched.
+// returns DT_ALLOC_ERROR if [column] is a view or chunked and couldn't be rearranged.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_column_shrink(
+	struct DataColumn* const column);
+
 #endif
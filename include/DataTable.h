@@ -10,6 +10,7 @@
 
 #include "DataColumn.h"
 #include "StatusCodes.h"
+#include "Allocator.h"
 
 #define DT_MAX_COL_LEN 101
 
@@ -25,6 +26,21 @@ struct DataTable
 	size_t n_columns;
 	size_t column_capacity;
 	size_t n_rows;
+
+	// used for the table, its columns and any intermediate memory (hash bins,
+	// filter arrays, etc.). tables derived from this table (filters, joins, copies,
+	// etc.) use the same allocator.
+	const struct dt_allocator* allocator;
+
+	// columns still to be parsed for tables read with dt_csv_options.lazy (NULL otherwise)
+	struct dt_lazy_csv* lazy;
+
+	// file whose buffers the columns use in place for tables read with dt_table_load (NULL otherwise)
+	struct dt_mapped_table* mapped;
+
+	// Arrow array whose buffers the columns use in place for tables created with
+	// dt_table_import_arrow (NULL otherwise), released with the table
+	struct ArrowArray* arrow;
 };
 
 // create a new empty table with n_columns by passing and array of
@@ -36,6 +52,19 @@ dt_table_create(
 	const char (*column_names)[DT_MAX_COL_LEN],
 	const enum data_type_e* const data_types);
 
+// same as dt_table_create but every allocation of the table (and any table derived
+// from it) goes through [allocator] (see Allocator.h).
+// e.g., pass dt_arena_allocator(arena) for short-lived tables that are released all at
+// once with dt_arena_reset().
+// the allocator must outlive the table.
+// returns NULL on failure (e.g., couldn't allocate enough memory)
+struct DataTable*
+dt_table_create_with_allocator(
+	const size_t n_columns,
+	const char (*column_names)[DT_MAX_COL_LEN],
+	const enum data_type_e* const data_types,
+	const struct dt_allocator* const allocator);
+
 // free memory allocated by table (also frees the underlying columns)
 void
 dt_table_free(
@@ -66,6 +95,44 @@ enum status_code_e
 dt_table_insert_empty_row(
 	struct DataTable* const table);
 
+// make sure [n_rows] rows fit in every column without reallocating
+// (the number of rows is NOT changed).
+// returns DT_ALLOC_ERROR if there was a problem resizing.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_table_reserve(
+	struct DataTable* const table,
+	const size_t n_rows);
+
+// store every column in chunks of [chunk_size] rows (see dt_column_make_chunked)
+// so growing the table never moves or copies existing rows.
+// useful for long-lived tables that keep growing.
+// BOOL columns are left contiguous.
+// returns DT_BAD_ARG if chunk_size is 0.
+// returns DT_ALLOC_ERROR if there was a problem allocating memory.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_table_make_chunked(
+	struct DataTable* const table,
+	const size_t chunk_size);
+
+// append [n_rows] rows at once from one contiguous buffer per column
+// (e.g., column_buffers[0] is an int32_t[n_rows] if the first column is INT32;
+// for STRING columns the buffer is an array of const char* and each string is copied).
+// [validity] is optional and so is each of its entries: validity[c][r] == false marks
+// row r of column c as null.
+// every column is appended with a single copy (see dt_column_append_values).
+// returns DT_BAD_ARG if [column_buffers] or any of its entries is NULL.
+// returns DT_ALLOC_ERROR if there was a problem resizing or copying a string (the table is
+// left unchanged).
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_table_append_rows(
+	struct DataTable* const table,
+	const size_t n_rows,
+	const void* const* const column_buffers,
+	const bool* const* const validity);
+
 // set value at specified row/column index.
 void
 dt_table_set_value(
@@ -81,9 +148,13 @@ dt_table_get_value(
 	const size_t row,
 	const size_t column);
 
-// select a subset of columns and return a COPY of the table.
+// select a subset of columns and return a lightweight table referencing them.
 // pass the # of columns to select followed by the array of column names.
 // every column MUST be present in original table or NULL will be returned.
+// NO data is copied; each column is a view into the original column (see dt_column_view),
+// so the original table must outlive the subset. modifying the subset copies the
+// affected column first and never changes the original table.
+// use dt_table_copy() on the result if an independent copy is needed.
 // WARNING: do not directly reassign as you will lose the original pointer and cause a memory leak.
 // returns NULL on failure (e.g., out of memory)
 struct DataTable*
@@ -92,6 +163,33 @@ dt_table_select(
 	const size_t n_columns,
 	const char (*columns)[DT_MAX_COL_LEN]);
 
+// return a lightweight table referencing [length] rows of [table] starting at [offset].
+// if offset + length runs past the end of the table, the slice is truncated.
+// NO data is copied; each column is a view into the original column (see dt_column_view),
+// so the original table must outlive the slice. the slice can be used with every read-only
+// function (aggregates, filters, joins, dt_table_to_csv, etc.) and modifying it copies
+// the affected column first without changing the original table.
+// returns NULL on failure (e.g., offset > n_rows or out of memory)
+struct DataTable*
+dt_table_slice(
+	const struct DataTable* const table,
+	const size_t offset,
+	const size_t length);
+
+// return a slice (see dt_table_slice) of the first [n_rows] rows of [table].
+// returns NULL on failure.
+struct DataTable*
+dt_table_head(
+	const struct DataTable* const table,
+	const size_t n_rows);
+
+// return a slice (see dt_table_slice) of the last [n_rows] rows of [table].
+// returns NULL on failure.
+struct DataTable*
+dt_table_tail(
+	const struct DataTable* const table,
+	const size_t n_rows);
+
 // copy the "skeleton" of a table (column names and types but NOT the data).
 // this is mainly used internally but could be used for very specific use cases.
 // returns NULL on failure.
@@ -168,6 +266,15 @@ dt_table_filter_AND_by_index(
 	bool (**filter_callback)(void* item, void* user_data),
   void* user_data);
 
+// return a (newly-allocated) table containing the rows where [mask] is true.
+// [mask] is a BOOL column with one value per row, e.g. built with
+// dt_column_filter_to_mask and combined with dt_column_and/dt_column_or/dt_column_not.
+// returns NULL on failure (e.g., out of memory, mask isn't BOOL or has a different size)
+struct DataTable*
+dt_table_filter_by_mask(
+	const struct DataTable* const table,
+	const struct DataColumn* const mask);
+
 // return a pointer to a column (NOT a copy).
 // returns NULL if column is not found.
 struct DataColumn*
@@ -372,8 +479,11 @@ dt_table_split(
 
 // read and construct a data table from a CSV file.
 // NOTE: assumes first row is a header row to determine column names
-// NOTE: handles a maximum of 4095 characters per line (will be truncated)
-// NOTE: will ignore delimiters inside single (') or double (") quotes.
+// NOTE: fields follow RFC-4180: a field starting with a double quote can contain delimiters,
+//       newlines and doubled quotes ("" for "); lines and column counts aren't limited.
+// NOTE: delimiters after a single (') or double (") quote in the middle of a field
+//       are ignored up to the matching quote (the quotes are kept in the value).
+// NOTE: empty fields are null values and blank lines are skipped.
 //
 // user can optionally pass the column types (if so, need to provide n_columns)
 // to set the appropriate data types for each column.
@@ -388,6 +498,121 @@ dt_table_read_csv(
 	const char delim,
 	const enum data_type_e* const column_types);
 
+// records sampled to infer column types unless dt_csv_options says otherwise
+#define DT_CSV_DEFAULT_INFERENCE_ROWS 10000
+
+// options for dt_table_read_csv_with_options.
+// always start from dt_csv_options_init so options added later keep their defaults.
+struct dt_csv_options
+{
+	// field delimiter (default ',')
+	char delim;
+
+	// optional type of each column; NULL to infer them (default NULL)
+	const enum data_type_e* column_types;
+
+	// narrow inferred numeric columns to the smallest exact type (see dt_table_shrink).
+	// explicitly given column types are kept as is (default false)
+	bool shrink;
+
+	// number of threads parsing the file; 0 for one per CPU core (default 0).
+	// small files (about 1MB per thread) use fewer threads and the result is
+	// always the same as reading with a single thread.
+	// NOTE: with more than one thread, the allocator must be thread-safe
+	size_t n_threads;
+
+	// number of records sampled to infer column types, or 0 to look at every record
+	// before parsing (default DT_CSV_DEFAULT_INFERENCE_ROWS).
+	// the rest is parsed in one pass and a column is promoted in place when a later
+	// value doesn't fit (UINT64 -> INT64 -> DOUBLE, DATE -> TIMESTAMP, otherwise STRING)
+	size_t n_inference_rows;
+
+	// names of the [n_columns] columns to read, in this order; NULL to read every column
+	// (default NULL). fields of other columns are skipped without being parsed or copied.
+	// [column_types] still gives the type of every column of the file
+	const char (*columns)[DT_MAX_COL_LEN];
+	size_t n_columns;
+
+	// only records where ALL [n_filters] filters return true are read (default 0 filters).
+	// [filter_callbacks][i] gets a pointer to the value of column [filter_columns][i] parsed as
+	// that column's type (NULL for null values) and [filter_user_data]; filtered columns don't
+	// have to be read. other fields of records that don't pass are never parsed.
+	// filters need the types up front, so without [column_types] every record is looked at
+	// first (as with n_inference_rows = 0)
+	size_t n_filters;
+	const char (*filter_columns)[DT_MAX_COL_LEN];
+	bool (**filter_callbacks)(void* item, void* user_data);
+	void* filter_user_data;
+
+	// only index where every record starts and keep the file open; each column is parsed the
+	// first time it's used by a dt_table_* function (default false), so columns that are never
+	// used cost nothing. columns must NOT be accessed directly (table->columns[i].column) until
+	// then (or until dt_table_load_columns is called). in the meantime their type is the one
+	// given or sampled from the first n_inference_rows records (DT_CSV_DEFAULT_INFERENCE_ROWS if
+	// 0, filters included) and may still be promoted. loading isn't thread-safe, even through a
+	// const table
+	bool lazy;
+};
+
+// fill [options] with the defaults
+void
+dt_csv_options_init(
+	struct dt_csv_options* const options);
+
+// same as dt_table_read_csv but configured with [options]
+// returns NULL on failure
+struct DataTable*
+dt_table_read_csv_with_options(
+	const char* const filepath,
+	const struct dt_csv_options* const options);
+
+// parse every column of a table read with dt_csv_options.lazy that hasn't been used yet
+// (a no-op for other tables).
+// returns DT_ALLOC_ERROR if couldn't allocate memory.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_table_load_columns(
+	struct DataTable* const table);
+
+// reads a CSV input in batches of rows instead of loading it whole (see dt_csv_reader_next)
+struct dt_csv_reader;
+
+// open [filepath], or stdin if NULL or "-" (e.g. a pipe), to be read in batches.
+// the header and the first options->n_inference_rows records (DT_CSV_DEFAULT_INFERENCE_ROWS if 0)
+// are read to name the columns and infer their types, which stay the same for every batch:
+// later values that don't fit are read as if the types had been given in options->column_types.
+// only a window of the input is kept in memory (about 1MB, more if a record or the inference
+// sample doesn't fit). options->columns and the filters apply to every batch (filters are
+// parsed with the sampled types too). options->shrink and options->n_threads are ignored.
+// returns NULL on failure
+struct dt_csv_reader*
+dt_csv_reader_open(
+	const char* const filepath,
+	const struct dt_csv_options* const options);
+
+// read the next (up to) [max_rows] records into a new table that the caller frees.
+// returns NULL at the end of the input or on failure (see dt_csv_reader_status)
+struct DataTable*
+dt_csv_reader_next(
+	struct dt_csv_reader* const reader,
+	const size_t max_rows);
+
+// returns DT_SUCCESS unless reading failed (e.g. DT_FAILURE for a read error
+// or DT_ALLOC_ERROR if couldn't allocate memory)
+enum status_code_e
+dt_csv_reader_status(
+	const struct dt_csv_reader* const reader);
+
+// empty table with the column names and types of every batch
+const struct DataTable*
+dt_csv_reader_schema(
+	const struct dt_csv_reader* const reader);
+
+// close the input (unless it's stdin) and free [reader]
+void
+dt_csv_reader_close(
+	struct dt_csv_reader** reader);
+
 // append two tables by columns (horizontally).
 // tables MUST have same number of rows.
 // [dest] table is modified inplace with the new columns appended
@@ -428,6 +653,12 @@ dt_table_cast_columns(
 	const char (*column_names)[DT_MAX_COL_LEN],
 	const enum data_type_e* new_column_types);
 
+// narrow every integer and DOUBLE column to the smallest exact type (see dt_column_shrink).
+// returns DT_ALLOC_ERROR if a column couldn't be rearranged, DT_SUCCESS otherwise.
+enum status_code_e
+dt_table_shrink(
+	struct DataTable* const table);
+
 struct DataTable*
 dt_table_join_inner(
   const struct DataTable* const left_table,
@@ -472,10 +703,111 @@ dt_table_column_contains_null(
   const struct DataTable* const table,
   const size_t col_idx);
 
+// write [table] to the file at [filepath], compressed with gzip or zstd when its name
+// ends with .gz or .zst (see dt_csv_compression_supported).
+// large tables are formatted with one thread per CPU core (see dt_csv_write_options).
+// returns false if the file couldn't be written.
 bool
 dt_table_to_csv(
   const struct DataTable* const table,
   const char* const filepath,
   const char delim);
 
+// options for dt_table_to_csv_with_options.
+// always start from dt_csv_write_options_init so options added later keep their defaults.
+struct dt_csv_write_options
+{
+	// field delimiter (default ',')
+	char delim;
+
+	// number of threads formatting rows; 0 for one per CPU core (default 0).
+	// the table is split into blocks of rows formatted in parallel and written in order,
+	// so the file is always the same as with a single thread. small tables (less than
+	// DT_CSV_MIN_EXPORT_ROWS rows per thread) use fewer threads.
+	// NOTE: with more than one thread, the allocator must be thread-safe
+	size_t n_threads;
+
+	// add the rows to the end of the file instead of replacing it (default false).
+	// the header is only written if the file is new or empty. appending to a .gz or .zst
+	// file adds a gzip member or zstd frame, which readers decompress as a continuation
+	bool append;
+
+	// wait until the data is stored on the device (fsync) before returning, or after every
+	// batch of a dt_csv_writer (default false)
+	bool sync;
+};
+
+// rows a table needs per thread to be written with more than one (see dt_csv_write_options)
+#define DT_CSV_MIN_EXPORT_ROWS 10000
+
+// fill [options] with the defaults
+void
+dt_csv_write_options_init(
+	struct dt_csv_write_options* const options);
+
+// same as dt_table_to_csv but configured with [options]
+bool
+dt_table_to_csv_with_options(
+	const struct DataTable* const table,
+	const char* const filepath,
+	const struct dt_csv_write_options* const options);
+
+// writes a CSV output in batches of rows (see dt_csv_writer_write_batch)
+struct dt_csv_writer;
+
+// create (or append to, see dt_csv_write_options.append) [filepath], or write to stdout if
+// NULL or "-", to write tables with the column names and types of [schema] (whose rows aren't
+// written) in batches. the header is written once, here. the file stays open and formatted rows
+// are kept in a buffer of about 1MB between batches, so small batches are written in large
+// blocks. options->n_threads applies to each batch.
+// returns NULL on failure
+struct dt_csv_writer*
+dt_csv_writer_open(
+	const char* const filepath,
+	const struct DataTable* const schema,
+	const struct dt_csv_write_options* const options);
+
+// format the rows of [batch] and add them to the output (flushed and synced first
+// if options->sync was set).
+// returns DT_SIZE_MISMATCH if [batch] doesn't have as many columns as the schema.
+// returns DT_TYPE_MISMATCH if a column of [batch] doesn't have the type of the schema's.
+// returns DT_FAILURE on a write error and DT_ALLOC_ERROR if couldn't allocate memory;
+// the writer then can't be used anymore and returns the same error for every later batch.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_csv_writer_write_batch(
+	struct dt_csv_writer* const writer,
+	const struct DataTable* const batch);
+
+// write the buffered rows, finish the output (synced if options->sync was set), close it
+// (unless it's stdout) and free [writer].
+// returns the first error of a batch or DT_FAILURE if the output couldn't be finished.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_csv_writer_close(
+	struct dt_csv_writer** writer);
+
+// write [table] to [filepath] in the library's binary columnar format, which dt_table_load reads
+// back exactly (types, null values and every bit of floating-point values) without parsing
+// anything: each column is stored as it is in memory, on DT_BUFFER_ALIGNMENT-byte boundaries,
+// with a validity bitmap if it has null values (see DataTable_Internal.c for the layout).
+// NOTE: files can only be loaded on machines with the same byte order.
+// returns DT_FAILURE if the file couldn't be written.
+// returns DT_ALLOC_ERROR if couldn't allocate memory.
+// returns DT_SUCCESS otherwise.
+enum status_code_e
+dt_table_save(
+	const struct DataTable* const table,
+	const char* const filepath);
+
+// read a table written by dt_table_save. the file is memory-mapped (read-only) and the columns
+// are views over it (see dt_column_wrap), so no values are copied: only the null value indices
+// and, for STRING columns, an array of pointers to the values in the file are built. the file
+// stays mapped until the table is freed and a column is copied the first time it's modified.
+// NOTE: the file must not be modified while the table is in use.
+// returns NULL on failure (e.g. the file is missing, truncated or in another format)
+struct DataTable*
+dt_table_load(
+	const char* const filepath);
+
 #endif
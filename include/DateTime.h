@@ -0,0 +1,78 @@
+#ifndef DATETIME_H
+#define DATETIME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * fixed-format ISO-8601 parsing and formatting for DATE and TIMESTAMP columns.
+ *
+ * DATE values are the number of days since 1970-01-01 (int32_t).
+ * TIMESTAMP values are the number of [unit]s since 1970-01-01T00:00:00 UTC (int64_t),
+ * so comparing, hashing and aggregating them is plain integer arithmetic.
+ *
+ * supported formats (4-digit years only):
+ *   YYYY-MM-DD
+ *   YYYY-MM-DD[T or space]HH:MM[:SS[.fraction]][Z or +HH:MM, -HH:MM, +HHMM, +HH]
+ * timestamps with an offset are converted to UTC; fractions beyond the unit's
+ * precision are truncated.
+ */
+
+enum dt_time_unit_e
+{
+	DT_TIME_UNIT_SECONDS,
+	DT_TIME_UNIT_MILLISECONDS,
+	DT_TIME_UNIT_MICROSECONDS,
+	DT_TIME_UNIT_NANOSECONDS
+};
+
+// unit used by TIMESTAMP columns unless changed with dt_column_set_time_unit
+#define DT_DEFAULT_TIME_UNIT DT_TIME_UNIT_MICROSECONDS
+
+// length of "YYYY-MM-DD"
+#define DT_DATE_STRING_LEN 10
+
+// buffer sizes (including the null terminator) needed by the format functions
+#define DT_DATE_BUFFER_SIZE 16
+#define DT_TIMESTAMP_BUFFER_SIZE 48
+
+// number of [unit]s in one second (1, 1000, 1000000 or 1000000000)
+int64_t
+dt_time_unit_per_second(
+	const enum dt_time_unit_e unit);
+
+// parse "YYYY-MM-DD" into days since 1970-01-01.
+// returns false (and leaves [days] untouched) if [str] isn't a valid date.
+bool
+dt_parse_date(
+	const char* const str,
+	int32_t* const days);
+
+// parse a date or date-time (see above) into [unit]s since the epoch.
+// a date without a time is midnight UTC.
+// returns false (and leaves [value] untouched) if [str] isn't a valid timestamp or is out of
+// the range of [unit]s an int64_t holds (e.g. before 1677 or after 2262 in nanoseconds).
+bool
+dt_parse_timestamp(
+	const char* const str,
+	const enum dt_time_unit_e unit,
+	int64_t* const value);
+
+// write [days] as "YYYY-MM-DD" into [buffer] (at least DT_DATE_BUFFER_SIZE bytes).
+// returns the length of the string.
+size_t
+dt_format_date(
+	const int32_t days,
+	char* const buffer);
+
+// write [value] as "YYYY-MM-DDTHH:MM:SS" followed by as many fractional digits
+// as the unit has (none for seconds) into [buffer] (at least DT_TIMESTAMP_BUFFER_SIZE bytes).
+// returns the length of the string.
+size_t
+dt_format_timestamp(
+	const int64_t value,
+	const enum dt_time_unit_e unit,
+	char* const buffer);
+
+#endif
@@ -33,6 +33,10 @@ struct HashTable
   // the column indices to apply the hash function on for the table
   size_t* column_indices;
   size_t n_column_indices;
+
+	// allocator inherited from the table; kept here since the table
+	// may be free'd before the hash table is
+	const struct dt_allocator* allocator;
 };
 
 // create new statically-sized hash table (does NOT resize).
@@ -43,7 +47,10 @@ struct HashTable
 // [column_indices] is a heap-allocated array of column indices to apply
 // the hash function on. If NULL is provided, it defaults to all columns
 // (and is allocated internally). Note that if you provide the heap-allocated
-// array, the ownership is transferred and you SHOULD NOT free this yourself.
+// array, the ownership is transferred and you SHOULD NOT free this yourself
+// (it must be allocated with the table's allocator, see Allocator.h).
+//
+// the hash table and its bins are allocated with the table's allocator.
 //
 // returns NULL on failure (e.g., couldn't allocate enough memory)
 struct HashTable*
@@ -0,0 +1,94 @@
+#ifndef NUMBER_PARSING_H
+#define NUMBER_PARSING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * decimal number parsing on (pointer, length) spans, used when reading CSV files
+ * and casting STRING columns to numbers.
+ *
+ * the input doesn't need a null terminator and the locale is never looked at ('.' is
+ * always the decimal point). like strtoull/strtoll/strtod, leading whitespace and a
+ * sign are accepted and parsing stops at the first character that can't be part of
+ * the number; the functions return the number of bytes parsed (0 if there's no number).
+ *
+ * integers are parsed 8 digits at a time (SWAR: one 64-bit load and three multiplies
+ * per 8 digits). floating-point values are correctly rounded with the Eisel-Lemire
+ * algorithm (one or two 64x128-bit multiplies against a table of powers of ten) and
+ * the rare inputs it can't decide (e.g. exactly halfway between two values, more than
+ * 19 significant digits, infinities, NaNs and hexadecimal floats) are handed to
+ * strtod/strtof, so the results are always identical to theirs in the C locale.
+ *
+ * numbers are formatted the other way around without snprintf: integers two digits at a
+ * time and floating-point values as the shortest decimal that parses back to the same
+ * value (Schubfach, using the same table of powers of ten), e.g. 0.1 rather than
+ * 0.100000 (%f) or 0.10000000000000001 (%.17g).
+ */
+
+// buffer size (including the null terminator) needed by the format functions
+#define DT_FORMAT_BUFFER_SIZE 32
+
+// parse an unsigned decimal integer at the start of the [length] bytes at [str].
+// returns the number of bytes parsed, or 0 (leaving [value] untouched) if there's no
+// number, it's negative or it's larger than UINT64_MAX.
+size_t
+dt_parse_uint64(
+	const char* const str,
+	const size_t length,
+	uint64_t* const value);
+
+// same as dt_parse_uint64 for a signed integer between INT64_MIN and INT64_MAX
+size_t
+dt_parse_int64(
+	const char* const str,
+	const size_t length,
+	int64_t* const value);
+
+// parse a decimal floating-point value (e.g. 12, -0.5, 1.5e-7, .5, 3.) at the start of the
+// [length] bytes at [str], rounded to the nearest double.
+// returns the number of bytes parsed, or 0 (leaving [value] untouched) if there's no number.
+size_t
+dt_parse_double(
+	const char* const str,
+	const size_t length,
+	double* const value);
+
+// same as dt_parse_double, rounded to the nearest float
+size_t
+dt_parse_float(
+	const char* const str,
+	const size_t length,
+	float* const value);
+
+// write [value] in decimal into [buffer] (at least DT_FORMAT_BUFFER_SIZE bytes).
+// returns the length of the string.
+size_t
+dt_format_uint64(
+	const uint64_t value,
+	char* const buffer);
+
+// same as dt_format_uint64 for a signed integer
+size_t
+dt_format_int64(
+	const int64_t value,
+	char* const buffer);
+
+// write the shortest decimal that dt_parse_double (or strtod) reads back as [value] into
+// [buffer] (at least DT_FORMAT_BUFFER_SIZE bytes), like repr() in Python: plain notation
+// with at least one fractional digit (e.g. 100.0, -0.25) unless the decimal exponent is
+// below -4 or above 15 (e.g. 1e-05, 1.2345e+20). infinities are "inf" and "-inf", NaNs "nan".
+// returns the length of the string.
+size_t
+dt_format_double(
+	const double value,
+	char* const buffer);
+
+// same as dt_format_double for the shortest decimal that dt_parse_float reads back as [value]
+size_t
+dt_format_float(
+	const float value,
+	char* const buffer);
+
+#endif
@@ -0,0 +1,444 @@
+#define _POSIX_C_SOURCE 200112L
+#include "Allocator.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// every arena allocation is aligned to this many bytes
+#define DT_ARENA_ALIGNMENT 16
+
+#define DT_ARENA_DEFAULT_BLOCK_SIZE (1024 * 1024)
+
+static void*
+__malloc_allocate(
+	void* context,
+	size_t size)
+{
+	(void)context;
+	return malloc(size);
+}
+
+static void*
+__malloc_reallocate(
+	void* context,
+	void* ptr,
+	size_t old_size,
+	size_t new_size)
+{
+	(void)context;
+	(void)old_size;
+	return realloc(ptr, new_size);
+}
+
+static void
+__malloc_deallocate(
+	void* context,
+	void* ptr)
+{
+	(void)context;
+	free(ptr);
+}
+
+#ifndef _WIN32
+static void*
+__malloc_allocate_aligned(
+	void* context,
+	size_t alignment,
+	size_t size)
+{
+	(void)context;
+	// posix_memalign'd memory can be released with free()
+	void* ptr = NULL;
+	if (posix_memalign(&ptr, alignment, size) != 0)
+		return NULL;
+
+	return ptr;
+}
+#endif
+
+static const struct dt_allocator malloc_allocator = {
+	.allocate = &__malloc_allocate,
+	.reallocate = &__malloc_reallocate,
+	.deallocate = &__malloc_deallocate,
+	.context = NULL,
+#ifndef _WIN32
+	.allocate_aligned = &__malloc_allocate_aligned
+#else
+	// _aligned_malloc needs _aligned_free, so fall back to over-allocating
+	.allocate_aligned = NULL
+#endif
+};
+
+static const struct dt_allocator* default_allocator = &malloc_allocator;
+
+const struct dt_allocator*
+dt_get_default_allocator(void)
+{
+	return default_allocator;
+}
+
+void
+dt_set_default_allocator(
+	const struct dt_allocator* const allocator)
+{
+	default_allocator = allocator ? allocator : &malloc_allocator;
+}
+
+void*
+dt_alloc(
+	const struct dt_allocator* const allocator,
+	const size_t size)
+{
+	return allocator->allocate(allocator->context, size);
+}
+
+void*
+dt_calloc(
+	const struct dt_allocator* const allocator,
+	const size_t n_items,
+	const size_t item_size)
+{
+	if (item_size > 0 && n_items > SIZE_MAX / item_size)
+		return NULL;
+
+	void* ptr = allocator->allocate(allocator->context, n_items * item_size);
+	if (ptr)
+		memset(ptr, 0, n_items * item_size);
+
+	return ptr;
+}
+
+void*
+dt_realloc(
+	const struct dt_allocator* const allocator,
+	void* ptr,
+	const size_t old_size,
+	const size_t new_size)
+{
+	if (!ptr)
+		return allocator->allocate(allocator->context, new_size);
+
+	return allocator->reallocate(allocator->context, ptr, old_size, new_size);
+}
+
+void
+dt_free(
+	const struct dt_allocator* const allocator,
+	void* ptr)
+{
+	if (ptr)
+		allocator->deallocate(allocator->context, ptr);
+}
+
+char*
+dt_strdup(
+	const struct dt_allocator* const allocator,
+	const char* const str)
+{
+	const size_t len = strlen(str) + 1;
+	char* copy = allocator->allocate(allocator->context, len);
+	if (copy)
+		memcpy(copy, str, len);
+
+	return copy;
+}
+
+size_t
+dt_padded_size(
+	const size_t size)
+{
+	if (size == 0)
+		return DT_BUFFER_ALIGNMENT;
+
+	return (size + DT_BUFFER_ALIGNMENT - 1) & ~((size_t)DT_BUFFER_ALIGNMENT - 1);
+}
+
+static void*
+__aligned_allocate(
+	const struct dt_allocator* const allocator,
+	const size_t size)
+{
+	if (allocator->allocate_aligned)
+		return allocator->allocate_aligned(allocator->context, DT_BUFFER_ALIGNMENT, size);
+
+	// over-allocate and stash the original pointer right before the aligned address
+	unsigned char* raw = allocator->allocate(allocator->context, size + DT_BUFFER_ALIGNMENT + sizeof(void*));
+	if (!raw)
+		return NULL;
+
+	uintptr_t aligned = ((uintptr_t)(raw + sizeof(void*)) + DT_BUFFER_ALIGNMENT - 1)
+		& ~((uintptr_t)DT_BUFFER_ALIGNMENT - 1);
+	((void**)aligned)[-1] = raw;
+
+	return (void*)aligned;
+}
+
+void*
+dt_aligned_calloc(
+	const struct dt_allocator* const allocator,
+	const size_t n_items,
+	const size_t item_size)
+{
+	if (item_size > 0 && n_items > (SIZE_MAX - 2 * DT_BUFFER_ALIGNMENT) / item_size)
+		return NULL;
+
+	const size_t size = dt_padded_size(n_items * item_size);
+	void* ptr = __aligned_allocate(allocator, size);
+	if (ptr)
+		memset(ptr, 0, size);
+
+	return ptr;
+}
+
+void*
+dt_aligned_realloc(
+	const struct dt_allocator* const allocator,
+	void* ptr,
+	const size_t old_size,
+	const size_t new_size)
+{
+	if (new_size > SIZE_MAX - 2 * DT_BUFFER_ALIGNMENT)
+		return NULL;
+
+	// the allocator's reallocate() doesn't preserve alignment, so always move
+	const size_t padded_size = dt_padded_size(new_size);
+	unsigned char* new_ptr = __aligned_allocate(allocator, padded_size);
+	if (!new_ptr)
+		return NULL;
+
+	const size_t n_keep = old_size < new_size ? old_size : new_size;
+	if (ptr)
+		memcpy(new_ptr, ptr, n_keep);
+	memset(new_ptr + n_keep, 0, padded_size - n_keep);
+
+	dt_aligned_free(allocator, ptr);
+
+	return new_ptr;
+}
+
+void
+dt_aligned_free(
+	const struct dt_allocator* const allocator,
+	void* ptr)
+{
+	if (!ptr)
+		return;
+
+	if (allocator->allocate_aligned)
+		allocator->deallocate(allocator->context, ptr);
+	else
+		allocator->deallocate(allocator->context, ((void**)ptr)[-1]);
+}
+
+struct ArenaBlock
+{
+	struct ArenaBlock* next;
+	size_t size;
+	size_t used;
+
+	// start of the usable memory (right after the header, aligned)
+	unsigned char* data;
+};
+
+struct dt_arena
+{
+	// context points back to the arena itself
+	struct dt_allocator allocator;
+
+	// most recent block first; only the head block is bumped
+	struct ArenaBlock* blocks;
+	size_t block_size;
+
+	// start of the most recent allocation (for in-place reallocation)
+	void* last_allocation;
+
+	size_t bytes_used;
+};
+
+static size_t
+__align_up(
+	const size_t size)
+{
+	return (size + DT_ARENA_ALIGNMENT - 1) & ~((size_t)DT_ARENA_ALIGNMENT - 1);
+}
+
+static struct ArenaBlock*
+__arena_new_block(
+	struct dt_arena* const arena,
+	const size_t min_size)
+{
+	size_t size = arena->block_size > min_size ? arena->block_size : min_size;
+	const size_t header_size = __align_up(sizeof(struct ArenaBlock));
+	struct ArenaBlock* block = malloc(header_size + size);
+	if (!block)
+		return NULL;
+
+	block->data = (unsigned char*)block + header_size;
+	block->size = size;
+	block->used = 0;
+	block->next = arena->blocks;
+	arena->blocks = block;
+
+	return block;
+}
+
+static void*
+__arena_allocate_aligned(
+	void* context,
+	size_t alignment,
+	size_t size)
+{
+	struct dt_arena* arena = context;
+	if (alignment < DT_ARENA_ALIGNMENT)
+		alignment = DT_ARENA_ALIGNMENT;
+	const size_t aligned_size = __align_up(size > 0 ? size : 1);
+
+	// number of bytes to skip in the current block to reach [alignment]
+	struct ArenaBlock* block = arena->blocks;
+	size_t skip = 0;
+	if (block)
+		skip = (alignment - ((uintptr_t)&block->data[block->used] & (alignment - 1))) & (alignment - 1);
+
+	if (!block || block->size - block->used < skip + aligned_size)
+	{
+		// worst case a fresh block needs (alignment - DT_ARENA_ALIGNMENT) bytes of skip
+		block = __arena_new_block(arena, aligned_size + alignment - DT_ARENA_ALIGNMENT);
+		if (!block)
+			return NULL;
+		skip = (alignment - ((uintptr_t)block->data & (alignment - 1))) & (alignment - 1);
+	}
+
+	void* ptr = &block->data[block->used + skip];
+	block->used += skip + aligned_size;
+	arena->bytes_used += skip + aligned_size;
+	arena->last_allocation = ptr;
+
+	return ptr;
+}
+
+static void*
+__arena_allocate(
+	void* context,
+	size_t size)
+{
+	return __arena_allocate_aligned(context, DT_ARENA_ALIGNMENT, size);
+}
+
+static void*
+__arena_reallocate(
+	void* context,
+	void* ptr,
+	size_t old_size,
+	size_t new_size)
+{
+	struct dt_arena* arena = context;
+	struct ArenaBlock* block = arena->blocks;
+
+	// the most recent allocation can grow/shrink in place if the block has room
+	if (ptr == arena->last_allocation && block)
+	{
+		const size_t offset = (unsigned char*)ptr - block->data;
+		const size_t aligned_size = __align_up(new_size > 0 ? new_size : 1);
+		if (block->size - offset >= aligned_size)
+		{
+			arena->bytes_used = arena->bytes_used - (block->used - offset) + aligned_size;
+			block->used = offset + aligned_size;
+			return ptr;
+		}
+	}
+
+	void* new_ptr = __arena_allocate(context, new_size);
+	if (!new_ptr)
+		return NULL;
+
+	memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+
+	return new_ptr;
+}
+
+static void
+__arena_deallocate(
+	void* context,
+	void* ptr)
+{
+	// individual frees are no-ops; memory is released by dt_arena_reset/dt_arena_free
+	(void)context;
+	(void)ptr;
+}
+
+struct dt_arena*
+dt_arena_create(
+	const size_t block_size)
+{
+	struct dt_arena* arena = malloc(sizeof(*arena));
+	if (!arena)
+		return NULL;
+
+	arena->allocator.allocate = &__arena_allocate;
+	arena->allocator.reallocate = &__arena_reallocate;
+	arena->allocator.deallocate = &__arena_deallocate;
+	arena->allocator.context = arena;
+	arena->allocator.allocate_aligned = &__arena_allocate_aligned;
+
+	arena->blocks = NULL;
+	arena->block_size = block_size > 0 ? block_size : DT_ARENA_DEFAULT_BLOCK_SIZE;
+	arena->last_allocation = NULL;
+	arena->bytes_used = 0;
+
+	return arena;
+}
+
+const struct dt_allocator*
+dt_arena_allocator(
+	struct dt_arena* const arena)
+{
+	return &arena->allocator;
+}
+
+size_t
+dt_arena_bytes_used(
+	const struct dt_arena* const arena)
+{
+	return arena->bytes_used;
+}
+
+void
+dt_arena_reset(
+	struct dt_arena* const arena)
+{
+	if (!arena->blocks)
+		return;
+
+	// keep the oldest block around since the next batch will most likely need it
+	struct ArenaBlock* block = arena->blocks;
+	while (block->next)
+	{
+		struct ArenaBlock* next = block->next;
+		free(block);
+		block = next;
+	}
+
+	block->used = 0;
+	arena->blocks = block;
+	arena->last_allocation = NULL;
+	arena->bytes_used = 0;
+}
+
+void
+dt_arena_free(
+	struct dt_arena** const arena)
+{
+	if (*arena == NULL)
+		return;
+
+	struct ArenaBlock* block = (*arena)->blocks;
+	while (block)
+	{
+		struct ArenaBlock* next = block->next;
+		free(block);
+		block = next;
+	}
+
+	free(*arena);
+	*arena = NULL;
+}
@@ -0,0 +1,621 @@
+#define _POSIX_C_SOURCE 200809L
+#include "ArrowInterface.h"
+#include <string.h>
+
+// what an exported struct array and its children own, released by __release_arrow_array
+struct __arrow_array_export
+{
+	const struct dt_allocator* allocator;
+
+	// validity bitmap, values (or offsets) and string data of a column
+	const void* buffers[3];
+
+	// buffers converted for the export (the others belong to the table)
+	void* converted[3];
+
+	// children of the struct array (one per column)
+	struct ArrowArray** children;
+	struct ArrowArray* child_arrays;
+	struct __arrow_array_export* child_exports;
+};
+
+// what an exported schema and its children own, released by __release_arrow_schema
+struct __arrow_schema_export
+{
+	const struct dt_allocator* allocator;
+	char name[DT_MAX_COL_LEN];
+
+	struct ArrowSchema** children;
+	struct ArrowSchema* child_schemas;
+	struct __arrow_schema_export* child_exports;
+};
+
+static void
+__release_arrow_array(
+	struct ArrowArray* array)
+{
+	struct __arrow_array_export* const export = array->private_data;
+	const struct dt_allocator* const allocator = export->allocator;
+
+	// children moved out by the consumer have no release callback anymore
+	for (int64_t i = 0; i < array->n_children; ++i)
+	{
+		if (array->children[i]->release)
+			array->children[i]->release(array->children[i]);
+	}
+
+	for (size_t i = 0; i < 3; ++i)
+		dt_aligned_free(allocator, export->converted[i]);
+
+	// the children are released first, their exports belong to the parent's
+	if (export->children)
+	{
+		dt_free(allocator, export->children);
+		dt_free(allocator, export->child_arrays);
+		dt_free(allocator, export->child_exports);
+		dt_free(allocator, export);
+	}
+
+	array->release = NULL;
+}
+
+static void
+__release_arrow_schema(
+	struct ArrowSchema* schema)
+{
+	struct __arrow_schema_export* const export = schema->private_data;
+	for (int64_t i = 0; i < schema->n_children; ++i)
+	{
+		if (schema->children[i]->release)
+			schema->children[i]->release(schema->children[i]);
+	}
+
+	if (export->children)
+	{
+		const struct dt_allocator* const allocator = export->allocator;
+		dt_free(allocator, export->children);
+		dt_free(allocator, export->child_schemas);
+		dt_free(allocator, export->child_exports);
+		dt_free(allocator, export);
+	}
+
+	schema->release = NULL;
+}
+
+// copy a column [name] into [dest], truncated to DT_MAX_COL_LEN - 1 characters
+static void
+__copy_column_name(
+	char* const dest,
+	const char* const name)
+{
+	const size_t length = strnlen(name, DT_MAX_COL_LEN - 1);
+	memcpy(dest, name, length);
+	dest[length] = '\0';
+}
+
+// Arrow format string of a [column] (large_utf8 if [is_large] for STRING columns)
+static const char*
+__arrow_format(
+	const struct DataColumn* const column,
+	const bool is_large)
+{
+	switch (column->type)
+	{
+		case FLOAT:
+			return "f";
+		case DOUBLE:
+			return "g";
+		case INT8:
+			return "c";
+		case INT16:
+			return "s";
+		case INT32:
+			return "i";
+		case INT64:
+			return "l";
+		case UINT8:
+			return "C";
+		case UINT16:
+			return "S";
+		case UINT32:
+			return "I";
+		case UINT64:
+			return "L";
+		case STRING:
+			return is_large ? "U" : "u";
+		case BOOL:
+			return "b";
+		case DATE:
+			return "tdD";
+		case TIMESTAMP:
+			switch (column->time_unit)
+			{
+				case DT_TIME_UNIT_SECONDS:
+					return "tss:UTC";
+				case DT_TIME_UNIT_MILLISECONDS:
+					return "tsm:UTC";
+				case DT_TIME_UNIT_MICROSECONDS:
+					return "tsu:UTC";
+				case DT_TIME_UNIT_NANOSECONDS:
+					return "tsn:UTC";
+			}
+			break;
+	}
+
+	return NULL;
+}
+
+// type (and time unit) of an Arrow [format] string; false if it has no column type
+static bool
+__arrow_type(
+	const char* const format,
+	enum data_type_e* const type,
+	enum dt_time_unit_e* const time_unit,
+	bool* const is_large)
+{
+	static const char* const formats = "fgcsilCSILb";
+	static const enum data_type_e types[] = {
+		FLOAT, DOUBLE, INT8, INT16, INT32, INT64, UINT8, UINT16, UINT32, UINT64, BOOL
+	};
+
+	*is_large = false;
+	if (format[0] != '\0' && format[1] == '\0')
+	{
+		const char* const found = strchr(formats, format[0]);
+		if (found)
+		{
+			*type = types[found - formats];
+			return true;
+		}
+
+		if (format[0] == 'u' || format[0] == 'U')
+		{
+			*type = STRING;
+			*is_large = format[0] == 'U';
+			return true;
+		}
+
+		return false;
+	}
+
+	if (strcmp(format, "tdD") == 0)
+	{
+		*type = DATE;
+		return true;
+	}
+
+	// "ts" + unit + ":" + time zone (the values are UTC whatever the zone)
+	if (strncmp(format, "ts", 2) == 0 && format[2] != '\0' && format[3] == ':')
+	{
+		static const char* const units = "smun";
+		const char* const found = strchr(units, format[2]);
+		if (!found)
+			return false;
+
+		*type = TIMESTAMP;
+		*time_unit = (enum dt_time_unit_e)(DT_TIME_UNIT_SECONDS + (found - units));
+		return true;
+	}
+
+	return false;
+}
+
+// validity bitmap of [column] for an array starting at bit [offset]
+static uint8_t*
+__export_arrow_validity(
+	const struct DataColumn* const column,
+	const size_t offset)
+{
+	const size_t size = (offset + column->n_values + 7) / 8;
+	uint8_t* validity = dt_aligned_calloc(column->allocator, size, 1);
+	if (!validity)
+		return NULL;
+
+	memset(validity, 0xFF, size);
+	for (size_t i = 0; i < column->n_null_values; ++i)
+	{
+		const size_t position = offset + column->null_value_indices[i];
+		validity[position >> 3] &= (uint8_t)~(1u << (position & 7));
+	}
+
+	return validity;
+}
+
+// offsets (int32_t, or int64_t if [*is_large]) and packed bytes of a STRING [column]
+static enum status_code_e
+__export_arrow_strings(
+	const struct DataColumn* const column,
+	struct __arrow_array_export* const export,
+	bool* const is_large)
+{
+	size_t n_bytes = 0;
+	for (size_t i = 0; i < column->n_values; ++i)
+	{
+		const char* const value = *(char**)dt_column_get_value_ptr(column, i);
+		n_bytes += value ? strlen(value) : 0;
+	}
+
+	*is_large = n_bytes > INT32_MAX;
+	const size_t offset_size = *is_large ? sizeof(int64_t) : sizeof(int32_t);
+	export->converted[1] = dt_aligned_calloc(column->allocator, column->n_values + 1, offset_size);
+	export->converted[2] = dt_aligned_calloc(column->allocator, n_bytes > 0 ? n_bytes : 1, 1);
+	if (!export->converted[1] || !export->converted[2])
+		return DT_ALLOC_ERROR;
+
+	char* const bytes = export->converted[2];
+	size_t offset = 0;
+	for (size_t i = 0; i <= column->n_values; ++i)
+	{
+		if (*is_large)
+			((int64_t*)export->converted[1])[i] = (int64_t)offset;
+		else
+			((int32_t*)export->converted[1])[i] = (int32_t)offset;
+
+		const char* const value = i < column->n_values ? *(char**)dt_column_get_value_ptr(column, i) : NULL;
+		if (value)
+		{
+			const size_t length = strlen(value);
+			memcpy(bytes + offset, value, length);
+			offset += length;
+		}
+	}
+
+	return DT_SUCCESS;
+}
+
+// fill [array] with the values of [column], shared when the layouts match
+static enum status_code_e
+__export_arrow_column(
+	const struct DataColumn* const column,
+	struct ArrowArray* const array,
+	struct __arrow_array_export* const export,
+	bool* const is_large)
+{
+	*is_large = false;
+	array->length = (int64_t)column->n_values;
+	array->null_count = (int64_t)column->n_null_values;
+	array->offset = column->type == BOOL ? (int64_t)column->bit_offset : 0;
+	array->n_buffers = column->type == STRING ? 3 : 2;
+	array->n_children = 0;
+	array->buffers = export->buffers;
+	array->children = NULL;
+	array->dictionary = NULL;
+	array->release = &__release_arrow_array;
+	array->private_data = export;
+
+	if (column->n_null_values > 0)
+	{
+		export->converted[0] = __export_arrow_validity(column, (size_t)array->offset);
+		if (!export->converted[0])
+			return DT_ALLOC_ERROR;
+	}
+	export->buffers[0] = export->converted[0];
+
+	if (column->type == STRING)
+	{
+		const enum status_code_e status = __export_arrow_strings(column, export, is_large);
+		export->buffers[1] = export->converted[1];
+		export->buffers[2] = export->converted[2];
+		return status;
+	}
+
+	// chunked columns are copied into a single buffer
+	if (column->chunk_size > 0)
+	{
+		export->converted[1] = dt_aligned_calloc(column->allocator, column->n_values + 1, column->type_size);
+		if (!export->converted[1])
+			return DT_ALLOC_ERROR;
+
+		for (size_t i = 0; i < column->n_values; ++i)
+			memcpy((char*)export->converted[1] + i * column->type_size, dt_column_get_value_ptr(column, i), column->type_size);
+		export->buffers[1] = export->converted[1];
+		return DT_SUCCESS;
+	}
+
+	export->buffers[1] = column->value;
+	return DT_SUCCESS;
+}
+
+// fill [schema] with the struct type of [table] (whose columns were exported as
+// [child_arrays], telling which STRING columns are large)
+static enum status_code_e
+__export_arrow_schema(
+	const struct DataTable* const table,
+	const bool* const is_large,
+	struct ArrowSchema* const schema)
+{
+	const struct dt_allocator* const allocator = table->allocator;
+	const size_t n_columns = table->n_columns;
+
+	struct __arrow_schema_export* export = dt_calloc(allocator, 1, sizeof(*export));
+	struct ArrowSchema** children = dt_calloc(allocator, n_columns + 1, sizeof(*children));
+	struct ArrowSchema* child_schemas = dt_calloc(allocator, n_columns + 1, sizeof(*child_schemas));
+	struct __arrow_schema_export* child_exports = dt_calloc(allocator, n_columns + 1, sizeof(*child_exports));
+	if (!export || !children || !child_schemas || !child_exports)
+	{
+		dt_free(allocator, export);
+		dt_free(allocator, children);
+		dt_free(allocator, child_schemas);
+		dt_free(allocator, child_exports);
+		return DT_ALLOC_ERROR;
+	}
+
+	export->allocator = allocator;
+	export->children = children;
+	export->child_schemas = child_schemas;
+	export->child_exports = child_exports;
+
+	for (size_t i = 0; i < n_columns; ++i)
+	{
+		struct __arrow_schema_export* const child_export = &child_exports[i];
+		__copy_column_name(child_export->name, table->columns[i].name);
+
+		children[i] = &child_schemas[i];
+		children[i]->format = __arrow_format(table->columns[i].column, is_large[i]);
+		children[i]->name = child_export->name;
+		children[i]->metadata = NULL;
+		children[i]->flags = ARROW_FLAG_NULLABLE;
+		children[i]->n_children = 0;
+		children[i]->children = NULL;
+		children[i]->dictionary = NULL;
+		children[i]->release = &__release_arrow_schema;
+		children[i]->private_data = child_export;
+	}
+
+	schema->format = "+s";
+	schema->name = export->name;
+	schema->metadata = NULL;
+	schema->flags = 0;
+	schema->n_children = (int64_t)n_columns;
+	schema->children = children;
+	schema->dictionary = NULL;
+	schema->release = &__release_arrow_schema;
+	schema->private_data = export;
+
+	return DT_SUCCESS;
+}
+
+enum status_code_e
+dt_table_export_arrow(
+	const struct DataTable* const table,
+	struct ArrowSchema* const schema,
+	struct ArrowArray* const array)
+{
+	if (dt_table_load_columns((struct DataTable*)table) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	const struct dt_allocator* const allocator = table->allocator;
+	const size_t n_columns = table->n_columns;
+
+	struct __arrow_array_export* export = dt_calloc(allocator, 1, sizeof(*export));
+	struct ArrowArray** children = dt_calloc(allocator, n_columns + 1, sizeof(*children));
+	struct ArrowArray* child_arrays = dt_calloc(allocator, n_columns + 1, sizeof(*child_arrays));
+	struct __arrow_array_export* child_exports = dt_calloc(allocator, n_columns + 1, sizeof(*child_exports));
+	bool* is_large = dt_calloc(allocator, n_columns + 1, sizeof(bool));
+	if (!export || !children || !child_arrays || !child_exports || !is_large)
+	{
+		dt_free(allocator, export);
+		dt_free(allocator, children);
+		dt_free(allocator, child_arrays);
+		dt_free(allocator, child_exports);
+		dt_free(allocator, is_large);
+		return DT_ALLOC_ERROR;
+	}
+
+	export->allocator = allocator;
+	export->children = children;
+	export->child_arrays = child_arrays;
+	export->child_exports = child_exports;
+
+	struct ArrowArray exported = {
+		.length = (int64_t)table->n_rows,
+		.null_count = 0,
+		.offset = 0,
+		.n_buffers = 1,
+		.n_children = (int64_t)n_columns,
+		.buffers = export->buffers,
+		.children = children,
+		.dictionary = NULL,
+		.release = &__release_arrow_array,
+		.private_data = export
+	};
+
+	enum status_code_e status = DT_SUCCESS;
+	for (size_t i = 0; i < n_columns; ++i)
+	{
+		children[i] = &child_arrays[i];
+		child_exports[i].allocator = allocator;
+		status = __export_arrow_column(table->columns[i].column, children[i], &child_exports[i], &is_large[i]);
+		if (status != DT_SUCCESS)
+		{
+			exported.n_children = (int64_t)i + 1;
+			break;
+		}
+	}
+
+	if (status == DT_SUCCESS)
+		status = __export_arrow_schema(table, is_large, schema);
+	dt_free(allocator, is_large);
+
+	if (status != DT_SUCCESS)
+	{
+		__release_arrow_array(&exported);
+		return status;
+	}
+
+	*array = exported;
+	return DT_SUCCESS;
+}
+
+// create a BOOL column of [length] values from bit [offset] of an Arrow boolean array
+static struct DataColumn*
+__import_arrow_bools(
+	const struct ArrowArray* const child,
+	const size_t offset,
+	const size_t length,
+	const struct dt_allocator* const allocator)
+{
+	struct DataColumn* column = NULL;
+	if (dt_column_create_with_allocator(&column, length, BOOL, allocator) != DT_SUCCESS)
+		return NULL;
+
+	const uint8_t* const validity = child->buffers[0];
+	const uint8_t* const bits = child->buffers[1];
+	uint64_t* const words = column->value;
+	for (size_t i = 0; i < length; ++i)
+	{
+		const size_t position = offset + i;
+		if (validity && !((validity[position >> 3] >> (position & 7)) & 1))
+		{
+			if (dt_column_set_value(column, i, NULL) != DT_SUCCESS)
+			{
+				dt_column_free(&column);
+				return NULL;
+			}
+		}
+		else if ((bits[position >> 3] >> (position & 7)) & 1)
+			words[i >> 6] |= (uint64_t)1 << (i & 63);
+	}
+
+	return column;
+}
+
+// create a STRING column of [length] values from value [offset] of an Arrow utf8
+// (or large_utf8 if [is_large]) array
+static struct DataColumn*
+__import_arrow_strings(
+	const struct ArrowArray* const child,
+	const size_t offset,
+	const size_t length,
+	const bool is_large,
+	const struct dt_allocator* const allocator)
+{
+	struct DataColumn* column = NULL;
+	if (dt_column_create_with_allocator(&column, length, STRING, allocator) != DT_SUCCESS)
+		return NULL;
+
+	const uint8_t* const validity = child->buffers[0];
+	const char* const bytes = child->buffers[2];
+	char** const strings = column->value;
+	for (size_t i = 0; i < length; ++i)
+	{
+		const size_t position = offset + i;
+		if (validity && !((validity[position >> 3] >> (position & 7)) & 1))
+		{
+			if (dt_column_set_value(column, i, NULL) != DT_SUCCESS)
+			{
+				dt_column_free(&column);
+				return NULL;
+			}
+			continue;
+		}
+
+		const size_t start = is_large ? (size_t)((const int64_t*)child->buffers[1])[position] : (size_t)((const int32_t*)child->buffers[1])[position];
+		const size_t end = is_large ? (size_t)((const int64_t*)child->buffers[1])[position + 1] : (size_t)((const int32_t*)child->buffers[1])[position + 1];
+		strings[i] = dt_alloc(allocator, end - start + 1);
+		if (!strings[i])
+		{
+			dt_column_free(&column);
+			return NULL;
+		}
+		memcpy(strings[i], bytes + start, end - start);
+		strings[i][end - start] = '\0';
+	}
+
+	return column;
+}
+
+// create the column of [length] rows from row [offset] of a struct array held by its
+// [child] array of type [format] (whose values start at its own offset)
+static struct DataColumn*
+__import_arrow_column(
+	const char* const format,
+	const struct ArrowArray* const child,
+	const size_t offset,
+	const size_t length,
+	const struct dt_allocator* const allocator)
+{
+	enum data_type_e type;
+	enum dt_time_unit_e time_unit = DT_DEFAULT_TIME_UNIT;
+	bool is_large = false;
+	if (!format || !__arrow_type(format, &type, &time_unit, &is_large)
+			|| child->dictionary || child->offset < 0 || child->length < 0
+			|| (size_t)child->length < offset + length
+			|| child->n_buffers != (type == STRING ? 3 : 2))
+		return NULL;
+
+	const size_t position = (size_t)child->offset + offset;
+	if (type == BOOL)
+		return __import_arrow_bools(child, position, length, allocator);
+
+	if (type == STRING)
+		return __import_arrow_strings(child, position, length, is_large, allocator);
+
+	// without null values the bitmap (if any) doesn't need to be scanned
+	const uint8_t* const validity = child->null_count == 0 ? NULL : child->buffers[0];
+	struct DataColumn* column = dt_column_wrap(type, child->buffers[1], validity, position, length, allocator);
+	if (column)
+		column->time_unit = time_unit;
+
+	return column;
+}
+
+struct DataTable*
+dt_table_import_arrow(
+	const struct ArrowSchema* const schema,
+	struct ArrowArray* const array)
+{
+	if (!array->release || !schema->format || strcmp(schema->format, "+s") != 0
+			|| array->n_children != schema->n_children || array->length < 0 || array->offset < 0
+			|| (array->null_count != 0 && array->n_buffers > 0 && array->buffers[0]))
+		return NULL;
+
+	const struct dt_allocator* const allocator = dt_get_default_allocator();
+	struct DataTable* table = dt_calloc(allocator, 1, sizeof(*table));
+	if (!table)
+		return NULL;
+
+	const size_t n_columns = (size_t)array->n_children;
+	table->allocator = allocator;
+	table->n_rows = (size_t)array->length;
+	table->column_capacity = n_columns;
+	table->columns = dt_calloc(allocator, n_columns + 1, sizeof(struct ColumnPair));
+	table->arrow = dt_alloc(allocator, sizeof(*table->arrow));
+	if (!table->columns || !table->arrow)
+	{
+		dt_free(allocator, table->arrow);
+		table->arrow = NULL;
+		dt_table_free(&table);
+		return NULL;
+	}
+
+	for (size_t i = 0; i < n_columns; ++i)
+	{
+		const struct ArrowSchema* const child_schema = schema->children[i];
+		const struct ArrowArray* const child = array->children[i];
+
+		struct ColumnPair* const pair = &table->columns[i];
+		if (child_schema->name)
+			__copy_column_name(pair->name, child_schema->name);
+		pair->column = __import_arrow_column(
+				child_schema->format,
+				child,
+				(size_t)array->offset,
+				table->n_rows,
+				allocator);
+		if (!pair->column)
+		{
+			dt_free(allocator, table->arrow);
+			table->arrow = NULL;
+			dt_table_free(&table);
+			return NULL;
+		}
+		table->n_columns++;
+	}
+
+	// the table now owns the array
+	*table->arrow = *array;
+	array->release = NULL;
+
+	return table;
+}
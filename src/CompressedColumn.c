@@ -0,0 +1,820 @@
+#define _POSIX_C_SOURCE 199309L
+#include "CompressedColumn.h"
+#include <time.h>
+
+/*
+ * every value is converted to an unsigned 64-bit "key" that preserves the ordering
+ * of the original type: unsigned values are zero-extended and signed values are
+ * sign-extended with their top bit flipped (which is the same as adding 2^63).
+ * this way min/max, range checks and frame-of-reference offsets are plain unsigned
+ * arithmetic regardless of the column type.
+ */
+#define SIGN_BIT ((uint64_t)1 << 63)
+
+static bool
+__is_integer_type(
+	const enum data_type_e type)
+{
+	switch (type)
+	{
+		case INT8:
+		case INT16:
+		case INT32:
+		case INT64:
+		case UINT8:
+		case UINT16:
+		case UINT32:
+		case UINT64:
+		case DATE:
+		case TIMESTAMP:
+			return true;
+		case FLOAT:
+		case DOUBLE:
+		case STRING:
+		case BOOL:
+			return false;
+	}
+
+	return false;
+}
+
+static bool
+__is_signed_type(
+	const enum data_type_e type)
+{
+	return type == INT8 || type == INT16 || type == INT32 || type == INT64
+		|| type == DATE || type == TIMESTAMP;
+}
+
+static uint64_t
+__to_key(
+	const enum data_type_e type,
+	const void* const value)
+{
+	switch (type)
+	{
+		case INT8:
+			return (uint64_t)(int64_t)*(const int8_t*)value ^ SIGN_BIT;
+		case INT16:
+			return (uint64_t)(int64_t)*(const int16_t*)value ^ SIGN_BIT;
+		case INT32:
+		case DATE:
+			return (uint64_t)(int64_t)*(const int32_t*)value ^ SIGN_BIT;
+		case INT64:
+		case TIMESTAMP:
+			return (uint64_t)*(const int64_t*)value ^ SIGN_BIT;
+		case UINT8:
+			return *(const uint8_t*)value;
+		case UINT16:
+			return *(const uint16_t*)value;
+		case UINT32:
+			return *(const uint32_t*)value;
+		case UINT64:
+			return *(const uint64_t*)value;
+		case FLOAT:
+		case DOUBLE:
+		case STRING:
+		case BOOL:
+			return 0;
+	}
+
+	return 0;
+}
+
+// a macro to store an array of keys into a typed buffer
+#define store_keys(keys, n_keys, buffer, type, flip) \
+	for (size_t _i = 0; _i < n_keys; ++_i) \
+		((type*)(buffer))[_i] = (type)((keys)[_i] ^ (flip));
+
+static void
+__store_keys(
+	const enum data_type_e type,
+	const uint64_t* const keys,
+	const size_t n_keys,
+	void* buffer)
+{
+	switch (type)
+	{
+		case INT8:
+			store_keys(keys, n_keys, buffer, int8_t, SIGN_BIT);
+			break;
+		case INT16:
+			store_keys(keys, n_keys, buffer, int16_t, SIGN_BIT);
+			break;
+		case INT32:
+		case DATE:
+			store_keys(keys, n_keys, buffer, int32_t, SIGN_BIT);
+			break;
+		case INT64:
+		case TIMESTAMP:
+			store_keys(keys, n_keys, buffer, int64_t, SIGN_BIT);
+			break;
+		case UINT8:
+			store_keys(keys, n_keys, buffer, uint8_t, 0);
+			break;
+		case UINT16:
+			store_keys(keys, n_keys, buffer, uint16_t, 0);
+			break;
+		case UINT32:
+			store_keys(keys, n_keys, buffer, uint32_t, 0);
+			break;
+		case UINT64:
+			store_keys(keys, n_keys, buffer, uint64_t, 0);
+			break;
+		case FLOAT:
+		case DOUBLE:
+		case STRING:
+		case BOOL:
+			break;
+	}
+}
+
+// add a value (given modulo 2^64) to [result] of the column's type.
+// wrapping matches what dt_column_sum does for the same type.
+static void
+__add_to_result(
+	const enum data_type_e type,
+	const uint64_t value,
+	void* result)
+{
+	switch (type)
+	{
+		case INT8:
+			*(int8_t*)result += (int8_t)value;
+			break;
+		case INT16:
+			*(int16_t*)result += (int16_t)value;
+			break;
+		case INT32:
+		case DATE:
+			*(int32_t*)result += (int32_t)value;
+			break;
+		case INT64:
+		case TIMESTAMP:
+			*(int64_t*)result += (int64_t)value;
+			break;
+		case UINT8:
+			*(uint8_t*)result += (uint8_t)value;
+			break;
+		case UINT16:
+			*(uint16_t*)result += (uint16_t)value;
+			break;
+		case UINT32:
+			*(uint32_t*)result += (uint32_t)value;
+			break;
+		case UINT64:
+			*(uint64_t*)result += value;
+			break;
+		case FLOAT:
+		case DOUBLE:
+		case STRING:
+		case BOOL:
+			break;
+	}
+}
+
+static uint8_t
+__bit_width(
+	uint64_t value)
+{
+	uint8_t width = 0;
+	while (value)
+	{
+		width++;
+		value >>= 1;
+	}
+
+	return width;
+}
+
+static size_t
+__n_packed_words(
+	const size_t n_values,
+	const uint8_t bit_width)
+{
+	return (n_values * bit_width + 63) / 64;
+}
+
+static void
+__pack(
+	uint64_t* const words,
+	const size_t index,
+	const uint8_t bit_width,
+	const uint64_t value)
+{
+	if (bit_width == 0)
+		return;
+
+	const size_t bit = index * bit_width;
+	const size_t word = bit >> 6;
+	const unsigned shift = bit & 63;
+
+	words[word] |= value << shift;
+	if (shift + bit_width > 64)
+		words[word + 1] |= value >> (64 - shift);
+}
+
+static uint64_t
+__unpack(
+	const uint64_t* const words,
+	const size_t index,
+	const uint8_t bit_width)
+{
+	if (bit_width == 0)
+		return 0;
+
+	const size_t bit = index * bit_width;
+	const size_t word = bit >> 6;
+	const unsigned shift = bit & 63;
+
+	uint64_t value = words[word] >> shift;
+	if (shift + bit_width > 64)
+		value |= words[word + 1] << (64 - shift);
+
+	return bit_width == 64 ? value : value & (((uint64_t)1 << bit_width) - 1);
+}
+
+static bool
+__encode_block(
+	const struct CompressedColumn* const column,
+	struct CompressedBlock* const block,
+	const uint64_t* const keys,
+	const size_t n_keys)
+{
+	block->n_values = n_keys;
+	block->min = keys[0];
+	block->max = keys[0];
+	for (size_t i = 1; i < n_keys; ++i)
+	{
+		if (keys[i] < block->min)
+			block->min = keys[i];
+		if (keys[i] > block->max)
+			block->max = keys[i];
+	}
+
+	size_t n_packed = n_keys;
+	if (column->encoding == DT_ENCODING_FOR)
+	{
+		block->reference = block->min;
+		block->delta_reference = 0;
+		block->bit_width = __bit_width(block->max - block->min);
+	}
+	else
+	{
+		// differences are compared as signed values so that small
+		// decreases don't blow up the bit width
+		block->reference = keys[0];
+		int64_t min_delta = 0;
+		int64_t max_delta = 0;
+		for (size_t i = 1; i < n_keys; ++i)
+		{
+			const int64_t delta = (int64_t)(keys[i] - keys[i - 1]);
+			if (i == 1 || delta < min_delta)
+				min_delta = delta;
+			if (i == 1 || delta > max_delta)
+				max_delta = delta;
+		}
+		block->delta_reference = (uint64_t)min_delta;
+		block->bit_width = __bit_width((uint64_t)max_delta - (uint64_t)min_delta);
+		n_packed = n_keys - 1;
+	}
+
+	block->packed = NULL;
+	const size_t n_words = __n_packed_words(n_packed, block->bit_width);
+	if (n_words == 0)
+		return true;
+
+	block->packed = dt_calloc(column->allocator, n_words, sizeof(uint64_t));
+	if (!block->packed)
+		return false;
+
+	if (column->encoding == DT_ENCODING_FOR)
+		for (size_t i = 0; i < n_keys; ++i)
+			__pack(block->packed, i, block->bit_width, keys[i] - block->reference);
+	else
+		for (size_t i = 1; i < n_keys; ++i)
+			__pack(block->packed, i - 1, block->bit_width, keys[i] - keys[i - 1] - block->delta_reference);
+
+	return true;
+}
+
+// decode the keys of a block into [keys] (at least block->n_values long)
+static void
+__decode_block(
+	const struct CompressedColumn* const column,
+	const struct CompressedBlock* const block,
+	uint64_t* const keys)
+{
+	if (column->encoding == DT_ENCODING_FOR)
+	{
+		for (size_t i = 0; i < block->n_values; ++i)
+			keys[i] = block->reference + __unpack(block->packed, i, block->bit_width);
+		return;
+	}
+
+	uint64_t key = block->reference;
+	keys[0] = key;
+	for (size_t i = 1; i < block->n_values; ++i)
+	{
+		key += __unpack(block->packed, i - 1, block->bit_width) + block->delta_reference;
+		keys[i] = key;
+	}
+}
+
+static bool
+__encode_runs(
+	struct CompressedColumn* const compressed,
+	const struct DataColumn* const column)
+{
+	size_t capacity = 16;
+	compressed->run_values = dt_alloc(compressed->allocator, capacity * sizeof(uint64_t));
+	compressed->run_lengths = dt_alloc(compressed->allocator, capacity * sizeof(size_t));
+	if (!compressed->run_values || !compressed->run_lengths)
+		return false;
+
+	for (size_t i = 0; i < column->n_values; ++i)
+	{
+		const uint64_t key = __to_key(column->type, dt_column_get_value_ptr(column, i));
+		if (compressed->n_runs > 0 && compressed->run_values[compressed->n_runs - 1] == key)
+		{
+			compressed->run_lengths[compressed->n_runs - 1]++;
+			continue;
+		}
+
+		if (compressed->n_runs == capacity)
+		{
+			void* values = dt_realloc(
+				compressed->allocator,
+				compressed->run_values,
+				capacity * sizeof(uint64_t),
+				capacity * 2 * sizeof(uint64_t));
+			if (!values)
+				return false;
+			compressed->run_values = values;
+
+			void* lengths = dt_realloc(
+				compressed->allocator,
+				compressed->run_lengths,
+				capacity * sizeof(size_t),
+				capacity * 2 * sizeof(size_t));
+			if (!lengths)
+				return false;
+			compressed->run_lengths = lengths;
+
+			capacity *= 2;
+		}
+
+		compressed->run_values[compressed->n_runs] = key;
+		compressed->run_lengths[compressed->n_runs] = 1;
+		compressed->n_runs++;
+	}
+
+	return true;
+}
+
+struct CompressedColumn*
+dt_column_compress(
+	const struct DataColumn* const column,
+	const enum dt_encoding_e encoding)
+{
+	if (!__is_integer_type(column->type))
+		return NULL;
+
+	struct CompressedColumn* compressed = dt_calloc(column->allocator, 1, sizeof(*compressed));
+	if (!compressed)
+		return NULL;
+
+	compressed->type = column->type;
+	compressed->time_unit = column->time_unit;
+	compressed->encoding = encoding;
+	compressed->n_values = column->n_values;
+	compressed->allocator = column->allocator;
+
+	if (column->n_null_values > 0)
+	{
+		compressed->null_value_indices = dt_alloc(compressed->allocator, column->n_null_values * sizeof(size_t));
+		if (!compressed->null_value_indices)
+			goto alloc_error;
+		memcpy(compressed->null_value_indices, column->null_value_indices, column->n_null_values * sizeof(size_t));
+		compressed->n_null_values = column->n_null_values;
+	}
+
+	switch (encoding)
+	{
+		case DT_ENCODING_RLE:
+		{
+			if (!__encode_runs(compressed, column))
+				goto alloc_error;
+			break;
+		}
+		case DT_ENCODING_DELTA:
+		case DT_ENCODING_FOR:
+		{
+			const size_t n_blocks = (column->n_values + DT_COMPRESSION_BLOCK_SIZE - 1) / DT_COMPRESSION_BLOCK_SIZE;
+			if (n_blocks == 0)
+				break;
+
+			compressed->blocks = dt_calloc(compressed->allocator, n_blocks, sizeof(struct CompressedBlock));
+			if (!compressed->blocks)
+				goto alloc_error;
+
+			uint64_t keys[DT_COMPRESSION_BLOCK_SIZE];
+			for (size_t b = 0; b < n_blocks; ++b)
+			{
+				const size_t start = b * DT_COMPRESSION_BLOCK_SIZE;
+				size_t n_keys = column->n_values - start;
+				if (n_keys > DT_COMPRESSION_BLOCK_SIZE)
+					n_keys = DT_COMPRESSION_BLOCK_SIZE;
+
+				for (size_t i = 0; i < n_keys; ++i)
+					keys[i] = __to_key(column->type, dt_column_get_value_ptr(column, start + i));
+
+				compressed->n_blocks++;
+				if (!__encode_block(compressed, &compressed->blocks[b], keys, n_keys))
+					goto alloc_error;
+			}
+			break;
+		}
+	}
+
+	return compressed;
+
+alloc_error:
+	dt_compressed_column_free(&compressed);
+	return NULL;
+}
+
+void
+dt_compressed_column_free(
+	struct CompressedColumn** const column)
+{
+	if (*column == NULL)
+		return;
+
+	const struct dt_allocator* const allocator = (*column)->allocator;
+
+	for (size_t b = 0; b < (*column)->n_blocks; ++b)
+		dt_free(allocator, (*column)->blocks[b].packed);
+	dt_free(allocator, (*column)->blocks);
+
+	dt_free(allocator, (*column)->run_values);
+	dt_free(allocator, (*column)->run_lengths);
+	dt_free(allocator, (*column)->null_value_indices);
+
+	dt_free(allocator, *column);
+	*column = NULL;
+}
+
+size_t
+dt_compressed_column_size(
+	const struct CompressedColumn* const column)
+{
+	size_t size = sizeof(*column);
+	size += column->n_blocks * sizeof(struct CompressedBlock);
+	for (size_t b = 0; b < column->n_blocks; ++b)
+	{
+		const struct CompressedBlock* const block = &column->blocks[b];
+		const size_t n_packed = column->encoding == DT_ENCODING_DELTA ? block->n_values - 1 : block->n_values;
+		size += __n_packed_words(n_packed, block->bit_width) * sizeof(uint64_t);
+	}
+	size += column->n_runs * (sizeof(uint64_t) + sizeof(size_t));
+	size += column->n_null_values * sizeof(size_t);
+
+	return size;
+}
+
+void
+dt_compressed_column_decode(
+	const struct CompressedColumn* const column,
+	void* buffer)
+{
+	const size_t type_size = dt_type_to_size(column->type);
+
+	switch (column->encoding)
+	{
+		case DT_ENCODING_RLE:
+		{
+			char* dest = buffer;
+			for (size_t r = 0; r < column->n_runs; ++r)
+			{
+				// store the run value once and replicate it
+				__store_keys(column->type, &column->run_values[r], 1, dest);
+				for (size_t i = 1; i < column->run_lengths[r]; ++i)
+					memcpy(dest + i * type_size, dest, type_size);
+				dest += column->run_lengths[r] * type_size;
+			}
+			break;
+		}
+		case DT_ENCODING_DELTA:
+		case DT_ENCODING_FOR:
+		{
+			uint64_t keys[DT_COMPRESSION_BLOCK_SIZE];
+			char* dest = buffer;
+			for (size_t b = 0; b < column->n_blocks; ++b)
+			{
+				__decode_block(column, &column->blocks[b], keys);
+				__store_keys(column->type, keys, column->blocks[b].n_values, dest);
+				dest += column->blocks[b].n_values * type_size;
+			}
+			break;
+		}
+	}
+}
+
+struct DataColumn*
+dt_compressed_column_decompress(
+	const struct CompressedColumn* const column)
+{
+	struct DataColumn* decompressed = NULL;
+	if (dt_column_create_with_allocator(&decompressed, column->n_values, column->type, column->allocator) != DT_SUCCESS)
+		return NULL;
+	decompressed->time_unit = column->time_unit;
+
+	dt_compressed_column_decode(column, decompressed->value);
+
+	for (size_t i = 0; i < column->n_null_values; ++i)
+	{
+		if (dt_column_set_value(decompressed, column->null_value_indices[i], NULL) != DT_SUCCESS)
+		{
+			dt_column_free(&decompressed);
+			return NULL;
+		}
+	}
+
+	return decompressed;
+}
+
+void
+dt_compressed_column_sum(
+	const struct CompressedColumn* const column,
+	void* result)
+{
+	// sum of the keys modulo 2^64
+	uint64_t total = 0;
+
+	switch (column->encoding)
+	{
+		case DT_ENCODING_RLE:
+		{
+			for (size_t r = 0; r < column->n_runs; ++r)
+				total += column->run_values[r] * (uint64_t)column->run_lengths[r];
+			break;
+		}
+		case DT_ENCODING_FOR:
+		{
+			// n * reference + sum of the packed offsets
+			for (size_t b = 0; b < column->n_blocks; ++b)
+			{
+				const struct CompressedBlock* const block = &column->blocks[b];
+				total += block->reference * (uint64_t)block->n_values;
+				for (size_t i = 0; i < block->n_values; ++i)
+					total += __unpack(block->packed, i, block->bit_width);
+			}
+			break;
+		}
+		case DT_ENCODING_DELTA:
+		{
+			uint64_t keys[DT_COMPRESSION_BLOCK_SIZE];
+			for (size_t b = 0; b < column->n_blocks; ++b)
+			{
+				__decode_block(column, &column->blocks[b], keys);
+				for (size_t i = 0; i < column->blocks[b].n_values; ++i)
+					total += keys[i];
+			}
+			break;
+		}
+	}
+
+	// a signed key is its value + 2^63, so remove n * 2^63
+	if (__is_signed_type(column->type) && column->n_values % 2 == 1)
+		total ^= SIGN_BIT;
+
+	__add_to_result(column->type, total, result);
+}
+
+void
+dt_compressed_column_max(
+	const struct CompressedColumn* const column,
+	void* result)
+{
+	if (column->n_values == 0)
+		return;
+
+	uint64_t max = 0;
+	for (size_t b = 0; b < column->n_blocks; ++b)
+		if (column->blocks[b].max > max)
+			max = column->blocks[b].max;
+	for (size_t r = 0; r < column->n_runs; ++r)
+		if (column->run_values[r] > max)
+			max = column->run_values[r];
+
+	__store_keys(column->type, &max, 1, result);
+}
+
+void
+dt_compressed_column_min(
+	const struct CompressedColumn* const column,
+	void* result)
+{
+	if (column->n_values == 0)
+		return;
+
+	uint64_t min = UINT64_MAX;
+	for (size_t b = 0; b < column->n_blocks; ++b)
+		if (column->blocks[b].min < min)
+			min = column->blocks[b].min;
+	for (size_t r = 0; r < column->n_runs; ++r)
+		if (column->run_values[r] < min)
+			min = column->run_values[r];
+
+	__store_keys(column->type, &min, 1, result);
+}
+
+// mark the values whose keys are within [lower, upper]
+static size_t*
+__filter_keys(
+	const struct CompressedColumn* const column,
+	const uint64_t lower,
+	const uint64_t upper)
+{
+	size_t* filtered_idx = dt_aligned_calloc(column->allocator, column->n_values, sizeof(size_t));
+	if (!filtered_idx || lower > upper)
+		return filtered_idx;
+
+	size_t start = 0;
+	switch (column->encoding)
+	{
+		case DT_ENCODING_RLE:
+		{
+			for (size_t r = 0; r < column->n_runs; ++r)
+			{
+				if (column->run_values[r] >= lower && column->run_values[r] <= upper)
+					for (size_t i = 0; i < column->run_lengths[r]; ++i)
+						filtered_idx[start + i] = 1;
+				start += column->run_lengths[r];
+			}
+			break;
+		}
+		case DT_ENCODING_DELTA:
+		case DT_ENCODING_FOR:
+		{
+			uint64_t keys[DT_COMPRESSION_BLOCK_SIZE];
+			for (size_t b = 0; b < column->n_blocks; ++b)
+			{
+				const struct CompressedBlock* const block = &column->blocks[b];
+				size_t* const block_idx = filtered_idx + start;
+				start += block->n_values;
+
+				// no value in the block can match
+				if (block->max < lower || block->min > upper)
+					continue;
+
+				// every value in the block matches
+				if (block->min >= lower && block->max <= upper)
+				{
+					for (size_t i = 0; i < block->n_values; ++i)
+						block_idx[i] = 1;
+					continue;
+				}
+
+				if (column->encoding == DT_ENCODING_FOR)
+				{
+					// compare the packed offsets directly
+					const uint64_t lower_offset = lower > block->reference ? lower - block->reference : 0;
+					const uint64_t upper_offset = upper - block->reference;
+					for (size_t i = 0; i < block->n_values; ++i)
+					{
+						const uint64_t offset = __unpack(block->packed, i, block->bit_width);
+						block_idx[i] = offset >= lower_offset && offset <= upper_offset;
+					}
+				}
+				else
+				{
+					__decode_block(column, block, keys);
+					for (size_t i = 0; i < block->n_values; ++i)
+						block_idx[i] = keys[i] >= lower && keys[i] <= upper;
+				}
+			}
+			break;
+		}
+	}
+
+	return filtered_idx;
+}
+
+size_t*
+dt_compressed_column_filter_equal(
+	const struct CompressedColumn* const column,
+	const void* const value)
+{
+	const uint64_t key = __to_key(column->type, value);
+	return __filter_keys(column, key, key);
+}
+
+size_t*
+dt_compressed_column_filter_range(
+	const struct CompressedColumn* const column,
+	const void* const lower,
+	const void* const upper)
+{
+	return __filter_keys(
+		column,
+		__to_key(column->type, lower),
+		__to_key(column->type, upper));
+}
+
+static double
+__seconds_now(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static const char*
+__encoding_to_str(
+	const enum dt_encoding_e encoding)
+{
+	switch (encoding)
+	{
+		case DT_ENCODING_RLE:
+			return "RLE";
+		case DT_ENCODING_DELTA:
+			return "DELTA";
+		case DT_ENCODING_FOR:
+			return "FOR";
+	}
+
+	return "";
+}
+
+enum status_code_e
+dt_column_compression_report(
+	const struct DataColumn* const column,
+	struct CompressionReport* const reports)
+{
+	if (!__is_integer_type(column->type))
+		return DT_TYPE_MISMATCH;
+
+	void* buffer = dt_aligned_calloc(column->allocator, column->n_values, column->type_size);
+	if (!buffer)
+		return DT_ALLOC_ERROR;
+
+	for (size_t e = 0; e < DT_N_ENCODINGS; ++e)
+	{
+		const enum dt_encoding_e encoding = (enum dt_encoding_e)e;
+
+		double start = __seconds_now();
+		struct CompressedColumn* compressed = dt_column_compress(column, encoding);
+		const double compress_seconds = __seconds_now() - start;
+		if (!compressed)
+		{
+			dt_aligned_free(column->allocator, buffer);
+			return DT_ALLOC_ERROR;
+		}
+
+		start = __seconds_now();
+		dt_compressed_column_decode(compressed, buffer);
+		const double decode_seconds = __seconds_now() - start;
+
+		reports[e].encoding = encoding;
+		reports[e].uncompressed_bytes = column->n_values * column->type_size
+			+ column->n_null_values * sizeof(size_t);
+		reports[e].compressed_bytes = dt_compressed_column_size(compressed);
+		reports[e].ratio = (double)reports[e].uncompressed_bytes / (double)reports[e].compressed_bytes;
+		reports[e].compress_seconds = compress_seconds;
+		reports[e].decode_seconds = decode_seconds;
+
+		dt_compressed_column_free(&compressed);
+	}
+
+	dt_aligned_free(column->allocator, buffer);
+	return DT_SUCCESS;
+}
+
+void
+dt_table_print_compression_report(
+	const struct DataTable* const table,
+	FILE* stream)
+{
+	fprintf(stream, "%-24s %-8s %14s %14s %8s %12s %12s\n",
+		"column", "encoding", "uncompressed", "compressed", "ratio", "compress(s)", "decode(s)");
+
+	for (size_t c = 0; c < table->n_columns; ++c)
+	{
+		struct CompressionReport reports[DT_N_ENCODINGS];
+		const struct DataColumn* column = dt_table_get_column_ptr_by_index(table, c);
+		if (!column || dt_column_compression_report(column, reports) != DT_SUCCESS)
+			continue;
+
+		for (size_t e = 0; e < DT_N_ENCODINGS; ++e)
+			fprintf(stream, "%-24s %-8s %14zu %14zu %8.2f %12.6f %12.6f\n",
+				table->columns[c].name,
+				__encoding_to_str(reports[e].encoding),
+				reports[e].uncompressed_bytes,
+				reports[e].compressed_bytes,
+				reports[e].ratio,
+				reports[e].compress_seconds,
+				reports[e].decode_seconds);
+	}
+}
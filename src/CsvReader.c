@@ -0,0 +1,1200 @@
+#define _POSIX_C_SOURCE 200112L
+#include "CsvReader.h"
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+// vector scanning needs GCC/clang on x86 (SSE2 is always there on x86-64,
+// AVX2 is compiled per function and only used if the CPU has it)
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && defined(__SSE2__)
+#define DT_CSV_HAVE_SIMD
+#include <immintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef DT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef DT_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef DT_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+// inputs that can't be mapped are read in blocks of this many bytes
+#define DT_CSV_READ_BLOCK_SIZE (1024 * 1024)
+
+#define DT_CSV_INITIAL_SPANS 64
+
+// how far dt_csv_speculate_record_start looks for a line break and a telling quote
+#define DT_CSV_SPECULATION_WINDOW (64 * 1024)
+
+// blocks read (and decompressed) ahead of the reader (with pthreads)
+#define DT_CSV_DECODER_BLOCKS 4
+
+// bytes read from a stream to look for a magic number
+#define DT_CSV_MAGIC_SIZE 4
+
+struct __csv_decoded_block
+{
+	char* data;
+	size_t size;
+};
+
+struct dt_csv_decoder
+{
+	FILE* file;
+	enum dt_csv_compression_e compression;
+	const struct dt_allocator* allocator;
+
+	// data read from the file and not decompressed yet (only the magic number
+	// of uncompressed inputs, which are read directly into the blocks)
+	unsigned char* input;
+	size_t input_size;
+	size_t input_position;
+	bool is_input_eof;
+
+	// a gzip member or zstd frame was started but not finished
+	bool is_frame_open;
+
+#ifdef DT_HAVE_ZLIB
+	z_stream zlib;
+	bool is_zlib_init;
+#endif
+#ifdef DT_HAVE_ZSTD
+	ZSTD_DStream* zstd;
+#endif
+
+	enum status_code_e status;
+
+#ifdef DT_HAVE_PTHREADS
+	// ring of blocks: [n_ready] decoded ones from [head] (the next one to be read,
+	// [read_offset] bytes of which were read already)
+	struct __csv_decoded_block blocks[DT_CSV_DECODER_BLOCKS];
+	size_t head;
+	size_t n_ready;
+	size_t read_offset;
+
+	// the decoding thread is done (end of the input or error) or told to stop
+	bool is_done;
+	bool stop;
+
+	pthread_t thread;
+	bool is_thread_started;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+#endif
+};
+
+enum dt_csv_compression_e
+dt_csv_compression_from_data(
+	const void* const data,
+	const size_t size)
+{
+	const unsigned char* const bytes = data;
+	if (size >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b)
+		return DT_CSV_COMPRESSION_GZIP;
+
+	if (size >= 4 && bytes[0] == 0x28 && bytes[1] == 0xb5 && bytes[2] == 0x2f && bytes[3] == 0xfd)
+		return DT_CSV_COMPRESSION_ZSTD;
+
+	return DT_CSV_COMPRESSION_NONE;
+}
+
+enum dt_csv_compression_e
+dt_csv_compression_from_path(
+	const char* const filepath)
+{
+	const size_t length = filepath ? strlen(filepath) : 0;
+	if (length >= 3 && strcmp(filepath + length - 3, ".gz") == 0)
+		return DT_CSV_COMPRESSION_GZIP;
+
+	if (length >= 4 && strcmp(filepath + length - 4, ".zst") == 0)
+		return DT_CSV_COMPRESSION_ZSTD;
+
+	return DT_CSV_COMPRESSION_NONE;
+}
+
+bool
+dt_csv_compression_supported(
+	const enum dt_csv_compression_e compression)
+{
+	switch (compression)
+	{
+		case DT_CSV_COMPRESSION_NONE:
+			return true;
+
+		case DT_CSV_COMPRESSION_GZIP:
+#ifdef DT_HAVE_ZLIB
+			return true;
+#else
+			return false;
+#endif
+
+		case DT_CSV_COMPRESSION_ZSTD:
+#ifdef DT_HAVE_ZSTD
+			return true;
+#else
+			return false;
+#endif
+	}
+
+	return false;
+}
+
+// make sure there's compressed input left unless the file ended.
+// returns DT_FAILURE on a read error
+static enum status_code_e
+__refill_csv_decoder(
+	struct dt_csv_decoder* const decoder)
+{
+	if (decoder->input_position < decoder->input_size || decoder->is_input_eof)
+		return DT_SUCCESS;
+
+	decoder->input_size = fread(decoder->input, 1, DT_CSV_READ_BLOCK_SIZE, decoder->file);
+	decoder->input_position = 0;
+	if (decoder->input_size == 0)
+	{
+		if (ferror(decoder->file))
+			return DT_FAILURE;
+		decoder->is_input_eof = true;
+	}
+
+	return DT_SUCCESS;
+}
+
+#ifdef DT_HAVE_ZLIB
+// decompress gzip members (one after the other) into the [capacity] bytes at [dest]
+static enum status_code_e
+__decode_gzip(
+	struct dt_csv_decoder* const decoder,
+	char* const dest,
+	const size_t capacity,
+	size_t* const n_decoded)
+{
+	z_stream* const zlib = &decoder->zlib;
+	zlib->next_out = (unsigned char*)dest;
+
+	// zlib counts bytes in unsigned ints: past 4GB, it's given at most UINT_MAX at a time
+	size_t n_left = capacity;
+	while (n_left > 0)
+	{
+		if (__refill_csv_decoder(decoder) != DT_SUCCESS)
+			return DT_FAILURE;
+
+		const size_t n_input = decoder->input_size - decoder->input_position;
+		if (n_input == 0 && !decoder->is_frame_open)
+			break;
+
+		const unsigned int n_in = n_input < UINT_MAX ? (unsigned int)n_input : UINT_MAX;
+		const unsigned int n_out = n_left < UINT_MAX ? (unsigned int)n_left : UINT_MAX;
+		zlib->next_in = decoder->input + decoder->input_position;
+		zlib->avail_in = n_in;
+		zlib->avail_out = n_out;
+		const int result = inflate(zlib, Z_NO_FLUSH);
+		decoder->input_position += n_in - zlib->avail_in;
+		n_left -= n_out - zlib->avail_out;
+
+		if (result == Z_STREAM_END)
+		{
+			decoder->is_frame_open = false;
+			if (inflateReset(zlib) != Z_OK)
+				return DT_FAILURE;
+		}
+		else if (result == Z_OK)
+			decoder->is_frame_open = true;
+		// corrupt, or a member cut short (no progress at the end of the input)
+		else
+			return DT_FAILURE;
+	}
+
+	*n_decoded = capacity - n_left;
+	return DT_SUCCESS;
+}
+#endif
+
+#ifdef DT_HAVE_ZSTD
+// decompress zstd frames (one after the other) into the [capacity] bytes at [dest]
+static enum status_code_e
+__decode_zstd(
+	struct dt_csv_decoder* const decoder,
+	char* const dest,
+	const size_t capacity,
+	size_t* const n_decoded)
+{
+	ZSTD_outBuffer output = { dest, capacity, 0 };
+
+	while (output.pos < output.size)
+	{
+		if (__refill_csv_decoder(decoder) != DT_SUCCESS)
+			return DT_FAILURE;
+
+		const bool is_input_left = decoder->input_position < decoder->input_size;
+		if (!is_input_left && !decoder->is_frame_open)
+			break;
+
+		ZSTD_inBuffer input = { decoder->input, decoder->input_size, decoder->input_position };
+		const size_t previous_pos = output.pos;
+		const size_t result = ZSTD_decompressStream(decoder->zstd, &output, &input);
+		decoder->input_position = input.pos;
+		if (ZSTD_isError(result))
+			return DT_FAILURE;
+
+		decoder->is_frame_open = result != 0;
+
+		// a frame cut short
+		if (decoder->is_frame_open && !is_input_left && decoder->is_input_eof && output.pos == previous_pos)
+			return DT_FAILURE;
+	}
+
+	*n_decoded = output.pos;
+	return DT_SUCCESS;
+}
+#endif
+
+// read the rest of an uncompressed input into the [capacity] bytes at [dest]
+static enum status_code_e
+__decode_plain(
+	struct dt_csv_decoder* const decoder,
+	char* const dest,
+	const size_t capacity,
+	size_t* const n_decoded)
+{
+	size_t n_copied = decoder->input_size - decoder->input_position;
+	if (n_copied > capacity)
+		n_copied = capacity;
+	memcpy(dest, decoder->input + decoder->input_position, n_copied);
+	decoder->input_position += n_copied;
+
+	const size_t n_read = fread(dest + n_copied, 1, capacity - n_copied, decoder->file);
+	if (n_copied + n_read < capacity && ferror(decoder->file))
+		return DT_FAILURE;
+
+	*n_decoded = n_copied + n_read;
+	return DT_SUCCESS;
+}
+
+// read (and decompress) the next (up to) [capacity] bytes into [dest] on the calling thread.
+// [*n_decoded] is less than [capacity] only at the end of the input.
+static enum status_code_e
+__decode_csv_block(
+	struct dt_csv_decoder* const decoder,
+	char* const dest,
+	const size_t capacity,
+	size_t* const n_decoded)
+{
+	*n_decoded = 0;
+	switch (decoder->compression)
+	{
+		case DT_CSV_COMPRESSION_NONE:
+			return __decode_plain(decoder, dest, capacity, n_decoded);
+
+		case DT_CSV_COMPRESSION_GZIP:
+#ifdef DT_HAVE_ZLIB
+			return __decode_gzip(decoder, dest, capacity, n_decoded);
+#else
+			break;
+#endif
+
+		case DT_CSV_COMPRESSION_ZSTD:
+#ifdef DT_HAVE_ZSTD
+			return __decode_zstd(decoder, dest, capacity, n_decoded);
+#else
+			break;
+#endif
+	}
+
+	return DT_FAILURE;
+}
+
+#ifdef DT_HAVE_PTHREADS
+// read-ahead thread: fill the free blocks of the ring until the end of the input (or an error)
+static void*
+__run_csv_decoder(
+	void* arg)
+{
+	struct dt_csv_decoder* decoder = arg;
+	while (true)
+	{
+		pthread_mutex_lock(&decoder->mutex);
+		while (decoder->n_ready == DT_CSV_DECODER_BLOCKS && !decoder->stop)
+			pthread_cond_wait(&decoder->cond, &decoder->mutex);
+		const bool stop = decoder->stop;
+		const size_t slot = (decoder->head + decoder->n_ready) % DT_CSV_DECODER_BLOCKS;
+		pthread_mutex_unlock(&decoder->mutex);
+
+		if (stop)
+			break;
+
+		size_t n_decoded = 0;
+		struct __csv_decoded_block* block = &decoder->blocks[slot];
+		const enum status_code_e status = __decode_csv_block(decoder, block->data, DT_CSV_READ_BLOCK_SIZE, &n_decoded);
+
+		pthread_mutex_lock(&decoder->mutex);
+		block->size = n_decoded;
+		decoder->status = status;
+		if (n_decoded > 0)
+			decoder->n_ready++;
+		decoder->is_done = status != DT_SUCCESS || n_decoded < DT_CSV_READ_BLOCK_SIZE;
+		const bool is_done = decoder->is_done;
+		pthread_cond_broadcast(&decoder->cond);
+		pthread_mutex_unlock(&decoder->mutex);
+
+		if (is_done)
+			break;
+	}
+
+	return NULL;
+}
+#endif
+
+static void
+__free_csv_decoder(
+	struct dt_csv_decoder* decoder)
+{
+	const struct dt_allocator* const allocator = decoder->allocator;
+
+#ifdef DT_HAVE_PTHREADS
+	if (decoder->is_thread_started)
+	{
+		pthread_mutex_lock(&decoder->mutex);
+		decoder->stop = true;
+		pthread_cond_broadcast(&decoder->cond);
+		pthread_mutex_unlock(&decoder->mutex);
+		pthread_join(decoder->thread, NULL);
+	}
+	pthread_mutex_destroy(&decoder->mutex);
+	pthread_cond_destroy(&decoder->cond);
+
+	for (size_t i = 0; i < DT_CSV_DECODER_BLOCKS; ++i)
+		dt_free(allocator, decoder->blocks[i].data);
+#endif
+
+#ifdef DT_HAVE_ZLIB
+	if (decoder->is_zlib_init)
+		inflateEnd(&decoder->zlib);
+#endif
+#ifdef DT_HAVE_ZSTD
+	ZSTD_freeDStream(decoder->zstd);
+#endif
+
+	dt_free(allocator, decoder->input);
+	dt_free(allocator, decoder);
+}
+
+// read (and decompress) [file] (compressed with [compression], whose first [n_read] bytes
+// were already read into [head]) ahead of the reader, on its own thread if possible.
+// returns NULL on failure
+static struct dt_csv_decoder*
+__create_csv_decoder(
+	FILE* const file,
+	const enum dt_csv_compression_e compression,
+	const unsigned char* const head,
+	const size_t n_read,
+	const struct dt_allocator* const allocator)
+{
+	struct dt_csv_decoder* decoder = dt_calloc(allocator, 1, sizeof(*decoder));
+	if (!decoder)
+		return NULL;
+
+	decoder->file = file;
+	decoder->compression = compression;
+	decoder->allocator = allocator;
+	decoder->status = DT_SUCCESS;
+
+#ifdef DT_HAVE_PTHREADS
+	pthread_mutex_init(&decoder->mutex, NULL);
+	pthread_cond_init(&decoder->cond, NULL);
+#endif
+
+	decoder->input = dt_alloc(allocator, compression == DT_CSV_COMPRESSION_NONE ? DT_CSV_MAGIC_SIZE : DT_CSV_READ_BLOCK_SIZE);
+	if (!decoder->input)
+	{
+		__free_csv_decoder(decoder);
+		return NULL;
+	}
+	memcpy(decoder->input, head, n_read);
+	decoder->input_size = n_read;
+
+	bool is_init = false;
+	switch (compression)
+	{
+		case DT_CSV_COMPRESSION_NONE:
+			is_init = true;
+			break;
+
+		case DT_CSV_COMPRESSION_GZIP:
+#ifdef DT_HAVE_ZLIB
+			// gzip header only (+16)
+			decoder->is_zlib_init = inflateInit2(&decoder->zlib, MAX_WBITS + 16) == Z_OK;
+			is_init = decoder->is_zlib_init;
+#endif
+			break;
+
+		case DT_CSV_COMPRESSION_ZSTD:
+#ifdef DT_HAVE_ZSTD
+			decoder->zstd = ZSTD_createDStream();
+			is_init = decoder->zstd && !ZSTD_isError(ZSTD_initDStream(decoder->zstd));
+#endif
+			break;
+	}
+
+	if (!is_init)
+	{
+		__free_csv_decoder(decoder);
+		return NULL;
+	}
+
+#ifdef DT_HAVE_PTHREADS
+	bool has_blocks = true;
+	for (size_t i = 0; i < DT_CSV_DECODER_BLOCKS; ++i)
+		has_blocks = has_blocks && (decoder->blocks[i].data = dt_alloc(allocator, DT_CSV_READ_BLOCK_SIZE));
+
+	// read on the reading thread otherwise
+	if (has_blocks)
+		decoder->is_thread_started = pthread_create(&decoder->thread, NULL, &__run_csv_decoder, decoder) == 0;
+#endif
+
+	return decoder;
+}
+
+// read the next (up to) [capacity] (decompressed) bytes into [dest].
+// [*n_read] is 0 at the end of the input
+static enum status_code_e
+__read_csv_decoder(
+	struct dt_csv_decoder* const decoder,
+	char* const dest,
+	const size_t capacity,
+	size_t* const n_read)
+{
+#ifdef DT_HAVE_PTHREADS
+	if (decoder->is_thread_started)
+	{
+		pthread_mutex_lock(&decoder->mutex);
+		while (decoder->n_ready == 0 && !decoder->is_done)
+			pthread_cond_wait(&decoder->cond, &decoder->mutex);
+		const size_t n_ready = decoder->n_ready;
+		const enum status_code_e status = decoder->status;
+		pthread_mutex_unlock(&decoder->mutex);
+
+		// blocks decoded before an error are still read
+		*n_read = 0;
+		if (n_ready == 0)
+			return status;
+
+		const struct __csv_decoded_block* block = &decoder->blocks[decoder->head];
+		size_t n_copied = block->size - decoder->read_offset;
+		if (n_copied > capacity)
+			n_copied = capacity;
+		memcpy(dest, block->data + decoder->read_offset, n_copied);
+		decoder->read_offset += n_copied;
+		*n_read = n_copied;
+
+		if (decoder->read_offset == block->size)
+		{
+			pthread_mutex_lock(&decoder->mutex);
+			decoder->head = (decoder->head + 1) % DT_CSV_DECODER_BLOCKS;
+			decoder->n_ready--;
+			decoder->read_offset = 0;
+			pthread_cond_broadcast(&decoder->cond);
+			pthread_mutex_unlock(&decoder->mutex);
+		}
+
+		return DT_SUCCESS;
+	}
+#endif
+
+	return __decode_csv_block(decoder, dest, capacity, n_read);
+}
+
+#ifndef _WIN32
+// map regular, non-empty files. returns false if the file should be read instead.
+static bool
+__map_file(
+	const char* const filepath,
+	struct dt_csv_source* const source)
+{
+	const int fd = open(filepath, O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || file_stat.st_size <= 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	void* data = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping stays valid after closing the descriptor
+	close(fd);
+	if (data == MAP_FAILED)
+		return false;
+
+	// records are tokenized front to back
+	posix_madvise(data, (size_t)file_stat.st_size, POSIX_MADV_SEQUENTIAL);
+
+	source->data = data;
+	source->size = (size_t)file_stat.st_size;
+	source->is_mapped = true;
+	return true;
+}
+#endif
+
+// read the whole (decompressed) input of [filepath] into a buffer of [source]
+static enum status_code_e
+__read_file(
+	const char* const filepath,
+	struct dt_csv_source* const source)
+{
+	struct dt_csv_stream stream;
+	enum status_code_e status = dt_csv_stream_open(filepath, &stream);
+	while (status == DT_SUCCESS && !stream.is_eof)
+		status = dt_csv_stream_read(&stream, 0);
+
+	if (status == DT_SUCCESS)
+	{
+		// the window becomes the source
+		*source = stream.window;
+		stream.window.data = NULL;
+	}
+
+	dt_csv_stream_close(&stream);
+	return status;
+}
+
+enum status_code_e
+dt_csv_source_open(
+	const char* const filepath,
+	struct dt_csv_source* const source)
+{
+	source->data = NULL;
+	source->size = 0;
+	source->is_mapped = false;
+	source->allocator = dt_get_default_allocator();
+
+#ifndef _WIN32
+	if (__map_file(filepath, source))
+	{
+		if (dt_csv_compression_from_data(source->data, source->size) == DT_CSV_COMPRESSION_NONE)
+			return DT_SUCCESS;
+
+		// decompressed into memory instead
+		dt_csv_source_close(source);
+	}
+#endif
+
+	// compressed files, pipes, empty files and platforms without mmap
+	return __read_file(filepath, source);
+}
+
+void
+dt_csv_source_close(
+	struct dt_csv_source* const source)
+{
+#ifndef _WIN32
+	if (source->is_mapped)
+		munmap((void*)source->data, source->size);
+	else
+#endif
+		dt_free(source->allocator, (void*)source->data);
+
+	source->data = NULL;
+	source->size = 0;
+	source->is_mapped = false;
+}
+
+enum status_code_e
+dt_csv_stream_open(
+	const char* const filepath,
+	struct dt_csv_stream* const stream)
+{
+	stream->window.data = NULL;
+	stream->window.size = 0;
+	stream->window.is_mapped = false;
+	stream->window.allocator = dt_get_default_allocator();
+	stream->capacity = 0;
+	stream->is_eof = false;
+	stream->compression = DT_CSV_COMPRESSION_NONE;
+	stream->decoder = NULL;
+
+	stream->owns_file = filepath && strcmp(filepath, "-") != 0;
+	stream->file = stream->owns_file ? fopen(filepath, "rb") : stdin;
+	if (!stream->file)
+		return DT_FAILURE;
+
+#ifndef _WIN32
+	// larger kernel read-ahead (fails harmlessly on pipes)
+	posix_fadvise(fileno(stream->file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+	// the magic number tells whether the input is compressed (pipes can't be rewound)
+	unsigned char head[DT_CSV_MAGIC_SIZE];
+	const size_t n_read = fread(head, 1, sizeof(head), stream->file);
+	if (ferror(stream->file))
+		return DT_FAILURE;
+
+	stream->compression = dt_csv_compression_from_data(head, n_read);
+	if (!dt_csv_compression_supported(stream->compression))
+		return DT_FAILURE;
+
+	// the input is read on another thread while the window is parsed
+	stream->decoder = __create_csv_decoder(stream->file, stream->compression, head, n_read, stream->window.allocator);
+	return stream->decoder ? DT_SUCCESS : DT_ALLOC_ERROR;
+}
+
+enum status_code_e
+dt_csv_stream_read(
+	struct dt_csv_stream* const stream,
+	const size_t consumed)
+{
+	char* data = (char*)stream->window.data;
+	if (consumed > 0)
+	{
+		memmove(data, data + consumed, stream->window.size - consumed);
+		stream->window.size -= consumed;
+	}
+
+	if (stream->is_eof)
+		return DT_SUCCESS;
+
+	if (stream->capacity - stream->window.size < DT_CSV_READ_BLOCK_SIZE / 2)
+	{
+		const size_t new_capacity = stream->capacity == 0 ? DT_CSV_READ_BLOCK_SIZE : stream->capacity * 2;
+		data = dt_realloc(stream->window.allocator, data, stream->capacity, new_capacity);
+		if (!data)
+			return DT_ALLOC_ERROR;
+
+		stream->window.data = data;
+		stream->capacity = new_capacity;
+	}
+
+	size_t n_read = 0;
+	const enum status_code_e status = __read_csv_decoder(stream->decoder, data + stream->window.size,
+		stream->capacity - stream->window.size, &n_read);
+	if (status != DT_SUCCESS)
+		return status;
+
+	stream->window.size += n_read;
+	stream->is_eof = n_read == 0;
+	return DT_SUCCESS;
+}
+
+void
+dt_csv_stream_close(
+	struct dt_csv_stream* const stream)
+{
+	// stops the decoding thread before the file is closed
+	if (stream->decoder)
+		__free_csv_decoder(stream->decoder);
+	stream->decoder = NULL;
+
+	if (stream->file && stream->owns_file)
+		fclose(stream->file);
+	stream->file = NULL;
+
+	dt_free(stream->window.allocator, (void*)stream->window.data);
+	stream->window.data = NULL;
+	stream->window.size = 0;
+	stream->capacity = 0;
+}
+
+void
+dt_csv_record_init(
+	struct dt_csv_record* const record,
+	const struct dt_allocator* const allocator)
+{
+	record->spans = NULL;
+	record->n_spans = 0;
+	record->capacity = 0;
+	record->allocator = allocator;
+	record->simd = dt_csv_detect_simd();
+	record->block_data = NULL;
+	record->block_offset = 0;
+	record->block_delim = 0;
+}
+
+void
+dt_csv_record_free(
+	struct dt_csv_record* const record)
+{
+	dt_free(record->allocator, record->spans);
+	record->spans = NULL;
+	record->n_spans = 0;
+	record->capacity = 0;
+}
+
+static enum status_code_e
+__push_span(
+	struct dt_csv_record* const record,
+	const size_t offset,
+	const size_t length,
+	const bool is_quoted)
+{
+	if (record->n_spans == record->capacity)
+	{
+		const size_t new_capacity = record->capacity == 0 ? DT_CSV_INITIAL_SPANS : record->capacity * 2;
+		struct dt_csv_span* spans = dt_realloc(
+				record->allocator,
+				record->spans,
+				record->capacity * sizeof(*spans),
+				new_capacity * sizeof(*spans));
+		if (!spans)
+			return DT_ALLOC_ERROR;
+		record->spans = spans;
+		record->capacity = new_capacity;
+	}
+
+	struct dt_csv_span* span = &record->spans[record->n_spans++];
+	span->offset = offset;
+	span->length = length;
+	span->is_quoted = is_quoted;
+	return DT_SUCCESS;
+}
+
+// move past a \n, \r\n or \r at [position]
+static size_t
+__skip_line_ending(
+	const char* const data,
+	const size_t size,
+	size_t position)
+{
+	if (position < size && data[position] == '\r')
+		position++;
+	if (position < size && data[position] == '\n')
+		position++;
+	return position;
+}
+
+// one character at a time; handles every kind of quoting
+static enum status_code_e
+__tokenize_record_scalar(
+	const char* const data,
+	const size_t size,
+	const char delim,
+	size_t* const position,
+	struct dt_csv_record* const record)
+{
+	size_t current = *position;
+
+	while (true)
+	{
+		const size_t start = current;
+		const bool is_quoted = current < size && data[current] == '\"';
+
+		// RFC-4180 quoted section: runs to the first quote that isn't doubled
+		if (is_quoted)
+		{
+			current++;
+			while (current < size)
+			{
+				if (data[current] == '\"')
+				{
+					if (current + 1 < size && data[current + 1] == '\"')
+					{
+						current += 2;
+						continue;
+					}
+					current++;
+					break;
+				}
+				current++;
+			}
+		}
+
+		// unquoted field (or whatever follows a closing quote)
+		char quote_char = 0;
+		while (current < size)
+		{
+			const char c = data[current];
+			if (c == '\n' || c == '\r')
+				break;
+
+			if (quote_char)
+			{
+				if (c == quote_char)
+					quote_char = 0;
+			}
+			else if (c == delim)
+				break;
+			else if (c == '\"' || c == '\'')
+				quote_char = c;
+
+			current++;
+		}
+
+		if (__push_span(record, start, current - start, is_quoted) != DT_SUCCESS)
+			return DT_ALLOC_ERROR;
+
+		// a delimiter at the very end of the data is followed by an empty field
+		if (current < size && data[current] == delim)
+		{
+			current++;
+			continue;
+		}
+
+		*position = __skip_line_ending(data, size, current);
+		return DT_SUCCESS;
+	}
+}
+
+enum dt_csv_simd_e
+dt_csv_detect_simd(void)
+{
+#ifdef DT_CSV_HAVE_SIMD
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return DT_CSV_SIMD_AVX2;
+	return DT_CSV_SIMD_SSE2;
+#else
+	return DT_CSV_SIMD_NONE;
+#endif
+}
+
+#ifdef DT_CSV_HAVE_SIMD
+// indices into dt_csv_record.block_masks (bit i is set if byte i of the block is one)
+#define DT_CSV_MASK_DELIM 0
+#define DT_CSV_MASK_QUOTE 1
+#define DT_CSV_MASK_APOSTROPHE 2
+#define DT_CSV_MASK_LINE_BREAK 3
+
+static void
+__classify_block_sse2(
+	const char* const block,
+	const char delim,
+	uint64_t* const masks)
+{
+	const __m128i delims = _mm_set1_epi8(delim);
+	const __m128i quotes = _mm_set1_epi8('\"');
+	const __m128i apostrophes = _mm_set1_epi8('\'');
+	const __m128i newlines = _mm_set1_epi8('\n');
+	const __m128i returns = _mm_set1_epi8('\r');
+
+	for (size_t i = 0; i < 4; ++i)
+		masks[i] = 0;
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		const __m128i chars = _mm_loadu_si128((const __m128i*)(block + i * 16));
+		const size_t shift = i * 16;
+		masks[DT_CSV_MASK_DELIM] |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, delims)) << shift;
+		masks[DT_CSV_MASK_QUOTE] |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, quotes)) << shift;
+		masks[DT_CSV_MASK_APOSTROPHE] |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, apostrophes)) << shift;
+		masks[DT_CSV_MASK_LINE_BREAK] |= (uint64_t)(uint16_t)_mm_movemask_epi8(
+				_mm_or_si128(_mm_cmpeq_epi8(chars, newlines), _mm_cmpeq_epi8(chars, returns))) << shift;
+	}
+}
+
+__attribute__((target("avx2")))
+static void
+__classify_block_avx2(
+	const char* const block,
+	const char delim,
+	uint64_t* const masks)
+{
+	const __m256i delims = _mm256_set1_epi8(delim);
+	const __m256i quotes = _mm256_set1_epi8('\"');
+	const __m256i apostrophes = _mm256_set1_epi8('\'');
+	const __m256i newlines = _mm256_set1_epi8('\n');
+	const __m256i returns = _mm256_set1_epi8('\r');
+
+	for (size_t i = 0; i < 4; ++i)
+		masks[i] = 0;
+
+	for (size_t i = 0; i < 2; ++i)
+	{
+		const __m256i chars = _mm256_loadu_si256((const __m256i*)(block + i * 32));
+		const size_t shift = i * 32;
+		masks[DT_CSV_MASK_DELIM] |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, delims)) << shift;
+		masks[DT_CSV_MASK_QUOTE] |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, quotes)) << shift;
+		masks[DT_CSV_MASK_APOSTROPHE] |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, apostrophes)) << shift;
+		masks[DT_CSV_MASK_LINE_BREAK] |= (uint64_t)(uint32_t)_mm256_movemask_epi8(
+				_mm256_or_si256(_mm256_cmpeq_epi8(chars, newlines), _mm256_cmpeq_epi8(chars, returns))) << shift;
+	}
+}
+
+// classes of the 64 bytes starting at [block_offset] (zero past the end of [data])
+static const uint64_t*
+__block_masks(
+	const char* const data,
+	const size_t size,
+	const char delim,
+	const size_t block_offset,
+	struct dt_csv_record* const record)
+{
+	if (record->block_data == data && record->block_offset == block_offset && record->block_delim == delim)
+		return record->block_masks;
+
+	const char* block = data + block_offset;
+	char tail[64];
+	if (size - block_offset < 64)
+	{
+		memset(tail, 0, sizeof(tail));
+		memcpy(tail, block, size - block_offset);
+		block = tail;
+	}
+
+	switch (record->simd)
+	{
+		case DT_CSV_SIMD_AVX2:
+			__classify_block_avx2(block, delim, record->block_masks);
+			break;
+		case DT_CSV_SIMD_SSE2:
+		case DT_CSV_SIMD_NONE:
+			__classify_block_sse2(block, delim, record->block_masks);
+			break;
+	}
+
+	record->block_data = data;
+	record->block_offset = block_offset;
+	record->block_delim = delim;
+	return record->block_masks;
+}
+
+// bit i of the result is the XOR of bits 0 ... i of [mask]: with [mask] marking quotes,
+// every byte from an opening quote up to (not including) its closing quote is set
+static uint64_t
+__prefix_xor(
+	uint64_t mask)
+{
+	mask ^= mask << 1;
+	mask ^= mask << 2;
+	mask ^= mask << 4;
+	mask ^= mask << 8;
+	mask ^= mask << 16;
+	mask ^= mask << 32;
+	return mask;
+}
+
+// tokenize a record 64 bytes at a time on a grid of blocks shared by every record.
+// returns DT_FAILURE (leaving [*position] as is) if the record has a quote that doesn't
+// start a field, end one or escape another, or an apostrophe outside quotes: those
+// follow the compatibility rules only the scalar tokenizer implements.
+static enum status_code_e
+__tokenize_record_blocks(
+	const char* const data,
+	const size_t size,
+	const char delim,
+	size_t* const position,
+	struct dt_csv_record* const record)
+{
+	size_t field_start = *position;
+	size_t block_offset = *position & ~(size_t)63;
+
+	// bits before the record in its first block are ignored
+	const size_t first_bit = *position & 63;
+	uint64_t ignored = ((uint64_t)1 << first_bit) - 1;
+
+	// state carried from the previous block
+	uint64_t inside_carry = 0;
+	uint64_t field_start_carry = (uint64_t)1 << first_bit;
+	uint64_t closing_carry = 0;
+
+	while (block_offset < size)
+	{
+		const uint64_t* masks = __block_masks(data, size, delim, block_offset, record);
+
+		const size_t n_valid = size - block_offset;
+		const uint64_t valid = (n_valid < 64 ? ((uint64_t)1 << n_valid) - 1 : ~(uint64_t)0) & ~ignored;
+
+		const uint64_t quotes = masks[DT_CSV_MASK_QUOTE] & valid;
+		const uint64_t inside = __prefix_xor(quotes) ^ inside_carry;
+		const uint64_t opening = quotes & inside;
+		const uint64_t closing = quotes & ~inside;
+		const uint64_t line_breaks = masks[DT_CSV_MASK_LINE_BREAK] & valid & ~inside;
+		const uint64_t edges = (masks[DT_CSV_MASK_DELIM] & valid & ~inside) | line_breaks;
+
+		// everything up to the first line break belongs to the record
+		uint64_t in_record = valid;
+		if (line_breaks)
+		{
+			const uint64_t first_line_break = line_breaks & (0 - line_breaks);
+			in_record &= first_line_break | (first_line_break - 1);
+		}
+
+		const uint64_t field_starts = (edges << 1) | field_start_carry;
+		const uint64_t escapes = (closing << 1) | closing_carry;
+		if ((opening & ~(field_starts | escapes) & in_record)
+				|| (masks[DT_CSV_MASK_APOSTROPHE] & ~inside & in_record))
+			return DT_FAILURE;
+
+		uint64_t record_edges = edges & in_record;
+		while (record_edges)
+		{
+			const size_t edge = block_offset + (size_t)__builtin_ctzll(record_edges);
+			if (__push_span(record, field_start, edge - field_start, data[field_start] == '\"') != DT_SUCCESS)
+				return DT_ALLOC_ERROR;
+
+			if (data[edge] != delim)
+			{
+				*position = __skip_line_ending(data, size, edge);
+				return DT_SUCCESS;
+			}
+
+			field_start = edge + 1;
+			record_edges &= record_edges - 1;
+		}
+
+		inside_carry = 0 - (inside >> 63);
+		field_start_carry = edges >> 63;
+		closing_carry = closing >> 63;
+		ignored = 0;
+		block_offset += 64;
+	}
+
+	// the data ends without a line break
+	const bool is_quoted = field_start < size && data[field_start] == '\"';
+	if (__push_span(record, field_start, size - field_start, is_quoted) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	*position = size;
+	return DT_SUCCESS;
+}
+#endif
+
+enum status_code_e
+dt_csv_tokenize_record(
+	const char* const data,
+	const size_t size,
+	const char delim,
+	size_t* const position,
+	struct dt_csv_record* const record)
+{
+	const size_t current = *position;
+	record->n_spans = 0;
+
+	if (current >= size || data[current] == '\n' || data[current] == '\r')
+	{
+		*position = __skip_line_ending(data, size, current);
+		return DT_SUCCESS;
+	}
+
+#ifdef DT_CSV_HAVE_SIMD
+	// the masks can't tell a delimiter apart from the characters it would collide with
+	const bool is_plain_delim = delim != '\"' && delim != '\'' && delim != '\n' && delim != '\r' && delim != '\0';
+	if (record->simd != DT_CSV_SIMD_NONE && is_plain_delim)
+	{
+		const enum status_code_e status = __tokenize_record_blocks(data, size, delim, position, record);
+		if (status != DT_FAILURE)
+			return status;
+		record->n_spans = 0;
+	}
+#endif
+
+	return __tokenize_record_scalar(data, size, delim, position, record);
+}
+
+size_t
+dt_csv_span_copy(
+	const char* const data,
+	const struct dt_csv_span* const span,
+	char* const dest)
+{
+	const char* const field = data + span->offset;
+
+	if (!span->is_quoted)
+	{
+		memcpy(dest, field, span->length);
+		dest[span->length] = '\0';
+		return span->length;
+	}
+
+	size_t length = 0;
+	size_t i = 1;
+	while (i < span->length)
+	{
+		if (field[i] == '\"')
+		{
+			if (i + 1 < span->length && field[i + 1] == '\"')
+			{
+				dest[length++] = '\"';
+				i += 2;
+				continue;
+			}
+
+			// closing quote: anything after it is kept as is
+			i++;
+			break;
+		}
+		dest[length++] = field[i++];
+	}
+
+	memcpy(dest + length, field + i, span->length - i);
+	length += span->length - i;
+	dest[length] = '\0';
+	return length;
+}
+
+static bool
+__is_field_edge(
+	const char c,
+	const char delim)
+{
+	return c == delim || c == '\n' || c == '\r';
+}
+
+size_t
+dt_csv_speculate_record_start(
+	const char* const data,
+	const size_t size,
+	const char delim,
+	const size_t offset)
+{
+	if (offset == 0 || offset >= size)
+		return offset;
+
+	const size_t limit = size - offset < DT_CSV_SPECULATION_WINDOW ? size : offset + DT_CSV_SPECULATION_WINDOW;
+
+	// quote parity since [offset], and the first line break seen with each parity.
+	// a line break seen with parity p ends a record if [offset] was inside quotes exactly when p is.
+	bool odd_quotes = false;
+	size_t first_line_break[2] = { size, size };
+
+	bool decided = false;
+	bool starts_inside = false;
+
+	for (size_t i = offset; i < limit; ++i)
+	{
+		const char c = data[i];
+		if (c == '\"')
+		{
+			// a doubled quote is either escaped or an empty field; both leave the parity as is
+			// and neither tells anything
+			if (i + 1 < limit && data[i + 1] == '\"')
+			{
+				i++;
+				continue;
+			}
+
+			if (!decided)
+			{
+				const bool can_open = __is_field_edge(data[i - 1], delim);
+				const bool can_close = i + 1 == size || __is_field_edge(data[i + 1], delim);
+				if (can_open != can_close)
+				{
+					// an opening quote is outside quotes, a closing one inside
+					starts_inside = can_open ? odd_quotes : !odd_quotes;
+					decided = true;
+				}
+			}
+			odd_quotes = !odd_quotes;
+		}
+		else if ((c == '\n' || c == '\r') && first_line_break[odd_quotes] == size)
+			first_line_break[odd_quotes] = i;
+
+		if (decided && first_line_break[starts_inside] != size)
+			break;
+	}
+
+	const size_t line_break = first_line_break[decided && starts_inside];
+	return __skip_line_ending(data, size, line_break);
+}
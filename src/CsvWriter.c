@@ -0,0 +1,310 @@
+#define _POSIX_C_SOURCE 200112L
+#include "CsvWriter.h"
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#ifdef DT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef DT_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+// compressed data is written to the file in blocks of this many bytes
+#define DT_CSV_WRITE_BLOCK_SIZE (1024 * 1024)
+
+// zstd's default level: faster than gzip -6 and still smaller
+#define DT_CSV_ZSTD_LEVEL 3
+
+struct dt_csv_encoder
+{
+	const struct dt_allocator* allocator;
+
+	// compressed data not written to the file yet
+	unsigned char* buffer;
+
+#ifdef DT_HAVE_ZLIB
+	z_stream zlib;
+	bool is_zlib_init;
+#endif
+#ifdef DT_HAVE_ZSTD
+	ZSTD_CStream* zstd;
+#endif
+};
+
+static void
+__free_csv_encoder(
+	struct dt_csv_encoder* encoder)
+{
+#ifdef DT_HAVE_ZLIB
+	if (encoder->is_zlib_init)
+		deflateEnd(&encoder->zlib);
+#endif
+#ifdef DT_HAVE_ZSTD
+	ZSTD_freeCStream(encoder->zstd);
+#endif
+
+	dt_free(encoder->allocator, encoder->buffer);
+	dt_free(encoder->allocator, encoder);
+}
+
+static struct dt_csv_encoder*
+__create_csv_encoder(
+	const enum dt_csv_compression_e compression,
+	const struct dt_allocator* const allocator)
+{
+	struct dt_csv_encoder* encoder = dt_calloc(allocator, 1, sizeof(*encoder));
+	if (!encoder)
+		return NULL;
+
+	encoder->allocator = allocator;
+	encoder->buffer = dt_alloc(allocator, DT_CSV_WRITE_BLOCK_SIZE);
+
+	bool is_init = false;
+	switch (compression)
+	{
+		case DT_CSV_COMPRESSION_NONE:
+			break;
+
+		case DT_CSV_COMPRESSION_GZIP:
+#ifdef DT_HAVE_ZLIB
+			// gzip header and trailer (+16)
+			encoder->is_zlib_init = deflateInit2(&encoder->zlib, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+				MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+			is_init = encoder->is_zlib_init;
+#endif
+			break;
+
+		case DT_CSV_COMPRESSION_ZSTD:
+#ifdef DT_HAVE_ZSTD
+			encoder->zstd = ZSTD_createCStream();
+			is_init = encoder->zstd
+				&& !ZSTD_isError(ZSTD_CCtx_setParameter(encoder->zstd, ZSTD_c_compressionLevel, DT_CSV_ZSTD_LEVEL));
+#endif
+			break;
+	}
+
+	if (!encoder->buffer || !is_init)
+	{
+		__free_csv_encoder(encoder);
+		return NULL;
+	}
+
+	return encoder;
+}
+
+// how far the data given to the encoder must be written out
+enum __csv_encode_e
+{
+	// whenever the compressor emits it
+	DT_CSV_ENCODE_CONTINUE,
+	// all of it, decompressible without what follows
+	DT_CSV_ENCODE_FLUSH,
+	// all of it, ending the gzip member or zstd frame
+	DT_CSV_ENCODE_END
+};
+
+#ifdef DT_HAVE_ZLIB
+// compress [size] bytes at [data] into the file
+static enum status_code_e
+__encode_gzip(
+	struct dt_csv_output* const output,
+	const void* const data,
+	const size_t size,
+	const enum __csv_encode_e mode)
+{
+	const int flush = mode == DT_CSV_ENCODE_END ? Z_FINISH
+		: mode == DT_CSV_ENCODE_FLUSH ? Z_SYNC_FLUSH
+		: Z_NO_FLUSH;
+
+	struct dt_csv_encoder* const encoder = output->encoder;
+	z_stream* const zlib = &encoder->zlib;
+	zlib->next_in = (unsigned char*)data;
+
+	// zlib counts bytes in unsigned ints: past 4GB, it's given at most UINT_MAX at a time
+	// (and only flushes with the last of them)
+	size_t n_left = size;
+	while (true)
+	{
+		const bool is_last = n_left <= UINT_MAX;
+		zlib->avail_in = is_last ? (unsigned int)n_left : UINT_MAX;
+		n_left -= zlib->avail_in;
+
+		zlib->next_out = encoder->buffer;
+		zlib->avail_out = DT_CSV_WRITE_BLOCK_SIZE;
+		const int result = deflate(zlib, is_last ? flush : Z_NO_FLUSH);
+		n_left += zlib->avail_in;
+		if (result == Z_STREAM_ERROR)
+			return DT_FAILURE;
+
+		const size_t n_compressed = DT_CSV_WRITE_BLOCK_SIZE - zlib->avail_out;
+		if (fwrite(encoder->buffer, 1, n_compressed, output->file) < n_compressed)
+			return DT_FAILURE;
+
+		// everything was consumed (and flushed, or the trailer written) once the buffer isn't filled
+		if (is_last && (mode == DT_CSV_ENCODE_END ? result == Z_STREAM_END : zlib->avail_out > 0))
+			return DT_SUCCESS;
+	}
+}
+#endif
+
+#ifdef DT_HAVE_ZSTD
+// compress [size] bytes at [data] into the file
+static enum status_code_e
+__encode_zstd(
+	struct dt_csv_output* const output,
+	const void* const data,
+	const size_t size,
+	const enum __csv_encode_e mode)
+{
+	const ZSTD_EndDirective directive = mode == DT_CSV_ENCODE_END ? ZSTD_e_end
+		: mode == DT_CSV_ENCODE_FLUSH ? ZSTD_e_flush
+		: ZSTD_e_continue;
+
+	struct dt_csv_encoder* const encoder = output->encoder;
+	ZSTD_inBuffer input = { data, size, 0 };
+
+	while (true)
+	{
+		ZSTD_outBuffer buffer = { encoder->buffer, DT_CSV_WRITE_BLOCK_SIZE, 0 };
+		const size_t remaining = ZSTD_compressStream2(encoder->zstd, &buffer, &input, directive);
+		if (ZSTD_isError(remaining))
+			return DT_FAILURE;
+
+		if (fwrite(encoder->buffer, 1, buffer.pos, output->file) < buffer.pos)
+			return DT_FAILURE;
+
+		if (mode == DT_CSV_ENCODE_CONTINUE ? input.pos == input.size : remaining == 0)
+			return DT_SUCCESS;
+	}
+}
+#endif
+
+static enum status_code_e
+__encode_csv_block(
+	struct dt_csv_output* const output,
+	const void* const data,
+	const size_t size,
+	const enum __csv_encode_e mode)
+{
+	switch (output->compression)
+	{
+		case DT_CSV_COMPRESSION_NONE:
+			break;
+
+		case DT_CSV_COMPRESSION_GZIP:
+#ifdef DT_HAVE_ZLIB
+			return __encode_gzip(output, data, size, mode);
+#else
+			break;
+#endif
+
+		case DT_CSV_COMPRESSION_ZSTD:
+#ifdef DT_HAVE_ZSTD
+			return __encode_zstd(output, data, size, mode);
+#else
+			break;
+#endif
+	}
+
+	return DT_FAILURE;
+}
+
+enum status_code_e
+dt_csv_output_open(
+	const char* const filepath,
+	const bool append,
+	struct dt_csv_output* const output)
+{
+	output->file = NULL;
+	output->encoder = NULL;
+	output->owns_file = filepath && strcmp(filepath, "-") != 0;
+	output->is_empty = true;
+	output->compression = output->owns_file ? dt_csv_compression_from_path(filepath) : DT_CSV_COMPRESSION_NONE;
+	if (!dt_csv_compression_supported(output->compression))
+		return DT_FAILURE;
+
+	if (output->compression != DT_CSV_COMPRESSION_NONE)
+	{
+		output->encoder = __create_csv_encoder(output->compression, dt_get_default_allocator());
+		if (!output->encoder)
+			return DT_ALLOC_ERROR;
+	}
+
+	output->file = output->owns_file ? fopen(filepath, append ? "ab" : "wb") : stdout;
+	if (!output->file)
+	{
+		if (output->encoder)
+			__free_csv_encoder(output->encoder);
+		output->encoder = NULL;
+		return DT_FAILURE;
+	}
+
+	if (append && output->owns_file && fseek(output->file, 0, SEEK_END) == 0)
+		output->is_empty = ftell(output->file) == 0;
+
+	return DT_SUCCESS;
+}
+
+enum status_code_e
+dt_csv_output_write(
+	struct dt_csv_output* const output,
+	const void* const data,
+	const size_t size)
+{
+	if (size > 0)
+		output->is_empty = false;
+
+	if (output->encoder)
+		return __encode_csv_block(output, data, size, DT_CSV_ENCODE_CONTINUE);
+
+	return fwrite(data, 1, size, output->file) < size ? DT_FAILURE : DT_SUCCESS;
+}
+
+enum status_code_e
+dt_csv_output_sync(
+	struct dt_csv_output* const output)
+{
+	if (output->encoder && __encode_csv_block(output, NULL, 0, DT_CSV_ENCODE_FLUSH) != DT_SUCCESS)
+		return DT_FAILURE;
+
+	if (fflush(output->file) != 0)
+		return DT_FAILURE;
+
+#ifndef _WIN32
+	// pipes and terminals can't be synced
+	if (fsync(fileno(output->file)) != 0 && errno != EINVAL && errno != ENOTSUP)
+		return DT_FAILURE;
+#endif
+
+	return DT_SUCCESS;
+}
+
+enum status_code_e
+dt_csv_output_close(
+	struct dt_csv_output* const output)
+{
+	enum status_code_e status = DT_SUCCESS;
+	if (output->encoder)
+	{
+		if (output->file)
+			status = __encode_csv_block(output, NULL, 0, DT_CSV_ENCODE_END);
+		__free_csv_encoder(output->encoder);
+	}
+	output->encoder = NULL;
+
+	if (output->file)
+	{
+		if (output->owns_file ? fclose(output->file) != 0 : fflush(output->file) != 0)
+			status = DT_FAILURE;
+	}
+	output->file = NULL;
+
+	return status;
+}
@@ -28,6 +28,12 @@ char* dt_type_to_str(
 			return "UINT64";
 		case STRING:
 			return "STRING";
+		case BOOL:
+			return "BOOL";
+		case DATE:
+			return "DATE";
+		case TIMESTAMP:
+			return "TIMESTAMP";
 	}
 
 	return "UNKNOWN";
@@ -61,19 +67,220 @@ dt_type_to_size(
 			return sizeof(uint64_t);
 		case STRING:
 			return sizeof(char*);
+		case BOOL:
+			return sizeof(bool);
+		case DATE:
+			return sizeof(int32_t);
+		case TIMESTAMP:
+			return sizeof(int64_t);
 	}
 
 	return 0;
 }
 
+// shared values that BOOL reads point to (BOOL values are packed bits)
+static const bool __bool_values[2] = { false, true };
+
+static bool
+__get_bit(
+	const struct DataColumn* const column,
+	const size_t index)
+{
+	const size_t position = index + column->bit_offset;
+	return (((const uint64_t*)column->value)[position >> 6] >> (position & 63)) & 1;
+}
+
+static void
+__set_bit(
+	struct DataColumn* const column,
+	const size_t index,
+	const bool value)
+{
+	const size_t position = index + column->bit_offset;
+	uint64_t* word = (uint64_t*)column->value + (position >> 6);
+	const uint64_t mask = (uint64_t)1 << (position & 63);
+	*word = value ? (*word | mask) : (*word & ~mask);
+}
+
+static size_t
+__popcount(
+	uint64_t word)
+{
+	word = word - ((word >> 1) & 0x5555555555555555ULL);
+	word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+	word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (size_t)((word * 0x0101010101010101ULL) >> 56);
+}
+
+// number of bytes needed to hold [capacity] values of [type]
+static size_t
+__buffer_size(
+	const enum data_type_e type,
+	const size_t capacity)
+{
+	if (type == BOOL)
+		return ((capacity + 63) / 64) * sizeof(uint64_t);
+
+	return capacity * dt_type_to_size(type);
+}
+
+// NOTE: for BOOL columns this returns a pointer to a shared (read-only) true/false
+// value, so every write must go through __write_value/__zero_value instead
 static void* 
 get_index_ptr(
 	const struct DataColumn* const column,
 	const size_t index)
 {
+	if (column->type == BOOL)
+		return (void*)&__bool_values[__get_bit(column, index)];
+
+	if (column->chunk_size > 0)
+	{
+		const size_t position = index + column->chunk_offset;
+		return (char*)column->chunks[position >> column->chunk_shift]
+			+ (position & (column->chunk_size - 1)) * column->type_size;
+	}
+
 	return ((char*)column->value + index * column->type_size);
 }
 
+// write a single (raw) value at [index]; no copy is made for strings
+static void
+__write_value(
+	struct DataColumn* const column,
+	const size_t index,
+	const void* const value)
+{
+	if (column->type == BOOL)
+		__set_bit(column, index, *(const bool*)value);
+	else
+		memcpy(get_index_ptr(column, index), value, column->type_size);
+}
+
+static void
+__zero_value(
+	struct DataColumn* const column,
+	const size_t index)
+{
+	if (column->type == BOOL)
+		__set_bit(column, index, false);
+	else
+		memset(get_index_ptr(column, index), 0, column->type_size);
+}
+
+// copy a single value into [dest_index] of [dest_column]; STRING values are
+// duplicated with the destination column's allocator so the two
+// columns never share (and later double free) the same string
+static bool
+__copy_value(
+	struct DataColumn* const dest_column,
+	const size_t dest_index,
+	const void* const source)
+{
+	if (dest_column->type != STRING)
+	{
+		__write_value(dest_column, dest_index, source);
+		return true;
+	}
+
+	const char* const source_str = *(char* const*)source;
+	char* copy = NULL;
+	if (source_str)
+	{
+		copy = dt_strdup(dest_column->allocator, source_str);
+		if (!copy)
+			return false;
+	}
+	__write_value(dest_column, dest_index, &copy);
+	return true;
+}
+
+// number of values that are stored contiguously starting at [index]
+// (up to the end of the chunk for chunked columns)
+static size_t
+__contiguous_run(
+	const struct DataColumn* const column,
+	const size_t index)
+{
+	if (column->chunk_size > 0)
+		return column->chunk_size - ((index + column->chunk_offset) & (column->chunk_size - 1));
+
+	return column->value_capacity - index;
+}
+
+// grow the column so it can hold (at least) [capacity] values; new values are zeroed.
+// contiguous columns are reallocated to exactly [capacity] values while chunked
+// columns get new chunks and never move their existing values.
+static enum status_code_e
+__grow_capacity(
+	struct DataColumn* const column,
+	const size_t capacity)
+{
+	if (capacity <= column->value_capacity)
+		return DT_SUCCESS;
+
+	if (column->chunk_size == 0)
+	{
+		// the new tail is zeroed by dt_aligned_realloc
+		void* alloc = dt_aligned_realloc(
+			column->allocator,
+			column->value,
+			__buffer_size(column->type, column->value_capacity),
+			__buffer_size(column->type, capacity));
+		if (!alloc)
+			return DT_ALLOC_ERROR;
+		column->value = alloc;
+		column->value_capacity = capacity;
+		return DT_SUCCESS;
+	}
+
+	const size_t n_chunks = (capacity + column->chunk_size - 1) >> column->chunk_shift;
+	if (n_chunks > column->chunk_capacity)
+	{
+		size_t new_chunk_capacity = column->chunk_capacity * 2;
+		if (new_chunk_capacity < n_chunks)
+			new_chunk_capacity = n_chunks;
+
+		// only the (small) array of chunk pointers is ever reallocated
+		void* alloc = dt_realloc(
+			column->allocator,
+			column->chunks,
+			column->chunk_capacity * sizeof(void*),
+			new_chunk_capacity * sizeof(void*));
+		if (!alloc)
+			return DT_ALLOC_ERROR;
+		column->chunks = alloc;
+		column->chunk_capacity = new_chunk_capacity;
+	}
+
+	while (column->n_chunks < n_chunks)
+	{
+		void* chunk = dt_aligned_calloc(column->allocator, column->chunk_size, column->type_size);
+		if (!chunk)
+			return DT_ALLOC_ERROR;
+		column->chunks[column->n_chunks++] = chunk;
+		column->value_capacity += column->chunk_size;
+	}
+
+	return DT_SUCCESS;
+}
+
+static void
+__free_chunks(
+	struct DataColumn* const column)
+{
+	for (size_t i = 0; i < column->n_chunks; ++i)
+		dt_aligned_free(column->allocator, column->chunks[i]);
+	dt_free(column->allocator, column->chunks);
+
+	column->chunks = NULL;
+	column->n_chunks = 0;
+	column->chunk_capacity = 0;
+	column->chunk_size = 0;
+	column->chunk_shift = 0;
+	column->chunk_offset = 0;
+}
+
 static enum status_code_e
 __insert_null_value(
 	struct DataColumn* column,
@@ -83,7 +290,7 @@ __insert_null_value(
 	{
 		column->n_null_values = 0;
 		column->null_value_capacity = 1;
-		column->null_value_indices = calloc(1, sizeof(size_t));
+		column->null_value_indices = dt_aligned_calloc(column->allocator, 1, sizeof(size_t));
 		if (!column->null_value_indices)
 			return DT_ALLOC_ERROR;
 	}
@@ -91,16 +298,19 @@ __insert_null_value(
 	column->null_value_indices[column->n_null_values++] = index;
 	if (column->n_null_values == column->null_value_capacity)
 	{
-		size_t new_capacity = column->null_value_capacity *= 2;
-		void* alloc = realloc(column->null_value_indices, new_capacity * sizeof(size_t));
+		size_t new_capacity = column->null_value_capacity * 2;
+		void* alloc = dt_aligned_realloc(
+			column->allocator,
+			column->null_value_indices,
+			column->null_value_capacity * sizeof(size_t),
+			new_capacity * sizeof(size_t));
 		if (!alloc)
 			return DT_ALLOC_ERROR;
 		column->null_value_indices = alloc;
 		column->null_value_capacity = new_capacity;
 	}
 
-	void* value_at = get_index_ptr((const struct DataColumn* const)column, index);
-	memset(value_at, 0, column->type_size);
+	__zero_value(column, index);
 
 	return DT_SUCCESS;
 }
@@ -141,18 +351,29 @@ dt_column_create(
 	const size_t capacity,
 	const enum data_type_e type)
 {
-	(*column) = malloc(sizeof(**column));
+	return dt_column_create_with_allocator(column, capacity, type, dt_get_default_allocator());
+}
+
+enum status_code_e
+dt_column_create_with_allocator(
+	struct DataColumn** column,
+	const size_t capacity,
+	const enum data_type_e type,
+	const struct dt_allocator* const allocator)
+{
+	(*column) = dt_alloc(allocator, sizeof(**column));
 	if (!*column)
 		return DT_ALLOC_ERROR;
 
 	// NOTE: *2 + 1 to handle the case of 0 (empty column, we still want the ability to append)
-	(*column)->value = calloc(capacity * 2 + 1, dt_type_to_size(type));
+	(*column)->value = dt_aligned_calloc(allocator, 1, __buffer_size(type, capacity * 2 + 1));
 	if (!(*column)->value)
 	{
-		free(*column);
+		dt_free(allocator, *column);
 		*column = NULL;
 		return DT_ALLOC_ERROR;
 	}
+	(*column)->allocator = allocator;
 	(*column)->type = type;
 	(*column)->type_size = dt_type_to_size(type);
 	(*column)->n_values = capacity;
@@ -167,6 +388,18 @@ dt_column_create(
 	(*column)->n_null_values = 0;
 	(*column)->null_value_capacity = 1;
 
+	(*column)->is_view = false;
+
+	(*column)->chunks = NULL;
+	(*column)->n_chunks = 0;
+	(*column)->chunk_capacity = 0;
+	(*column)->chunk_size = 0;
+	(*column)->chunk_shift = 0;
+	(*column)->chunk_offset = 0;
+
+	(*column)->bit_offset = 0;
+	(*column)->time_unit = DT_DEFAULT_TIME_UNIT;
+
 	return DT_SUCCESS;
 }
 
@@ -174,12 +407,22 @@ void
 dt_column_free(
 	struct DataColumn** column)
 {
-	if ((*column)->deallocator)
-		for (size_t i = 0; i < (*column)->n_values; ++i)
-			dt_string_dealloc(get_index_ptr(*column, i));
+	const struct dt_allocator* const allocator = (*column)->allocator;
+
+	// views don't own their values; the parent column frees them
+	if (!(*column)->is_view)
+	{
+		if ((*column)->deallocator)
+			for (size_t i = 0; i < (*column)->n_values; ++i)
+				dt_free(allocator, *(char**)get_index_ptr(*column, i));
 
-	free((*column)->value);
+		if ((*column)->chunk_size > 0)
+			__free_chunks(*column);
+		else
+			dt_aligned_free(allocator, (*column)->value);
+	}
 	(*column)->value = NULL;
+	(*column)->chunks = NULL;
 
 	(*column)->n_values = 0;
 	(*column)->value_capacity = 0;
@@ -188,11 +431,11 @@ dt_column_free(
 	{
 		(*column)->n_null_values = 0;
 		(*column)->null_value_capacity = 1;
-		free((*column)->null_value_indices);
+		dt_aligned_free(allocator, (*column)->null_value_indices);
 		(*column)->null_value_indices = NULL;
 	}
 
-	free(*column);
+	dt_free(allocator, *column);
 	*column = NULL;
 }
 
@@ -205,18 +448,21 @@ dt_column_set_value(
 	if (index >= column->n_values)
 		return DT_INDEX_ERROR;
 
+	if (dt_column_materialize(column) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	void* value_at = get_index_ptr(column, index);
 
 	// if string type, be sure to deallocate before re-writing
 	if (column->type == STRING)
 	{
 		char** value_str = value_at;
-		free(*value_str);
+		dt_free(column->allocator, *value_str);
 	}
 	
 	if (!value)
 	{
-		memset(value_at, 0, column->type_size);
+		__zero_value(column, index);
 		enum status_code_e status = __insert_null_value(column, index);
 		if (status != DT_SUCCESS)
 			return status;
@@ -225,11 +471,11 @@ dt_column_set_value(
   {
     if (column->type == STRING)
     {
-      char* value_str = strdup((const char*)value);
+      char* value_str = dt_strdup(column->allocator, (const char*)value);
       memcpy(value_at, &value_str, column->type_size);
     }
     else
-      memcpy(value_at, value, column->type_size);
+      __write_value(column, index, value);
   }
 
 	// overwriting NULL value with non-null value,
@@ -249,10 +495,13 @@ dt_column_append_value(
 	struct DataColumn* const column,
 	const void * const value)
 {
+	if (dt_column_materialize(column) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	void* value_at = get_index_ptr(column, column->n_values);
 	if (!value)
 	{
-		memset(value_at, 0, column->type_size);
+		__zero_value(column, column->n_values);
 		enum status_code_e status = __insert_null_value(column, column->n_values);
 		if (status != DT_SUCCESS)
 			return status;
@@ -264,23 +513,121 @@ dt_column_append_value(
 		if (column->type == STRING)
 		{
 			//const char** const value_str_addr = (const char** const)value;
-			const char* const value_str = strdup((const char*)value);
+			const char* const value_str = dt_strdup(column->allocator, (const char*)value);
 			memcpy(value_at, &value_str, column->type_size);
 		}
 		else
-			memcpy(value_at, value, column->type_size);
+			__write_value(column, column->n_values, value);
 	}
 
 	column->n_values++;
 	if (column->n_values >= column->value_capacity)
 	{
-		void* alloc = realloc(column->value, column->value_capacity * 2 * column->type_size);
-		if (!alloc)
+		// chunked columns only need one more chunk
+		const size_t capacity = column->chunk_size > 0
+			? column->value_capacity + 1
+			: column->value_capacity * 2;
+		if (__grow_capacity(column, capacity) != DT_SUCCESS)
 			return DT_ALLOC_ERROR;
-		column->value = alloc;
-		column->value_capacity *= 2;
-		for (size_t i = column->n_values; i < column->value_capacity; ++i)
-			memset(get_index_ptr(column, i), 0, column->type_size);
+	}
+
+	return DT_SUCCESS;
+}
+
+enum status_code_e
+dt_column_reserve(
+	struct DataColumn* const column,
+	const size_t capacity)
+{
+	if (dt_column_materialize(column) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	// dt_column_append_value grows once n_values reaches the capacity,
+	// so keep one spare slot to avoid an immediate reallocation
+	return __grow_capacity(column, capacity + 1);
+}
+
+enum status_code_e
+dt_column_append_values(
+	struct DataColumn* const column,
+	const void* const values,
+	const size_t n_values,
+	const bool* const validity)
+{
+	if (n_values == 0)
+		return DT_SUCCESS;
+
+	// grow geometrically so repeated small batches stay amortized O(1)
+	// (chunked columns never move their values so they only grow as needed)
+	size_t capacity = column->n_values + n_values;
+	if (column->chunk_size == 0 && capacity < column->value_capacity * 2)
+		capacity = column->value_capacity * 2;
+	if (column->n_values + n_values >= column->value_capacity
+			&& dt_column_reserve(column, capacity) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	if (dt_column_materialize(column) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	const size_t start = column->n_values;
+	if (column->type == STRING)
+	{
+		const char* const* strings = values;
+		for (size_t i = 0; i < n_values; ++i)
+		{
+			if (!strings[i] || (validity && !validity[i]))
+				continue;
+
+			char** dest = get_index_ptr(column, start + i);
+			*dest = dt_strdup(column->allocator, strings[i]);
+			if (!*dest)
+			{
+				for (size_t k = 0; k < i; ++k)
+				{
+					char** allocated = get_index_ptr(column, start + k);
+					dt_free(column->allocator, *allocated);
+					*allocated = NULL;
+				}
+				return DT_ALLOC_ERROR;
+			}
+		}
+	}
+	else if (column->type == BOOL)
+	{
+		const bool* bools = values;
+		for (size_t i = 0; i < n_values; ++i)
+			__write_value(column, start + i, &bools[i]);
+	}
+	else
+	{
+		// one copy per contiguous run (the whole buffer unless the column is chunked)
+		size_t n_copied = 0;
+		while (n_copied < n_values)
+		{
+			size_t n_run = __contiguous_run(column, start + n_copied);
+			if (n_run > n_values - n_copied)
+				n_run = n_values - n_copied;
+
+			memcpy(
+				get_index_ptr(column, start + n_copied),
+				(const char*)values + n_copied * column->type_size,
+				n_run * column->type_size);
+			n_copied += n_run;
+		}
+	}
+
+	column->n_values += n_values;
+
+	// NULL strings are treated as null values, same as dt_column_append_value
+	if (validity || column->type == STRING)
+	{
+		for (size_t i = 0; i < n_values; ++i)
+		{
+			const bool is_null = (validity && !validity[i])
+				|| (column->type == STRING && !((const char* const*)values)[i]);
+			if (is_null && __insert_null_value(column, start + i) != DT_SUCCESS)
+				return DT_ALLOC_ERROR;
+		}
 	}
 
 	return DT_SUCCESS;
@@ -307,6 +654,58 @@ dt_column_append(
 	return DT_SUCCESS;
 }
 
+enum status_code_e
+dt_column_append_move(
+	struct DataColumn* const dest,
+	struct DataColumn* const src)
+{
+	if (dest->type != src->type)
+		return DT_TYPE_MISMATCH;
+
+	if (src->is_view)
+		return DT_BAD_ARG;
+
+	const size_t offset = dest->n_values;
+	if (dt_column_resize(dest, offset + src->n_values) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	// copy whole runs at a time; BOOL bits rarely line up so they go one by one
+	size_t i = 0;
+	while (i < src->n_values)
+	{
+		if (src->type == BOOL)
+		{
+			__write_value(dest, offset + i, get_index_ptr(src, i));
+			i++;
+			continue;
+		}
+
+		size_t run = __contiguous_run(src, i);
+		const size_t dest_run = __contiguous_run(dest, offset + i);
+		if (dest_run < run)
+			run = dest_run;
+		if (src->n_values - i < run)
+			run = src->n_values - i;
+
+		memcpy(get_index_ptr(dest, offset + i), get_index_ptr(src, i), run * src->type_size);
+		i += run;
+	}
+
+	for (size_t k = 0; k < src->n_null_values; ++k)
+		if (__insert_null_value(dest, offset + src->null_value_indices[k]) != DT_SUCCESS)
+			return DT_ALLOC_ERROR;
+
+	// [dest] owns the strings now
+	if (src->type == STRING)
+		for (size_t k = 0; k < src->n_values; ++k)
+			__zero_value(src, k);
+
+	src->n_values = 0;
+	src->n_null_values = 0;
+
+	return DT_SUCCESS;
+}
+
 enum status_code_e
 dt_column_get_value(
 	const struct DataColumn* const column,
@@ -347,6 +746,22 @@ dt_column_iterate_rows(
 	void (*user_callback)(void* item, void* user_data),
   void* user_data)
 {
+	// callback is allowed to modify the items
+	if (dt_column_materialize(column) != DT_SUCCESS)
+		return;
+
+	if (column->type == BOOL)
+	{
+		// bits can't be addressed directly; hand out a copy and write it back
+		for (size_t i = 0; i < column->n_values; ++i)
+		{
+			bool item = *(bool*)get_index_ptr(column, i);
+			user_callback(&item, user_data);
+			__write_value(column, i, &item);
+		}
+		return;
+	}
+
 	for (size_t i = 0; i < column->n_values; ++i)
 		user_callback(get_index_ptr(column, i), user_data);
 }
@@ -356,23 +771,20 @@ dt_column_copy(
 	const struct DataColumn* const column)
 {
 	struct DataColumn* copy_column = NULL;
-	if (!dt_column_create(&copy_column, column->n_values, column->type))
+	if (!dt_column_create_with_allocator(&copy_column, column->n_values, column->type, column->allocator))
 		return NULL;
+	copy_column->time_unit = column->time_unit;
 
 	for (size_t i = 0; i < column->n_values; ++i)
 	{
 		void* source = get_index_ptr(column, i);
-		void* dest = get_index_ptr(copy_column, i);
 		// creating a deep copy, so if the data is heap-allocated,
 		// we need to heap-allocate a copy as well
-		if (column->type == STRING)
+		if (!__copy_value(copy_column, i, source))
 		{
-			//char** source_addr = source;
-			char* source_content = strdup((const char*)source);
-			memcpy(dest, &source_content, copy_column->type_size);
+			dt_column_free(&copy_column);
+			return NULL;
 		}
-		else
-			memcpy(dest, source, column->type_size);
 	}
 
 	// copy null values (if any)
@@ -380,7 +792,7 @@ dt_column_copy(
 	{
 		copy_column->n_null_values = column->n_null_values;
 		copy_column->null_value_capacity = column->n_null_values + 1;
-		copy_column->null_value_indices = calloc(column->n_null_values + 1, sizeof(size_t));
+		copy_column->null_value_indices = dt_aligned_calloc(column->allocator, column->n_null_values + 1, sizeof(size_t));
 		if (!copy_column->null_value_indices)
 		{
 			dt_column_free(&copy_column);
@@ -401,7 +813,7 @@ dt_column_filter(
   void* user_data)
 {
 	// an array of 0/1 indicating whether or not to keep the row
-	size_t* filtered_idx = calloc(column->n_values, sizeof(size_t));
+	size_t* filtered_idx = dt_aligned_calloc(column->allocator, column->n_values, sizeof(size_t));
 	if (!filtered_idx)
 		return NULL;
 
@@ -423,7 +835,7 @@ dt_column_subset_by_boolean(
 		new_size += boolean_idx[i];
 
 	struct DataColumn* subset = NULL;
-	dt_column_create(&subset, new_size, column->type);
+	dt_column_create_with_allocator(&subset, new_size, column->type, column->allocator);
 
 	if (!subset)
 		return NULL;
@@ -435,8 +847,67 @@ dt_column_subset_by_boolean(
 		if (boolean_idx[i] == 1)
 		{
 			void* src = get_index_ptr(column, i);
-			void* dest = get_index_ptr(subset, current_idx++);
-			memcpy(dest, src, column->type_size);
+			if (!__copy_value(subset, current_idx++, src))
+			{
+				dt_column_free(&subset);
+				return NULL;
+			}
+		}
+	}
+
+	return subset;
+}
+
+struct DataColumn*
+dt_column_filter_to_mask(
+	const struct DataColumn* const column,
+	bool (*filter_callback)(void* item, void* user_data),
+	void* user_data)
+{
+	struct DataColumn* mask = NULL;
+	if (dt_column_create_with_allocator(&mask, column->n_values, BOOL, column->allocator) != DT_SUCCESS)
+		return NULL;
+
+	for (size_t i = 0; i < column->n_values; ++i)
+		if (filter_callback(get_index_ptr(column, i), user_data))
+			__set_bit(mask, i, true);
+
+	return mask;
+}
+
+struct DataColumn*
+dt_column_subset_by_mask(
+	const struct DataColumn* const column,
+	const struct DataColumn* const mask)
+{
+	if (mask->type != BOOL || mask->n_values != column->n_values)
+		return NULL;
+
+	size_t new_size = 0;
+	dt_column_sum(mask, &new_size);
+
+	struct DataColumn* subset = NULL;
+	if (dt_column_create_with_allocator(&subset, new_size, column->type, column->allocator) != DT_SUCCESS)
+		return NULL;
+
+	size_t current_idx = 0;
+	for (size_t i = 0; i < mask->n_values; ++i)
+	{
+		// skip 64 unselected rows at once when the mask is word-aligned
+		if (mask->bit_offset == 0 && (i & 63) == 0
+				&& ((const uint64_t*)mask->value)[i >> 6] == 0)
+		{
+			i += 63;
+			continue;
+		}
+
+		if (!__get_bit(mask, i))
+			continue;
+
+		if (!__copy_value(subset, current_idx++, get_index_ptr(column, i)))
+		{
+			dt_column_free(&subset);
+			return NULL;
 		}
 	}
 
@@ -453,7 +924,8 @@ dt_column_subset_by_index(
 		return NULL;
 
 	struct DataColumn* subset = NULL;
-	dt_column_create(&subset, n_indices, column->type);
+	if (!dt_column_create_with_allocator(&subset, n_indices, column->type, column->allocator))
+		return NULL;
 
 	for (size_t i = 0; i < n_indices; ++i)
 	{
@@ -461,8 +933,8 @@ dt_column_subset_by_index(
 			goto bad_index;
 
 		void* source = get_index_ptr(column, indices[i]);
-		void* dest = get_index_ptr(subset, i);
-		memcpy(dest, source, column->type_size);
+		if (!__copy_value(subset, i, source))
+			goto bad_index;
 	}
 
 	return subset;
@@ -502,7 +974,8 @@ dt_column_drop_by_index(
 		return NULL;
 
 	struct DataColumn* subset = NULL;
-	dt_column_create(&subset, column->n_values - n_indices, column->type);
+	if (!dt_column_create_with_allocator(&subset, column->n_values - n_indices, column->type, column->allocator))
+		return NULL;
 
 	size_t current_idx = 0;
 	for (size_t i = 0; i < column->n_values; ++i)
@@ -511,58 +984,375 @@ dt_column_drop_by_index(
 		if (!bsearch(&i, sorted_indices_ascending, n_indices, sizeof(size_t), &sizet_compare))
 		{
 			void* source = get_index_ptr(column, i);
-			void* dest = get_index_ptr(subset, current_idx++);
-			memcpy(dest, source, column->type_size);
+			if (!__copy_value(subset, current_idx++, source))
+			{
+				dt_column_free(&subset);
+				return NULL;
+			}
 		}
 	}
 
 	return subset;
 }
 
-enum status_code_e
-dt_column_resize(
-	struct DataColumn* const column,
-	const size_t n_values)
+struct DataColumn*
+dt_column_view(
+	const struct DataColumn* const column,
+	const size_t offset,
+	const size_t length)
 {
-	if (n_values > column->value_capacity)
-	{
-		void* alloc = realloc(column->value, n_values * column->type_size);
-		if (!alloc)
-			return DT_ALLOC_ERROR;
-		column->value_capacity = n_values;
-		column->value = alloc;
+	if (offset > column->n_values || length > column->n_values - offset)
+		return NULL;
 
-		for (size_t i = column->n_values; i < n_values; ++i)
-			memset(get_index_ptr(column, i), 0, column->type_size);
+	struct DataColumn* view = dt_alloc(column->allocator, sizeof(*view));
+	if (!view)
+		return NULL;
+
+	view->allocator = column->allocator;
+	view->type = column->type;
+	view->type_size = column->type_size;
+	view->time_unit = column->time_unit;
+
+	// views of chunked columns share the parent's chunks and start [offset] values in
+	view->chunks = column->chunks;
+	view->n_chunks = column->n_chunks;
+	view->chunk_capacity = column->chunk_capacity;
+	view->chunk_size = column->chunk_size;
+	view->chunk_shift = column->chunk_shift;
+	view->chunk_offset = column->chunk_offset + offset;
+	view->value = column->chunk_size > 0 ? NULL : get_index_ptr(column, offset);
+	view->bit_offset = 0;
+	if (column->type == BOOL)
+	{
+		// views of BOOL columns start at the word holding their first bit
+		const size_t position = column->bit_offset + offset;
+		view->value = (uint64_t*)column->value + (position >> 6);
+		view->bit_offset = position & 63;
 	}
+	view->n_values = length;
+	view->value_capacity = length;
+	view->deallocator = NULL;
+	view->is_view = true;
+
+	// null indices are small so each view keeps its own (rebased) copy
+	// instead of scanning the parent's list on every lookup
+	view->null_value_indices = NULL;
+	view->n_null_values = 0;
+	view->null_value_capacity = 1;
+
+	size_t n_null_values = 0;
+	for (size_t i = 0; i < column->n_null_values; ++i)
+		if (column->null_value_indices[i] >= offset
+				&& column->null_value_indices[i] < offset + length)
+			n_null_values++;
 
-	column->n_values = n_values;
+	if (n_null_values > 0)
+	{
+		view->null_value_indices = dt_aligned_calloc(view->allocator, n_null_values + 1, sizeof(size_t));
+		if (!view->null_value_indices)
+		{
+			dt_free(view->allocator, view);
+			return NULL;
+		}
+		view->null_value_capacity = n_null_values + 1;
 
-	return DT_SUCCESS;
+		for (size_t i = 0; i < column->n_null_values; ++i)
+			if (column->null_value_indices[i] >= offset
+					&& column->null_value_indices[i] < offset + length)
+				view->null_value_indices[view->n_null_values++] = column->null_value_indices[i] - offset;
+	}
+
+	return view;
 }
 
-enum status_code_e
-dt_column_union(
-	struct DataColumn* const dest,
-	const struct DataColumn* const src)
+// count the cleared bits among the [n_bits] bits of [bitmap] from bit [offset] and, if
+// [indices] isn't NULL, store their positions (relative to [offset]) in it.
+// bytes with every bit set are skipped whole
+static size_t
+__find_unset_bits(
+	const uint8_t* const bitmap,
+	const size_t offset,
+	const size_t n_bits,
+	size_t* const indices)
 {
-	if (dest->type != src->type)
-		return DT_TYPE_MISMATCH;
-
-	size_t initial_size = dest->n_values;
-
-	if (!dt_column_resize(dest, dest->n_values + src->n_values))
-		return DT_ALLOC_ERROR;
-
-	size_t src_idx = 0;
-	for (; initial_size < dest->n_values; ++initial_size)
+	size_t n_unset = 0;
+	for (size_t i = 0; i < n_bits;)
 	{
-		void* get = get_index_ptr(src, src_idx++);
-		void* set = get_index_ptr(dest, initial_size);
-		memcpy(set, get, src->type_size);
+		const size_t position = offset + i;
+		if ((position & 7) == 0 && n_bits - i >= 8 && bitmap[position >> 3] == 0xFF)
+		{
+			i += 8;
+			continue;
+		}
+
+		if (!((bitmap[position >> 3] >> (position & 7)) & 1))
+		{
+			if (indices)
+				indices[n_unset] = i;
+			n_unset++;
+		}
+		++i;
 	}
 
-	return DT_SUCCESS;
+	return n_unset;
+}
+
+struct DataColumn*
+dt_column_wrap(
+	const enum data_type_e type,
+	const void* const values,
+	const uint8_t* const validity,
+	const size_t offset,
+	const size_t n_values,
+	const struct dt_allocator* const allocator)
+{
+	struct DataColumn* view = dt_calloc(allocator, 1, sizeof(*view));
+	if (!view)
+		return NULL;
+
+	view->allocator = allocator;
+	view->type = type;
+	view->type_size = dt_type_to_size(type);
+	view->time_unit = DT_DEFAULT_TIME_UNIT;
+	view->n_values = n_values;
+	view->value_capacity = n_values;
+	view->deallocator = NULL;
+	view->is_view = true;
+	view->null_value_capacity = 1;
+
+	if (type == BOOL)
+	{
+		view->value = (uint64_t*)values + (offset >> 6);
+		view->bit_offset = offset & 63;
+	}
+	else
+		view->value = (char*)values + offset * view->type_size;
+
+	if (!validity)
+		return view;
+
+	const size_t n_null_values = __find_unset_bits(validity, offset, n_values, NULL);
+	if (n_null_values > 0)
+	{
+		view->null_value_indices = dt_aligned_calloc(allocator, n_null_values + 1, sizeof(size_t));
+		if (!view->null_value_indices)
+		{
+			dt_free(allocator, view);
+			return NULL;
+		}
+		view->null_value_capacity = n_null_values + 1;
+		view->n_null_values = __find_unset_bits(validity, offset, n_values, view->null_value_indices);
+	}
+
+	return view;
+}
+
+enum status_code_e
+dt_column_materialize(
+	struct DataColumn* const column)
+{
+	if (!column->is_view)
+		return DT_SUCCESS;
+
+	// same growth policy as dt_column_create.
+	// (views of chunked columns are materialized into a contiguous buffer)
+	void* values = dt_aligned_calloc(column->allocator, 1, __buffer_size(column->type, column->n_values * 2 + 1));
+	if (!values)
+		return DT_ALLOC_ERROR;
+
+	if (column->type == BOOL)
+	{
+		// realign the bits so the first value is bit 0 of the new buffer
+		struct DataColumn aligned = *column;
+		aligned.value = values;
+		aligned.bit_offset = 0;
+		for (size_t i = 0; i < column->n_values; ++i)
+			__set_bit(&aligned, i, __get_bit(column, i));
+		column->bit_offset = 0;
+	}
+	else if (column->type == STRING)
+	{
+		for (size_t i = 0; i < column->n_values; ++i)
+		{
+			const char* const source = *(char**)get_index_ptr(column, i);
+			if (!source)
+				continue;
+
+			char* copy = dt_strdup(column->allocator, source);
+			if (!copy)
+			{
+				for (size_t k = 0; k < i; ++k)
+					dt_free(column->allocator, ((char**)values)[k]);
+				dt_aligned_free(column->allocator, values);
+				return DT_ALLOC_ERROR;
+			}
+			((char**)values)[i] = copy;
+		}
+		column->deallocator = &dt_string_dealloc;
+	}
+	else if (column->chunk_size > 0)
+	{
+		for (size_t i = 0; i < column->n_values; ++i)
+			memcpy((char*)values + i * column->type_size, get_index_ptr(column, i), column->type_size);
+	}
+	else
+		memcpy(values, column->value, column->n_values * column->type_size);
+
+	column->value = values;
+	column->value_capacity = column->n_values * 2 + 1;
+	column->is_view = false;
+
+	// the chunks (if any) belong to the parent
+	column->chunks = NULL;
+	column->n_chunks = 0;
+	column->chunk_capacity = 0;
+	column->chunk_size = 0;
+	column->chunk_shift = 0;
+	column->chunk_offset = 0;
+
+	return DT_SUCCESS;
+}
+
+enum status_code_e
+dt_column_make_chunked(
+	struct DataColumn* const column,
+	const size_t chunk_size)
+{
+	if (chunk_size == 0)
+		return DT_BAD_ARG;
+
+	// bits are already packed 64 per word, chunking them isn't supported
+	if (column->type == BOOL)
+		return DT_TYPE_MISMATCH;
+
+	// round up to a power of two so indexing is a shift and a mask
+	size_t chunk_shift = 0;
+	while (((size_t)1 << chunk_shift) < chunk_size)
+		chunk_shift++;
+
+	if (column->chunk_size == ((size_t)1 << chunk_shift) && !column->is_view)
+		return DT_SUCCESS;
+
+	if (dt_column_make_contiguous(column) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	// build the chunks on a copy so the column is untouched if allocation fails
+	struct DataColumn chunked = *column;
+	chunked.value = NULL;
+	chunked.value_capacity = 0;
+	chunked.chunks = NULL;
+	chunked.n_chunks = 0;
+	chunked.chunk_capacity = 0;
+	chunked.chunk_size = (size_t)1 << chunk_shift;
+	chunked.chunk_shift = chunk_shift;
+	chunked.chunk_offset = 0;
+
+	if (__grow_capacity(&chunked, column->n_values + 1) != DT_SUCCESS)
+	{
+		__free_chunks(&chunked);
+		return DT_ALLOC_ERROR;
+	}
+
+	size_t n_copied = 0;
+	while (n_copied < column->n_values)
+	{
+		size_t n_run = __contiguous_run(&chunked, n_copied);
+		if (n_run > column->n_values - n_copied)
+			n_run = column->n_values - n_copied;
+
+		memcpy(
+			get_index_ptr(&chunked, n_copied),
+			get_index_ptr(column, n_copied),
+			n_run * column->type_size);
+		n_copied += n_run;
+	}
+
+	// values (including string pointers) moved to the chunks; only release the old buffer
+	dt_aligned_free(column->allocator, column->value);
+	*column = chunked;
+
+	return DT_SUCCESS;
+}
+
+enum status_code_e
+dt_column_make_contiguous(
+	struct DataColumn* const column)
+{
+	if (dt_column_materialize(column) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	if (column->chunk_size == 0)
+		return DT_SUCCESS;
+
+	// same growth policy as dt_column_create
+	const size_t capacity = column->n_values * 2 + 1;
+	void* values = dt_aligned_calloc(column->allocator, capacity, column->type_size);
+	if (!values)
+		return DT_ALLOC_ERROR;
+
+	size_t n_copied = 0;
+	while (n_copied < column->n_values)
+	{
+		size_t n_run = __contiguous_run(column, n_copied);
+		if (n_run > column->n_values - n_copied)
+			n_run = column->n_values - n_copied;
+
+		memcpy(
+			(char*)values + n_copied * column->type_size,
+			get_index_ptr(column, n_copied),
+			n_run * column->type_size);
+		n_copied += n_run;
+	}
+
+	__free_chunks(column);
+	column->value = values;
+	column->value_capacity = capacity;
+
+	return DT_SUCCESS;
+}
+
+enum status_code_e
+dt_column_resize(
+	struct DataColumn* const column,
+	const size_t n_values)
+{
+	if (dt_column_materialize(column) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	if (n_values > column->value_capacity)
+	{
+		// chunked columns keep a spare slot like dt_column_append_value does
+		const size_t capacity = column->chunk_size > 0 ? n_values + 1 : n_values;
+		if (__grow_capacity(column, capacity) != DT_SUCCESS)
+			return DT_ALLOC_ERROR;
+
+		for (size_t i = column->n_values; i < n_values; ++i)
+			__zero_value(column, i);
+	}
+
+	column->n_values = n_values;
+
+	return DT_SUCCESS;
+}
+
+enum status_code_e
+dt_column_union(
+	struct DataColumn* const dest,
+	const struct DataColumn* const src)
+{
+	if (dest->type != src->type)
+		return DT_TYPE_MISMATCH;
+
+	size_t initial_size = dest->n_values;
+
+	if (!dt_column_resize(dest, dest->n_values + src->n_values))
+		return DT_ALLOC_ERROR;
+
+	size_t src_idx = 0;
+	for (; initial_size < dest->n_values; ++initial_size)
+		__write_value(dest, initial_size, get_index_ptr(src, src_idx++));
+
+	return DT_SUCCESS;
 }
 
 enum status_code_e
@@ -624,8 +1414,27 @@ dt_column_sum(
 		case DOUBLE:
 			_agg_loop(column, result, double, _sum_item);
 			break;
+		case DATE:
+			_agg_loop(column, result, int32_t, _sum_item);
+			break;
+		case TIMESTAMP:
+			_agg_loop(column, result, int64_t, _sum_item);
+			break;
 		case STRING: // aggregates on strings not supported (at least, for now)
 			break;
+		case BOOL: // number of true values
+		{
+			const uint64_t* words = column->value;
+			size_t* count = result;
+			size_t i = 0;
+			// whole words at once when the bits are word-aligned
+			if (column->bit_offset == 0)
+				for (; i + 64 <= column->n_values; i += 64)
+					*count += __popcount(words[i >> 6]);
+			for (; i < column->n_values; ++i)
+				*count += __get_bit(column, i);
+			break;
+		}
 	}
 }
 
@@ -669,6 +1478,15 @@ dt_column_max(
 		case DOUBLE:
 			_agg_loop(column, result, double, _max_item);
 			break;
+		case DATE:
+			_agg_loop(column, result, int32_t, _max_item);
+			break;
+		case TIMESTAMP:
+			_agg_loop(column, result, int64_t, _max_item);
+			break;
+		case BOOL:
+			_agg_loop(column, result, bool, _max_item);
+			break;
 		case STRING: // aggregates on strings not supported (at least, for now)
 			break;
 	}
@@ -714,6 +1532,15 @@ dt_column_min(
 		case DOUBLE:
 			_agg_loop(column, result, double, _min_item);
 			break;
+		case DATE:
+			_agg_loop(column, result, int32_t, _min_item);
+			break;
+		case TIMESTAMP:
+			_agg_loop(column, result, int64_t, _min_item);
+			break;
+		case BOOL:
+			_agg_loop(column, result, bool, _min_item);
+			break;
 		case STRING: // aggregates on strings not supported (at least, for now)
 			break;
 	}
@@ -756,7 +1583,14 @@ dt_column_avg(
 		case DOUBLE:
 			_agg_loop_divide_size(column, result, double, _sum_item);
 			break;
+		case DATE:
+			_agg_loop_divide_size(column, result, int32_t, _sum_item);
+			break;
+		case TIMESTAMP:
+			_agg_loop_divide_size(column, result, int64_t, _sum_item);
+			break;
 		case STRING: // aggregates on strings not supported (at least, for now)
+		case BOOL: // (use dt_column_sum to count the true values)
 			break;
 	}
 }
@@ -781,6 +1615,9 @@ dt_column_add(
 	if (dest->type != src->type)
 		return DT_TYPE_MISMATCH;
 
+	if (dt_column_materialize(dest) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	switch (dest->type)
 	{
 		case UINT8:
@@ -813,7 +1650,14 @@ dt_column_add(
 		case DOUBLE:
 			_add_values_loop(dest, src, double);
 			break;
+		case DATE:
+			_add_values_loop(dest, src, int32_t);
+			break;
+		case TIMESTAMP:
+			_add_values_loop(dest, src, int64_t);
+			break;
 		case STRING: // aggregates on strings not supported (at least, for now)
+		case BOOL: // (use dt_column_and/dt_column_or/dt_column_xor)
 			break;
 	}
 
@@ -839,6 +1683,9 @@ dt_column_subtract(
 	if (dest->type != src->type)
 		return DT_TYPE_MISMATCH;
 
+	if (dt_column_materialize(dest) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	switch (dest->type)
 	{
 		case UINT8:
@@ -871,7 +1718,14 @@ dt_column_subtract(
 		case DOUBLE:
 			_subtract_values_loop(dest, src, double);
 			break;
+		case DATE:
+			_subtract_values_loop(dest, src, int32_t);
+			break;
+		case TIMESTAMP:
+			_subtract_values_loop(dest, src, int64_t);
+			break;
 		case STRING: // aggregates on strings not supported (at least, for now)
+		case BOOL: // (use dt_column_and/dt_column_or/dt_column_xor)
 			break;
 	}
 
@@ -897,6 +1751,9 @@ dt_column_multiply(
 	if (dest->type != src->type)
 		return DT_TYPE_MISMATCH;
 
+	if (dt_column_materialize(dest) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	switch (dest->type)
 	{
 		case UINT8:
@@ -930,6 +1787,10 @@ dt_column_multiply(
 			_multiply_values_loop(dest, src, double);
 			break;
 		case STRING: // aggregates on strings not supported (at least, for now)
+		case BOOL: // (use dt_column_and/dt_column_or/dt_column_xor)
+			break;
+		case DATE: // scaling dates/timestamps isn't meaningful
+		case TIMESTAMP:
 			break;
 	}
 
@@ -955,6 +1816,9 @@ dt_column_divide(
 	if (dest->type != src->type)
 		return DT_TYPE_MISMATCH;
 
+	if (dt_column_materialize(dest) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	switch (dest->type)
 	{
 		case UINT8:
@@ -988,12 +1852,398 @@ dt_column_divide(
 			_divide_values_loop(dest, src, double);
 			break;
 		case STRING: // aggregates on strings not supported (at least, for now)
+		case BOOL: // (use dt_column_and/dt_column_or/dt_column_xor)
+			break;
+		case DATE: // scaling dates/timestamps isn't meaningful
+		case TIMESTAMP:
+			break;
+	}
+
+	return DT_SUCCESS;
+}
+
+enum __bitwise_op_e
+{
+	__BITWISE_AND,
+	__BITWISE_OR,
+	__BITWISE_XOR
+};
+
+static uint64_t
+__bitwise_apply(
+	const enum __bitwise_op_e op,
+	const uint64_t left,
+	const uint64_t right)
+{
+	switch (op)
+	{
+		case __BITWISE_AND:
+			return left & right;
+		case __BITWISE_OR:
+			return left | right;
+		case __BITWISE_XOR:
+			return left ^ right;
+	}
+
+	return left;
+}
+
+static enum status_code_e
+__bitwise_columns(
+	struct DataColumn* const dest,
+	const struct DataColumn* const src,
+	const enum __bitwise_op_e op)
+{
+	if (dest->n_values != src->n_values)
+		return DT_SIZE_MISMATCH;
+
+	if (dest->type != BOOL || src->type != BOOL)
+		return DT_TYPE_MISMATCH;
+
+	if (dt_column_materialize(dest) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	// dest is word-aligned after materializing; src may be a view starting mid-word
+	size_t i = 0;
+	if (dest->bit_offset == 0 && src->bit_offset == 0)
+	{
+		uint64_t* dest_words = dest->value;
+		const uint64_t* src_words = src->value;
+		for (; i + 64 <= dest->n_values; i += 64)
+			dest_words[i >> 6] = __bitwise_apply(op, dest_words[i >> 6], src_words[i >> 6]);
+	}
+
+	for (; i < dest->n_values; ++i)
+		__set_bit(dest, i, __bitwise_apply(op, __get_bit(dest, i), __get_bit(src, i)));
+
+	return DT_SUCCESS;
+}
+
+enum status_code_e
+dt_column_and(
+	struct DataColumn* const dest,
+	const struct DataColumn* const src)
+{
+	return __bitwise_columns(dest, src, __BITWISE_AND);
+}
+
+enum status_code_e
+dt_column_or(
+	struct DataColumn* const dest,
+	const struct DataColumn* const src)
+{
+	return __bitwise_columns(dest, src, __BITWISE_OR);
+}
+
+enum status_code_e
+dt_column_xor(
+	struct DataColumn* const dest,
+	const struct DataColumn* const src)
+{
+	return __bitwise_columns(dest, src, __BITWISE_XOR);
+}
+
+enum status_code_e
+dt_column_not(
+	struct DataColumn* const column)
+{
+	if (column->type != BOOL)
+		return DT_TYPE_MISMATCH;
+
+	if (dt_column_materialize(column) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	size_t i = 0;
+	if (column->bit_offset == 0)
+	{
+		uint64_t* words = column->value;
+		for (; i + 64 <= column->n_values; i += 64)
+			words[i >> 6] = ~words[i >> 6];
+	}
+
+	for (; i < column->n_values; ++i)
+		__set_bit(column, i, !__get_bit(column, i));
+
+	return DT_SUCCESS;
+}
+
+// [lowercase] must be lowercase
+static bool
+__equals_ignore_case(
+	const char* str,
+	const char* lowercase)
+{
+	for (; *str && *lowercase; ++str, ++lowercase)
+		if (tolower((unsigned char)*str) != *lowercase)
+			return false;
+
+	return *str == *lowercase;
+}
+
+bool
+dt_parse_bool(
+	const char* const str,
+	bool* const value)
+{
+	if (!str)
+		return false;
+
+	if (strcmp(str, "1") == 0 || __equals_ignore_case(str, "true"))
+		*value = true;
+	else if (strcmp(str, "0") == 0 || __equals_ignore_case(str, "false"))
+		*value = false;
+	else
+		return false;
+
+	return true;
+}
+
+// true if the (non-STRING) value at [index] isn't zero
+static bool
+__numeric_is_nonzero(
+	const struct DataColumn* const column,
+	const size_t index)
+{
+	const void* const item = get_index_ptr(column, index);
+	switch (column->type)
+	{
+		case INT8:
+			return *(const int8_t*)item != 0;
+		case INT16:
+			return *(const int16_t*)item != 0;
+		case INT32:
+		case DATE:
+			return *(const int32_t*)item != 0;
+		case INT64:
+		case TIMESTAMP:
+			return *(const int64_t*)item != 0;
+		case UINT8:
+			return *(const uint8_t*)item != 0;
+		case UINT16:
+			return *(const uint16_t*)item != 0;
+		case UINT32:
+			return *(const uint32_t*)item != 0;
+		case UINT64:
+			return *(const uint64_t*)item != 0;
+		case FLOAT:
+			return *(const float*)item != 0;
+		case DOUBLE:
+			return *(const double*)item != 0;
+		case BOOL:
+			return *(const bool*)item;
+		case STRING:
+			break;
+	}
+
+	return false;
+}
+
+// read the (non-STRING) value at [index] as an integer (floating point values are truncated)
+static int64_t
+__get_as_int64(
+	const struct DataColumn* const column,
+	const size_t index)
+{
+	const void* const item = get_index_ptr(column, index);
+	switch (column->type)
+	{
+		case INT8:
+			return *(const int8_t*)item;
+		case INT16:
+			return *(const int16_t*)item;
+		case INT32:
+		case DATE:
+			return *(const int32_t*)item;
+		case INT64:
+		case TIMESTAMP:
+			return *(const int64_t*)item;
+		case UINT8:
+			return *(const uint8_t*)item;
+		case UINT16:
+			return *(const uint16_t*)item;
+		case UINT32:
+			return *(const uint32_t*)item;
+		case UINT64:
+			return (int64_t)*(const uint64_t*)item;
+		case FLOAT:
+			return (int64_t)*(const float*)item;
+		case DOUBLE:
+			return (int64_t)*(const double*)item;
+		case BOOL:
+			return *(const bool*)item;
+		case STRING:
 			break;
 	}
 
+	return 0;
+}
+
+// store an integer at [index] of a (non-STRING) column
+static void
+__set_from_int64(
+	struct DataColumn* const column,
+	const size_t index,
+	const int64_t value)
+{
+	if (column->type == BOOL)
+	{
+		__set_bit(column, index, value != 0);
+		return;
+	}
+
+	void* const item = get_index_ptr(column, index);
+	switch (column->type)
+	{
+		case INT8:
+			*(int8_t*)item = (int8_t)value;
+			break;
+		case INT16:
+			*(int16_t*)item = (int16_t)value;
+			break;
+		case INT32:
+		case DATE:
+			*(int32_t*)item = (int32_t)value;
+			break;
+		case INT64:
+		case TIMESTAMP:
+			*(int64_t*)item = value;
+			break;
+		case UINT8:
+			*(uint8_t*)item = (uint8_t)value;
+			break;
+		case UINT16:
+			*(uint16_t*)item = (uint16_t)value;
+			break;
+		case UINT32:
+			*(uint32_t*)item = (uint32_t)value;
+			break;
+		case UINT64:
+			*(uint64_t*)item = (uint64_t)value;
+			break;
+		case FLOAT:
+			*(float*)item = (float)value;
+			break;
+		case DOUBLE:
+			*(double*)item = (double)value;
+			break;
+		case BOOL:
+		case STRING:
+			break;
+	}
+}
+
+// convert the value at [index] of [column] into the same row of [cast]
+static bool
+__cast_value(
+	const struct DataColumn* const column,
+	const size_t index,
+	struct DataColumn* const cast)
+{
+	const void* const item = get_index_ptr(column, index);
+
+	if (cast->type == STRING)
+	{
+		char buffer[DT_TIMESTAMP_BUFFER_SIZE] = {0};
+		const char* str = buffer;
+		if (column->type == BOOL)
+			str = *(const bool*)item ? "true" : "false";
+		else if (column->type == DATE)
+			dt_format_date(*(const int32_t*)item, buffer);
+		else if (column->type == TIMESTAMP)
+			dt_format_timestamp(*(const int64_t*)item, column->time_unit, buffer);
+		return __copy_value(cast, index, &str);
+	}
+
+	if (column->type == STRING)
+	{
+		// unparseable strings are left as 0 (same as the numeric casts)
+		const char* const str = *(char* const*)item;
+		bool bool_value = false;
+		int32_t date_value = 0;
+		int64_t timestamp_value = 0;
+		if (cast->type == BOOL && dt_parse_bool(str, &bool_value))
+			__set_bit(cast, index, bool_value);
+		else if (cast->type == DATE && dt_parse_date(str, &date_value))
+			__write_value(cast, index, &date_value);
+		else if (cast->type == TIMESTAMP && dt_parse_timestamp(str, cast->time_unit, &timestamp_value))
+			__write_value(cast, index, &timestamp_value);
+		return true;
+	}
+
+	const int64_t per_day = dt_time_unit_per_second(cast->time_unit) * 86400;
+	if (cast->type == BOOL)
+		__set_bit(cast, index, __numeric_is_nonzero(column, index));
+	else if (column->type == DATE && cast->type == TIMESTAMP)
+		__set_from_int64(cast, index, *(const int32_t*)item * per_day);
+	else if (column->type == TIMESTAMP && cast->type == DATE)
+	{
+		// floor division so times before the epoch land on the previous day
+		const int64_t column_per_day = dt_time_unit_per_second(column->time_unit) * 86400;
+		const int64_t value = *(const int64_t*)item;
+		int64_t days = value / column_per_day;
+		if (value % column_per_day < 0)
+			days--;
+		__set_from_int64(cast, index, days);
+	}
+	else
+		__set_from_int64(cast, index, __get_as_int64(column, index));
+
+	return true;
+}
+
+// casts to/from BOOL, DATE and TIMESTAMP don't reuse the buffer in place
+// (bits vs bytes, parsing/formatting), so the values are converted into a
+// new column whose buffer is swapped in.
+// null values keep their indices (and stay zeroed).
+static enum status_code_e
+__cast_column_rebuild(
+	struct DataColumn* const column,
+	const enum data_type_e new_type)
+{
+	struct DataColumn* cast = NULL;
+	if (dt_column_create_with_allocator(&cast, column->n_values, new_type, column->allocator) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	for (size_t i = 0; i < column->n_values; ++i)
+	{
+		if (__is_null_value_index(column, i))
+			continue;
+
+		if (!__cast_value(column, i, cast))
+		{
+			dt_column_free(&cast);
+			return DT_ALLOC_ERROR;
+		}
+	}
+
+	// swap the buffers so freeing [cast] releases the old values
+	struct DataColumn old = *column;
+	column->type = cast->type;
+	column->type_size = cast->type_size;
+	column->value = cast->value;
+	column->value_capacity = cast->value_capacity;
+	column->deallocator = cast->deallocator;
+	column->bit_offset = 0;
+	column->time_unit = cast->time_unit;
+
+	cast->type = old.type;
+	cast->type_size = old.type_size;
+	cast->value = old.value;
+	cast->value_capacity = old.value_capacity;
+	cast->deallocator = old.deallocator;
+	cast->bit_offset = old.bit_offset;
+	dt_column_free(&cast);
+
 	return DT_SUCCESS;
 }
 
+static bool
+__is_rebuild_cast_type(
+	const enum data_type_e type)
+{
+	return type == BOOL || type == DATE || type == TIMESTAMP;
+}
+
 void
 dt_column_cast(
 	struct DataColumn* const column,
@@ -1003,8 +2253,25 @@ dt_column_cast(
 	if (column->type == new_type)
 		return;
 
+	if (dt_column_materialize(column) != DT_SUCCESS)
+		return;
+
+	// the conversions below work on a contiguous buffer,
+	// so chunked columns are temporarily flattened
+	const size_t chunk_size = column->chunk_size;
+	if (chunk_size > 0 && dt_column_make_contiguous(column) != DT_SUCCESS)
+		return;
+
 	enum data_type_e old_type = column->type;
 
+	if (__is_rebuild_cast_type(old_type) || __is_rebuild_cast_type(new_type))
+	{
+		__cast_column_rebuild(column, new_type);
+		if (chunk_size > 0 && new_type != BOOL)
+			dt_column_make_chunked(column, chunk_size);
+		return;
+	}
+
 	// change size but NOT type yet
 	// (this is because if type is string, it will attempt to free
 	// a non-heap allocated address)
@@ -1016,7 +2283,11 @@ dt_column_cast(
 	// larger size pool)
 	// dangerously assuming allocation succeeds, should probably change that
 	if (column->type_size > old_size)
-		column->value = realloc(column->value, column->value_capacity * column->type_size);
+		column->value = dt_aligned_realloc(
+			column->allocator,
+			column->value,
+			column->value_capacity * old_size,
+			column->value_capacity * column->type_size);
 	
 
 	// string -> numeric
@@ -1034,4 +2305,260 @@ dt_column_cast(
 
 	// finally change type after all conversions are done
 	column->type = new_type;
+
+	if (chunk_size > 0)
+		dt_column_make_chunked(column, chunk_size);
+}
+
+enum status_code_e
+dt_column_set_time_unit(
+	struct DataColumn* const column,
+	const enum dt_time_unit_e unit)
+{
+	if (column->type != TIMESTAMP)
+		return DT_TYPE_MISMATCH;
+
+	if (column->time_unit == unit)
+		return DT_SUCCESS;
+
+	if (dt_column_materialize(column) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	const int64_t from = dt_time_unit_per_second(column->time_unit);
+	const int64_t to = dt_time_unit_per_second(unit);
+	for (size_t i = 0; i < column->n_values; ++i)
+	{
+		int64_t* value = get_index_ptr(column, i);
+		if (to > from)
+			*value *= to / from;
+		else
+		{
+			const int64_t scale = from / to;
+			*value = *value / scale - (*value % scale < 0);
+		}
+	}
+
+	column->time_unit = unit;
+
+	return DT_SUCCESS;
+}
+
+// macros to find the range of a contiguous integer column
+#define _signed_range_loop(column, type, lo, hi) \
+	for (size_t i = 0; i < column->n_values; ++i) \
+	{ \
+		const int64_t _value = ((const type*)column->value)[i]; \
+		if (_value < lo) \
+			lo = _value; \
+		if (_value > hi) \
+			hi = _value; \
+	}
+
+#define _unsigned_range_loop(column, type, hi) \
+	for (size_t i = 0; i < column->n_values; ++i) \
+	{ \
+		const uint64_t _value = ((const type*)column->value)[i]; \
+		if (_value > hi) \
+			hi = _value; \
+	}
+
+// narrow every value in place with a single typed loop.
+// the new type is never larger, so value i is always read before it's overwritten
+#define _narrow_loop(column, from_type, to_type) \
+	{ \
+		const from_type* _from = column->value; \
+		to_type* _to = column->value; \
+		for (size_t i = 0; i < column->n_values; ++i) \
+			_to[i] = (to_type)_from[i]; \
+	}
+
+#define _narrow_from(column, from_type, new_type) \
+	switch (new_type) \
+	{ \
+		case INT8: \
+			_narrow_loop(column, from_type, int8_t); \
+			break; \
+		case INT16: \
+			_narrow_loop(column, from_type, int16_t); \
+			break; \
+		case INT32: \
+			_narrow_loop(column, from_type, int32_t); \
+			break; \
+		case UINT8: \
+			_narrow_loop(column, from_type, uint8_t); \
+			break; \
+		case UINT16: \
+			_narrow_loop(column, from_type, uint16_t); \
+			break; \
+		case UINT32: \
+			_narrow_loop(column, from_type, uint32_t); \
+			break; \
+		case FLOAT: \
+			_narrow_loop(column, from_type, float); \
+			break; \
+		case INT64: \
+		case UINT64: \
+		case DOUBLE: \
+		case STRING: \
+		case BOOL: \
+		case DATE: \
+		case TIMESTAMP: \
+			break; \
+	}
+
+// smallest type of the same signedness holding [lo, hi]
+static enum data_type_e
+__narrowest_signed_type(
+	const int64_t lo,
+	const int64_t hi)
+{
+	if (lo >= INT8_MIN && hi <= INT8_MAX)
+		return INT8;
+	if (lo >= INT16_MIN && hi <= INT16_MAX)
+		return INT16;
+	if (lo >= INT32_MIN && hi <= INT32_MAX)
+		return INT32;
+	return INT64;
+}
+
+static enum data_type_e
+__narrowest_unsigned_type(
+	const uint64_t hi)
+{
+	if (hi <= UINT8_MAX)
+		return UINT8;
+	if (hi <= UINT16_MAX)
+		return UINT16;
+	if (hi <= UINT32_MAX)
+		return UINT32;
+	return UINT64;
+}
+
+// the smallest type that holds every value of the (contiguous) column exactly
+static enum data_type_e
+__shrunk_type(
+	const struct DataColumn* const column)
+{
+	int64_t lo = 0;
+	int64_t hi = 0;
+	uint64_t unsigned_hi = 0;
+
+	switch (column->type)
+	{
+		case INT8:
+			return INT8;
+		case INT16:
+			_signed_range_loop(column, int16_t, lo, hi);
+			return __narrowest_signed_type(lo, hi);
+		case INT32:
+			_signed_range_loop(column, int32_t, lo, hi);
+			return __narrowest_signed_type(lo, hi);
+		case INT64:
+			_signed_range_loop(column, int64_t, lo, hi);
+			return __narrowest_signed_type(lo, hi);
+		case UINT8:
+			return UINT8;
+		case UINT16:
+			_unsigned_range_loop(column, uint16_t, unsigned_hi);
+			return __narrowest_unsigned_type(unsigned_hi);
+		case UINT32:
+			_unsigned_range_loop(column, uint32_t, unsigned_hi);
+			return __narrowest_unsigned_type(unsigned_hi);
+		case UINT64:
+			_unsigned_range_loop(column, uint64_t, unsigned_hi);
+			return __narrowest_unsigned_type(unsigned_hi);
+		case DOUBLE:
+		{
+			// NaN never compares equal, so it's checked separately (it round-trips)
+			const double* values = column->value;
+			for (size_t i = 0; i < column->n_values; ++i)
+				if ((double)(float)values[i] != values[i] && values[i] == values[i])
+					return DOUBLE;
+			return FLOAT;
+		}
+		case FLOAT:
+		case STRING:
+		case BOOL:
+		case DATE:
+		case TIMESTAMP:
+			break;
+	}
+
+	return column->type;
+}
+
+enum status_code_e
+dt_column_shrink(
+	struct DataColumn* const column)
+{
+	if (column->n_values == 0)
+		return DT_SUCCESS;
+
+	if (dt_column_materialize(column) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	// the typed loops below work on a contiguous buffer
+	const size_t chunk_size = column->chunk_size;
+	if (chunk_size > 0 && dt_column_make_contiguous(column) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	const enum data_type_e new_type = __shrunk_type(column);
+	if (new_type != column->type)
+	{
+		switch (column->type)
+		{
+			case INT16:
+				_narrow_from(column, int16_t, new_type);
+				break;
+			case INT32:
+				_narrow_from(column, int32_t, new_type);
+				break;
+			case INT64:
+				_narrow_from(column, int64_t, new_type);
+				break;
+			case UINT16:
+				_narrow_from(column, uint16_t, new_type);
+				break;
+			case UINT32:
+				_narrow_from(column, uint32_t, new_type);
+				break;
+			case UINT64:
+				_narrow_from(column, uint64_t, new_type);
+				break;
+			case DOUBLE:
+				_narrow_from(column, double, new_type);
+				break;
+			// never narrowed
+			case INT8:
+			case UINT8:
+			case FLOAT:
+			case STRING:
+			case BOOL:
+			case DATE:
+			case TIMESTAMP:
+				break;
+		}
+
+		// clear what's left of the old values past the end and release the unused part
+		const size_t new_size = dt_type_to_size(new_type);
+		memset(
+			(char*)column->value + column->n_values * new_size,
+			0,
+			(column->value_capacity - column->n_values) * new_size);
+		void* values = dt_aligned_realloc(
+			column->allocator,
+			column->value,
+			column->value_capacity * new_size,
+			column->value_capacity * new_size);
+		if (values)
+			column->value = values;
+
+		column->type = new_type;
+		column->type_size = new_size;
+	}
+
+	if (chunk_size > 0)
+		return dt_column_make_chunked(column, chunk_size);
+
+	return DT_SUCCESS;
 }
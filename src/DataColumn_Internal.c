@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <ctype.h>
 
 /* all the internal functions for DataColumn.c that will be included
  * directly into the source file */
@@ -58,53 +59,75 @@ __reverse_string(
 }
 
 /*
- * a macro that takes creates an array of all the OLD string values
- * in a column, clears the buffer, converts the string into a numeric 
- * and stores the value back into the buffer.
+ * a macro that saves the pointers to all the OLD string values
+ * in a column, clears the buffer, converts the strings (parsed in place
+ * with their lengths) into numerics, stores the values back into the
+ * buffer and frees the strings.
  */
-#define convert_string_to_numeric(column, type_enum, type) \
+#define convert_string_to_numeric(column, type_enum, value_type) \
 	{ \
-	char** old_values = calloc(column->n_values, sizeof(*old_values)); \
-	for (size_t i = 0; i < column->n_values; ++i) \
-		old_values[i] = strdup(*(char**)((char*)column->value + i*sizeof(char**))); \
-	for (size_t i = 0; i < column->n_values; ++i) \
-		free(*(char**)((char*)column->value + i*sizeof(char**))); \
+	char** old_values = dt_alloc(column->allocator, column->n_values * sizeof(*old_values)); \
+	if (!old_values && column->n_values > 0) \
+	{ \
+		/* the column is left untouched (still of strings) */ \
+		column->type = STRING; \
+		column->type_size = dt_type_to_size(STRING); \
+		break; \
+	} \
+	if (old_values) \
+		memcpy(old_values, column->value, column->n_values * sizeof(*old_values)); \
 	memset(column->value, 0, column->value_capacity * column->type_size); \
 	for (size_t i = 0; i < column->n_values; ++i) \
 	{ \
-		char* endptr = NULL; \
-		type new_value; \
+		const char* str = old_values[i] ? old_values[i] : ""; \
+		const size_t length = strlen(str); \
+		value_type new_value = 0; \
 		switch(type_enum) \
 		{ \
 			case DOUBLE: \
-				new_value = strtod(old_values[i], &endptr); \
+			{ \
+				double parsed = 0.0; \
+				dt_parse_double(str, length, &parsed); \
+				new_value = (value_type)parsed; \
 				break; \
+			} \
 			case FLOAT: \
-				new_value = strtof(old_values[i], &endptr); \
+			{ \
+				float parsed = 0.0f; \
+				dt_parse_float(str, length, &parsed); \
+				new_value = (value_type)parsed; \
 				break; \
+			} \
 			case UINT8: \
 			case UINT16: \
 			case UINT32: \
-				new_value = (type)strtoul(old_values[i], &endptr, 10); \
-				break; \
 			case UINT64: \
-				new_value = (type)strtoull(old_values[i], &endptr, 10); \
+			{ \
+				uint64_t parsed = 0; \
+				dt_parse_uint64(str, length, &parsed); \
+				new_value = (value_type)parsed; \
 				break; \
+			} \
 			case INT8: \
 			case INT16: \
 			case INT32: \
-				new_value = (type)strtol(old_values[i], &endptr, 10); \
-				break; \
 			case INT64: \
-				new_value = (type)strtoll(old_values[i], &endptr, 10); \
+			{ \
+				int64_t parsed = 0; \
+				dt_parse_int64(str, length, &parsed); \
+				new_value = (value_type)parsed; \
 				break; \
+			} \
 			case STRING: \
+			case BOOL: \
+			case DATE: \
+			case TIMESTAMP: \
 				break; \
 		} \
 		dt_column_set_value(column, i, &new_value); \
-		free(old_values[i]); \
+		dt_free(column->allocator, old_values[i]); \
 	} \
-	free(old_values); \
+	dt_free(column->allocator, old_values); \
 	column->deallocator = NULL; \
 	}
 
@@ -148,6 +171,9 @@ __cast_column_string_to_numeric(
 			break;
 		// do nothing but ignore compiler warnings
 		case STRING:
+		case BOOL:
+		case DATE:
+		case TIMESTAMP:
 			break;
 	}
 }
@@ -163,19 +189,19 @@ __cast_column_string_to_numeric(
  */
 #define convert_numeric_to_string(column, type) \
 	{ \
-	type* old_values = calloc(column->n_values, sizeof(type)); \
+	type* old_values = dt_calloc(column->allocator, column->n_values, sizeof(type)); \
 	for (size_t i = 0; i < column->n_values; ++i) \
 		old_values[i] = *(type*)((char*)column->value + i*sizeof(type)); \
 	memset(column->value, 0, column->type_size * column->value_capacity); \
 	for (size_t i = 0; i < column->n_values; ++i) \
 	{ \
-		char* numeric_string = calloc(25, sizeof(char)); \
+		char* numeric_string = dt_calloc(column->allocator, 25, sizeof(char)); \
 		integer_to_string(old_values[i], numeric_string); \
 		__reverse_string(numeric_string); \
 		dt_column_set_value(column, i, numeric_string); \
-    free(numeric_string); \
+    dt_free(column->allocator, numeric_string); \
 	} \
-	free(old_values); \
+	dt_free(column->allocator, old_values); \
 	column->deallocator = &dt_string_dealloc; \
 	}
 
@@ -220,31 +246,36 @@ __cast_column_numeric_to_string(
 
 		// do nothing, but here to avoid compiler warning
 		case STRING:
+		case BOOL:
+		case DATE:
+		case TIMESTAMP:
 			break;
 	}
 }
 
 /*
- * a macro that takes creates an array of all the OLD numeric values
- * in a column, clears the buffer, converts the numeric into the other type 
- * and stores the address back into the buffer.
+ * a macro that converts every numeric value to the other type in place
+ * with a single typed loop.
  *
- * note that the buffer is already resized prior to calling this macro
- * (e.g., if moving from a uint8_t to uint64_t, the buffer would need to be
- * larger)
+ * narrowing walks forward and widening walks backward so value i is always
+ * read before anything overwrites it. note that the buffer is already resized
+ * prior to calling this macro (e.g., if moving from a uint8_t to uint64_t,
+ * the buffer would need to be larger)
  */
 #define convert_numeric_to_numeric(column, from_type, to_type) \
 	{ \
-		from_type* old_values = calloc(column->n_values, sizeof(from_type)); \
-		for (size_t i = 0; i < column->n_values; ++i) \
-			old_values[i] = *(from_type*)((char*)column->value + i*sizeof(from_type)); \
-		memset(column->value, 0, column->value_capacity * column->type_size); \
-		for (size_t i = 0; i < column->n_values; ++i) \
-		{ \
-			to_type new_value = (to_type)old_values[i]; \
-			dt_column_set_value(column, i, &new_value); \
-		} \
-		free(old_values); \
+		const from_type* _from = column->value; \
+		to_type* _to = column->value; \
+		if (sizeof(to_type) <= sizeof(from_type)) \
+			for (size_t i = 0; i < column->n_values; ++i) \
+				_to[i] = (to_type)_from[i]; \
+		else \
+			for (size_t i = column->n_values; i-- > 0;) \
+				_to[i] = (to_type)_from[i]; \
+		memset( \
+			(char*)column->value + column->n_values * sizeof(to_type), \
+			0, \
+			(column->value_capacity - column->n_values) * sizeof(to_type)); \
 	} \
 
 static void
@@ -291,6 +322,9 @@ __cast_column_int_to_int(
 					break;
 				// does nothing but ignores compiler warning
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -332,6 +366,9 @@ __cast_column_int_to_int(
 					break;
 				// does nothing but ignores compiler warning
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -373,6 +410,9 @@ __cast_column_int_to_int(
 					break;
 				// does nothing but ignores compiler warning
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -414,6 +454,9 @@ __cast_column_int_to_int(
 					break;
 				// does nothing but ignores compiler warning
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -455,6 +498,9 @@ __cast_column_int_to_int(
 					break;
 				// does nothing but ignores compiler warning
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -496,6 +542,9 @@ __cast_column_int_to_int(
 					break;
 				// does nothing but ignores compiler warning
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -537,6 +586,9 @@ __cast_column_int_to_int(
 					break;
 				// does nothing but ignores compiler warning
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -578,6 +630,9 @@ __cast_column_int_to_int(
 					break;
 				// does nothing but ignores compiler warning
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -619,6 +674,9 @@ __cast_column_int_to_int(
 					break;
 				// does nothing but ignores compiler warning
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -660,6 +718,9 @@ __cast_column_int_to_int(
 					break;
 				// does nothing but ignores compiler warning
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -667,6 +728,9 @@ __cast_column_int_to_int(
 
 		// do nothing but ignores compiler warnings
 		case STRING:
+		case BOOL:
+		case DATE:
+		case TIMESTAMP:
 			break;
 	}	
 }
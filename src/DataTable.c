@@ -1,6 +1,9 @@
 #include "DataTable.h"
 #include "DataColumn.h"
 #include "HashTable.h"
+#include "CsvReader.h"
+#include "CsvWriter.h"
+#include "ArrowInterface.h"
 
 // all internal functions
 #include "DataTable_Internal.c"
@@ -11,14 +14,30 @@ dt_table_create(
 	const char (*column_names)[DT_MAX_COL_LEN],
 	const enum data_type_e* data_types)
 {
-	struct DataTable* table = malloc(sizeof(*table));
+	return dt_table_create_with_allocator(
+		n_columns,
+		column_names,
+		data_types,
+		dt_get_default_allocator());
+}
+
+struct DataTable*
+dt_table_create_with_allocator(
+	const size_t n_columns,
+	const char (*column_names)[DT_MAX_COL_LEN],
+	const enum data_type_e* data_types,
+	const struct dt_allocator* const allocator)
+{
+	struct DataTable* table = dt_alloc(allocator, sizeof(*table));
 	if (!table)
 		return NULL;
 
-	table->columns = malloc(n_columns * sizeof(struct ColumnPair));
+	table->allocator = allocator;
+
+	table->columns = dt_alloc(allocator, n_columns * sizeof(struct ColumnPair));
 	if (!table->columns)
 	{
-		free(table);
+		dt_free(allocator, table);
 		return NULL;
 	}
 
@@ -33,13 +52,13 @@ dt_table_create(
 		};
 
 		strncat(c.name, column_names[i], DT_MAX_COL_LEN);
-		dt_column_create(&c.column, 0, data_types[i]);
+		dt_column_create_with_allocator(&c.column, 0, data_types[i], allocator);
 		if (!c.column)
 		{
 			for (size_t k = 0; k < i; ++k)
-				dt_column_free(&table->columns[i].column);
-			free(table->columns);
-			free(table);
+				dt_column_free(&table->columns[k].column);
+			dt_free(allocator, table->columns);
+			dt_free(allocator, table);
 			return NULL;
 		}
 
@@ -47,6 +66,9 @@ dt_table_create(
 	}
 
 	table->n_rows = 0;
+	table->lazy = NULL;
+	table->mapped = NULL;
+	table->arrow = NULL;
 
 	return table;
 }
@@ -59,13 +81,20 @@ dt_table_free(
 	if (*table == NULL)
 		return;
 
+	const struct dt_allocator* const allocator = (*table)->allocator;
+
+	__free_lazy_csv(*table);
 	for (size_t i = 0; i < (*table)->n_columns; ++i)
 		dt_column_free(&(*table)->columns[i].column);
 
-	free((*table)->columns);
+	dt_free(allocator, (*table)->columns);
 	(*table)->columns = NULL;
 
-	free(*table);
+	// after the columns, which use their buffers
+	__free_mapped_table(*table);
+	__release_imported_arrow(*table);
+
+	dt_free(allocator, *table);
 	*table = NULL;
 }
 
@@ -75,6 +104,9 @@ dt_table_insert_row(
 	size_t n_columns,
 	...)
 {
+	if (__load_columns(table) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	va_list items;
 	va_start(items, n_columns);
 	for (size_t i = 0; i < table->n_columns; ++i)
@@ -94,6 +126,9 @@ dt_table_insert_row_from_array(
 	struct DataTable* const table,
 	void* items)
 {
+	if (__load_columns(table) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	for (size_t i = 0; i < table->n_columns; ++i)
 	{
 		void* value = (char*)items + i*sizeof(void*);
@@ -109,6 +144,104 @@ dt_table_insert_row_from_array(
 	return DT_SUCCESS;
 }
 
+enum status_code_e
+dt_table_reserve(
+	struct DataTable* const table,
+	const size_t n_rows)
+{
+	if (__load_columns(table) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	for (size_t i = 0; i < table->n_columns; ++i)
+		if (dt_column_reserve(table->columns[i].column, n_rows) != DT_SUCCESS)
+			return DT_ALLOC_ERROR;
+
+	return DT_SUCCESS;
+}
+
+enum status_code_e
+dt_table_make_chunked(
+	struct DataTable* const table,
+	const size_t chunk_size)
+{
+	if (chunk_size == 0)
+		return DT_BAD_ARG;
+
+	if (__load_columns(table) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	for (size_t i = 0; i < table->n_columns; ++i)
+	{
+		// BOOL columns stay contiguous (they're already 64x smaller)
+		if (table->columns[i].column->type == BOOL)
+			continue;
+
+		enum status_code_e status = dt_column_make_chunked(table->columns[i].column, chunk_size);
+		if (status != DT_SUCCESS)
+			return status;
+	}
+
+	return DT_SUCCESS;
+}
+
+enum status_code_e
+dt_table_append_rows(
+	struct DataTable* const table,
+	const size_t n_rows,
+	const void* const* const column_buffers,
+	const bool* const* const validity)
+{
+	if (!column_buffers)
+		return DT_BAD_ARG;
+
+	for (size_t i = 0; i < table->n_columns; ++i)
+		if (!column_buffers[i])
+			return DT_BAD_ARG;
+
+	if (n_rows == 0)
+		return DT_SUCCESS;
+
+	if (__load_columns(table) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	// reserve everything up front so a failed allocation doesn't leave
+	// the columns with different lengths. grow geometrically so repeated
+	// small batches stay amortized O(1).
+	for (size_t i = 0; i < table->n_columns; ++i)
+	{
+		struct DataColumn* column = table->columns[i].column;
+		const size_t n_values = column->n_values + n_rows;
+		if (n_values < column->value_capacity)
+			continue;
+
+		// (chunked columns never move their values so they only grow as needed)
+		size_t capacity = n_values;
+		if (column->chunk_size == 0 && capacity < column->value_capacity * 2)
+			capacity = column->value_capacity * 2;
+		if (dt_column_reserve(column, capacity) != DT_SUCCESS)
+			return DT_ALLOC_ERROR;
+	}
+
+	for (size_t i = 0; i < table->n_columns; ++i)
+	{
+		enum status_code_e status = dt_column_append_values(
+			table->columns[i].column,
+			column_buffers[i],
+			n_rows,
+			validity ? validity[i] : NULL);
+		if (status != DT_SUCCESS)
+		{
+			// (e.g. a string couldn't be copied) take back the rows appended so far
+			for (size_t k = 0; k <= i; ++k)
+				__trim_column(table->columns[k].column, table->n_rows);
+			return status;
+		}
+	}
+
+	table->n_rows += n_rows;
+	return DT_SUCCESS;
+}
+
 void
 dt_table_set_value(
 	struct DataTable* const table,
@@ -116,6 +249,7 @@ dt_table_set_value(
 	const size_t column,
 	const void* const value)
 {
+	__load_column(table, column);
 	dt_column_set_value(table->columns[column].column, row, value);
 }
 
@@ -125,6 +259,9 @@ dt_table_get_value(
 	const size_t row,
 	const size_t column)
 {
+	if (__load_column(table, column) != DT_SUCCESS)
+		return NULL;
+
 	return dt_column_get_value_ptr(table->columns[column].column, row);
 }
 
@@ -134,86 +271,100 @@ dt_table_select(
 	const size_t n_columns,
 	const char (*columns)[DT_MAX_COL_LEN])
 {
-	enum data_type_e* types = malloc(n_columns * sizeof(enum data_type_e));
-	if (!types)
-		return NULL;
-
-	size_t* column_indices = calloc(n_columns, sizeof(size_t));
-	if (!column_indices)
-	{
-		free(types);
-		return NULL;
-	}
-
-	struct DataTable* subset = NULL;
-
-	// fetch data types and indices from original data table.
+	// fetch indices from original data table.
 	// this is not "optimized" but data sets will probably be small enough
 	// to where this search method isn't terribly slow (unless you have
 	// tens of thousands of columns which probably isn't likely)
-	size_t current_idx = 0;
+	size_t* column_indices = __get_multiple_column_indices(table, columns, n_columns);
+	if (!column_indices)
+		return NULL;
+
 	for (size_t i = 0; i < n_columns; ++i)
 	{
-		bool found_column = false;
-		// for every provided column, search the original column list
-		// to find the position and type
-		for (size_t k = 0; k < table->n_columns; ++k)
+		if (__load_column(table, column_indices[i]) != DT_SUCCESS)
 		{
-			if (strcmp(columns[i], table->columns[k].name) == 0)
-			{
-				types[current_idx] = table->columns[k].column->type;
-				column_indices[current_idx++] = k;
-				found_column = true;
-				break;
-			}
+			dt_free(table->allocator, column_indices);
+			return NULL;
 		}
-
-		// error if column is not found
-		if (!found_column)
-			goto err;
-	}
-
-	subset = dt_table_create(n_columns, columns, types);
-	if (!subset)
-		goto err;
-	// create copies of each selected column
-	for (size_t i = 0; i < subset->n_columns; ++i)
-	{
-		dt_column_free(&subset->columns[i].column);
-		subset->columns[i].column = dt_column_copy(table->columns[column_indices[i]].column);
-		if (!subset->columns[i].column)
-			goto err;
 	}
 
-	// DONT'T free the newly-created table; skip over "err" label
-	goto cleanup;
-
+	struct DataTable* subset = __create_view_table(
+		table,
+		n_columns,
+		column_indices,
+		0,
+		table->n_rows);
 
-err:
-	if (subset)
-	{
-		dt_table_free(&subset);
-		subset = NULL;
-	}
-cleanup:
-	free(types);
-	free(column_indices);
+	dt_free(table->allocator, column_indices);
 	
 	return subset;
 }
 
+struct DataTable*
+dt_table_slice(
+	const struct DataTable* const table,
+	const size_t offset,
+	const size_t length)
+{
+	if (__load_columns(table) != DT_SUCCESS)
+		return NULL;
+
+	if (offset > table->n_rows)
+		return NULL;
+
+	size_t* column_indices = __generate_range(table->allocator, table->n_columns);
+	if (!column_indices)
+		return NULL;
+
+	// truncate slices that run past the end of the table
+	size_t slice_length = length;
+	if (slice_length > table->n_rows - offset)
+		slice_length = table->n_rows - offset;
+
+	struct DataTable* slice = __create_view_table(
+		table,
+		table->n_columns,
+		column_indices,
+		offset,
+		slice_length);
+
+	dt_free(table->allocator, column_indices);
+
+	return slice;
+}
+
+struct DataTable*
+dt_table_head(
+	const struct DataTable* const table,
+	const size_t n_rows)
+{
+	return dt_table_slice(table, 0, n_rows);
+}
+
+struct DataTable*
+dt_table_tail(
+	const struct DataTable* const table,
+	const size_t n_rows)
+{
+	size_t offset = n_rows > table->n_rows ? 0 : table->n_rows - n_rows;
+	return dt_table_slice(table, offset, n_rows);
+}
+
 struct DataTable*
 dt_table_copy_skeleton(
 	const struct DataTable* const table)
 {
-	char(*col_names)[DT_MAX_COL_LEN] = calloc(table->n_columns, sizeof(*col_names));
+	if (__load_columns(table) != DT_SUCCESS)
+		return NULL;
+
+	char(*col_names)[DT_MAX_COL_LEN] = dt_calloc(table->allocator, table->n_columns, sizeof(*col_names));
 	if (!col_names)
 		return NULL;
 
-	enum data_type_e* data_types = calloc(table->n_columns, sizeof(*data_types));
+	enum data_type_e* data_types = dt_calloc(table->allocator, table->n_columns, sizeof(*data_types));
 	if (!data_types)
 	{
-		free(col_names);
+		dt_free(table->allocator, col_names);
 		return NULL;
 	}
 
@@ -226,13 +377,14 @@ dt_table_copy_skeleton(
 		data_types[i] = table->columns[i].column->type;
 	}
 
-	struct DataTable* skeleton = dt_table_create(
+	struct DataTable* skeleton = dt_table_create_with_allocator(
 		table->n_columns,
 		col_names,
-		data_types);
+		data_types,
+		table->allocator);
 
-	free(col_names);
-	free(data_types);
+	dt_free(table->allocator, col_names);
+	dt_free(table->allocator, data_types);
 
 	return skeleton;
 }
@@ -258,6 +410,9 @@ dt_table_filter_by_index(
 	bool (*filter_callback)(void* item, void* user_data),
   void* user_data)
 {
+	if (__load_columns(table) != DT_SUCCESS)
+		return NULL;
+
 	size_t* filtered_idx = dt_column_filter(
 		table->columns[column_idx].column,
 		filter_callback,
@@ -281,7 +436,44 @@ dt_table_filter_by_index(
 
 	filtered_table->n_rows = filtered_table->columns[0].column->n_values;
 
-	free(filtered_idx);
+	dt_aligned_free(table->allocator, filtered_idx);
+	return filtered_table;
+}
+
+struct DataTable*
+dt_table_filter_by_mask(
+	const struct DataTable* const table,
+	const struct DataColumn* const mask)
+{
+	if (mask->type != BOOL || mask->n_values != table->n_rows)
+		return NULL;
+
+	if (__load_columns(table) != DT_SUCCESS)
+		return NULL;
+
+	struct DataTable* filtered_table = dt_table_copy_skeleton(table);
+	if (!filtered_table)
+		return NULL;
+
+	for (size_t i = 0; i < table->n_columns; ++i)
+	{
+		struct DataColumn* filtered_column = dt_column_subset_by_mask(
+			table->columns[i].column,
+			mask);
+		if (!filtered_column)
+		{
+			dt_table_free(&filtered_table);
+			return NULL;
+		}
+
+		dt_column_free(&filtered_table->columns[i].column);
+		filtered_table->columns[i].column = filtered_column;
+	}
+
+	filtered_table->n_rows = filtered_table->n_columns > 0
+		? filtered_table->columns[0].column->n_values
+		: 0;
+
 	return filtered_table;
 }
 
@@ -293,6 +485,9 @@ dt_table_filter_OR_by_index(
 	bool (**filter_callback)(void* item, void* user_data),
   void* user_data)
 {
+	if (__load_columns(table) != DT_SUCCESS)
+		return NULL;
+
 	return __filter_multiple(
 		table,
 		n_columns,
@@ -310,6 +505,9 @@ dt_table_filter_AND_by_index(
 	bool (**filter_callback)(void* item, void* user_data),
   void* user_data)
 {
+	if (__load_columns(table) != DT_SUCCESS)
+		return NULL;
+
 	return __filter_multiple(
 		table,
 		n_columns,
@@ -338,7 +536,7 @@ dt_table_filter_OR_by_name(
 		filter_callback,
     user_data);
 
-	free(column_indices);
+	dt_free(table->allocator, column_indices);
 	return filtered;
 }
 
@@ -361,7 +559,7 @@ dt_table_filter_AND_by_name(
 		filter_callback,
     user_data);
 
-	free(column_indices);
+	dt_free(table->allocator, column_indices);
 	return filtered;
 }
 
@@ -384,7 +582,7 @@ dt_table_get_column_ptr_by_index(
 	const struct DataTable* const table,
 	const size_t column_idx)
 {
-	if (column_idx >= table->n_columns)
+	if (column_idx >= table->n_columns || __load_column(table, column_idx) != DT_SUCCESS)
 		return NULL;
 
 	return table->columns[column_idx].column;
@@ -394,6 +592,9 @@ struct DataTable*
 dt_table_copy(
 	const struct DataTable* const table)
 {
+	if (__load_columns(table) != DT_SUCCESS)
+		return NULL;
+
 	struct DataTable* copy = dt_table_copy_skeleton(table);
 	if (!copy)
 		return NULL;
@@ -423,6 +624,9 @@ dt_table_append_by_row(
 	struct DataTable* const dest,
 	const struct DataTable* const src)
 {
+	if (__load_columns(dest) != DT_SUCCESS || __load_columns(src) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	if (dest->n_columns != src->n_columns)
 		return DT_SIZE_MISMATCH;
 
@@ -500,6 +704,9 @@ enum status_code_e
 dt_table_insert_empty_row(
 	struct DataTable* const table)
 {
+	if (__load_columns(table) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	for (size_t i = 0; i < table->n_columns; ++i)
 	{
 		enum status_code_e status = dt_column_append_value(table->columns[i].column, NULL);
@@ -515,6 +722,9 @@ struct DataTable*
 dt_table_distinct(
 	const struct DataTable* table)
 {
+	if (__load_columns(table) != DT_SUCCESS)
+		return NULL;
+
 	struct DataTable* distinct = dt_table_copy_skeleton(table);
 
 	if (!distinct)
@@ -522,7 +732,7 @@ dt_table_distinct(
 
 	struct HashTable* htable = hash_create(table, false, NULL, 0);
 
-  size_t* table_column_indices = __generate_range(table->n_columns);
+  size_t* table_column_indices = __generate_range(table->allocator, table->n_columns);
 
 	for (size_t i = 0; i < table->n_rows; ++i)
 	{
@@ -532,14 +742,14 @@ dt_table_distinct(
 			{
 				hash_free(&htable);
 				dt_table_free(&distinct);
-        free(table_column_indices);
+        dt_free(table->allocator, table_column_indices);
 				return NULL;
 			}
 			hash_insert(htable, i);
 		}
 	}
 
-  free(table_column_indices);
+  dt_free(table->allocator, table_column_indices);
 	hash_free(&htable);
 	return distinct;
 }
@@ -564,7 +774,11 @@ dt_table_insert_column(
 
 	if (table->n_columns == table->column_capacity)
 	{
-		void* alloc = realloc(table->columns, (table->column_capacity + 1) * sizeof(*table->columns));
+		void* alloc = dt_realloc(
+			table->allocator,
+			table->columns,
+			table->column_capacity * sizeof(*table->columns),
+			(table->column_capacity + 1) * sizeof(*table->columns));
 		if (!alloc)
 			return DT_ALLOC_ERROR;
 		table->columns = alloc;
@@ -594,7 +808,7 @@ dt_table_drop_columns_by_name(
 
 	dt_table_drop_columns_by_index(table, n_columns, column_indices);
 
-	free(column_indices);
+	dt_free(table->allocator, column_indices);
 	return DT_SUCCESS;
 	
 }
@@ -625,6 +839,8 @@ dt_table_drop_columns_by_index(
   qsort(column_indices, n_columns, sizeof(size_t), &size_t_compare);
 	for (size_t i = 0; i < n_columns; ++i)
   {
+		// columns that weren't parsed yet never will be
+		__forget_lazy_column(table, table->columns[column_indices[i] - n_dropped_columns].column);
 		__drop_column(table, column_indices[i] - n_dropped_columns);	
     n_dropped_columns++;
   }
@@ -636,6 +852,9 @@ void
 dt_table_drop_columns_with_null(
 	struct DataTable* table)
 {
+	if (__load_columns(table) != DT_SUCCESS)
+		return;
+
 	for (size_t i = 0; i < table->n_columns; ++i)
 		if (table->columns[i].column->n_null_values > 0)
 			__drop_column(table, i);
@@ -645,6 +864,9 @@ enum status_code_e
 dt_table_drop_rows_with_null(
 	struct DataTable* table)
 {
+	if (__load_columns(table) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	size_t n_null_columns = 0;
 	size_t* null_column_indices = __get_null_column_indices(table, &n_null_columns);	
 	if (!null_column_indices)
@@ -663,8 +885,8 @@ dt_table_drop_rows_with_null(
 		table->columns[i].column = subset;
 	}
 
-	free(null_row_indices);
-	free(null_column_indices);
+	dt_free(table->allocator, null_row_indices);
+	dt_free(table->allocator, null_column_indices);
 
 	table->n_rows = table->columns[0].column->n_values;
 
@@ -688,10 +910,15 @@ dt_table_apply_column(
 	if (is_error)
 		return DT_FAILURE;
 
+	// callback writes directly into the column buffer
+	if (__load_column(table, apply_column_index) != DT_SUCCESS
+			|| dt_column_materialize(table->columns[apply_column_index].column) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	// create array of pointers to each column
 	void** column_values = NULL;
 	if (n_column_values > 0)
-		column_values = malloc(sizeof(void*) * n_column_values);
+		column_values = dt_alloc(table->allocator, sizeof(void*) * n_column_values);
 
 	if (!column_values)
 		return DT_ALLOC_ERROR;
@@ -700,10 +927,15 @@ dt_table_apply_column(
 
 	if (!column_value_indices)
 	{
-		free(column_values);
+		dt_free(table->allocator, column_values);
 		return DT_FAILURE;
 	}
 
+	// clear any null values: every value is set by the callback
+	struct DataColumn* column = dt_table_get_column_ptr_by_index(table, apply_column_index);
+	memset(column->null_value_indices, 0, column->n_null_values * sizeof(size_t));
+	column->n_null_values = 0;
+
 	// iterate each row and call user-defined callback
 	for (size_t i = 0; i < table->n_rows; ++i)
 	{
@@ -724,17 +956,21 @@ dt_table_apply_column(
 		// pointer directly WILL NOT update NULL value counts. Here we
 		// are doing it because we clear all NULL values at the end of
 		// the function.
+		// BOOL values are bits, the callback gets a copy which is written back
+		if (column->type == BOOL)
+		{
+			bool current_row_bool = *(const bool*)dt_column_get_value_ptr(column, i);
+			callback(&current_row_bool, user_data, (const void** const)column_values);
+			dt_column_set_value(column, i, &current_row_bool);
+			continue;
+		}
+
 		void* current_row_value = (void*)dt_table_get_value(table, i, apply_column_index);
 		callback(current_row_value, user_data, (const void** const)column_values);
 	}
 
-	free(column_value_indices);
-	free(column_values);
-
-	// clear any null values after applying function
-	struct DataColumn* column = dt_table_get_column_ptr_by_index(table, apply_column_index);
-	memset(column->null_value_indices, 0, column->n_null_values * sizeof(size_t));
-	column->n_null_values = 0;
+	dt_free(table->allocator, column_value_indices);
+	dt_free(table->allocator, column_values);
 
 	return DT_SUCCESS;
 }
@@ -745,24 +981,38 @@ dt_table_apply_all(
 	void (*callback)(void* current_cell_value, void* user_data),
 	void* user_data)
 {
+	if (__load_columns(table) != DT_SUCCESS)
+		return;
+
 	for (size_t c = 0; c < table->n_columns; ++c)
 	{
+		// callback writes directly into the column buffer
+		struct DataColumn* column = dt_table_get_column_ptr_by_index(table, c);
+		if (dt_column_materialize(column) != DT_SUCCESS)
+			return;
+
+		// reset the NULL value count: every value is set by the callback
+		memset(column->null_value_indices, 0, column->n_null_values * sizeof(size_t));
+		column->n_null_values = 0;
+
+		// BOOL values are bits, the callback gets a copy which is written back
+		if (column->type == BOOL)
+		{
+			for (size_t r = 0; r < table->n_rows; ++r)
+			{
+				bool value = *(const bool*)dt_column_get_value_ptr(column, r);
+				callback(&value, user_data);
+				dt_column_set_value(column, r, &value);
+			}
+			continue;
+		}
+
 		for (size_t r = 0; r < table->n_rows; ++r)
 		{
 			void* value = (void*)dt_table_get_value(table, r, c);
 			callback(value, user_data);
 		}
 	}
-
-	// reset all NULL value counts in each column
-	for (size_t i = 0; i < table->n_columns; ++i)
-	{
-		struct DataColumn* column = dt_table_get_column_ptr_by_index(table, i);
-		memset(column->null_value_indices, 0, column->n_null_values * sizeof(size_t));
-		column->n_null_values = 0;
-	}
-	
-
 }
 
 enum status_code_e
@@ -855,6 +1105,9 @@ dt_table_sample_rows(
 	const size_t n_samples,
 	const bool with_replacement)
 {
+	if (__load_columns(table) != DT_SUCCESS)
+		return NULL;
+
 	if (with_replacement)
 		return __sample_with_replacement(table, n_samples);
 
@@ -878,6 +1131,9 @@ dt_table_split(
 	if (*split1 != NULL || *split2 != NULL)
 		return DT_BAD_ARG;
 
+	if (__load_columns(table) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	size_t n_samples = (size_t)(proportion * table->n_rows);
 	
 	
@@ -893,7 +1149,7 @@ dt_table_split(
 		return DT_ALLOC_ERROR;
 	}
 
-  size_t* table_column_indices = __generate_range(table->n_columns);
+  size_t* table_column_indices = __generate_range(table->allocator, table->n_columns);
 
 	// sample split1 (creating hash table to record which records were used)
 	size_t sampled_rows = 0;
@@ -927,7 +1183,7 @@ dt_table_split(
 		}
 	}
 
-  free(table_column_indices);
+  dt_free(table->allocator, table_column_indices);
 	hash_free(&htable);
 
 	return DT_SUCCESS;
@@ -939,46 +1195,213 @@ dt_table_read_csv(
 	const char delim,
 	const enum data_type_e* const column_types)
 {
-	FILE* csv_file = fopen(filepath, "r");
-	if (!csv_file)
+	struct dt_csv_options options;
+	dt_csv_options_init(&options);
+	options.delim = delim;
+	options.column_types = column_types;
+
+	return dt_table_read_csv_with_options(filepath, &options);
+}
+
+void
+dt_csv_options_init(
+	struct dt_csv_options* const options)
+{
+	options->delim = ',';
+	options->column_types = NULL;
+	options->shrink = false;
+	options->n_threads = 0;
+	options->n_inference_rows = DT_CSV_DEFAULT_INFERENCE_ROWS;
+	options->columns = NULL;
+	options->n_columns = 0;
+	options->n_filters = 0;
+	options->filter_columns = NULL;
+	options->filter_callbacks = NULL;
+	options->filter_user_data = NULL;
+	options->lazy = false;
+}
+
+enum status_code_e
+dt_table_load_columns(
+	struct DataTable* const table)
+{
+	return __load_columns(table);
+}
+
+struct DataTable*
+dt_table_read_csv_with_options(
+	const char* const filepath,
+	const struct dt_csv_options* const options)
+{
+	const char delim = options->delim;
+	const enum data_type_e* const column_types = options->column_types;
+
+	struct dt_csv_source source;
+	if (dt_csv_source_open(filepath, &source) != DT_SUCCESS)
 		return NULL;
 
+	struct dt_csv_record record;
+	dt_csv_record_init(&record, dt_get_default_allocator());
+	size_t position = 0;
+	struct DataTable* table = NULL;
+	struct __csv_layout layout = { 0 };
+
 	// create table skeleton after reading header line
-	struct DataTable* table = __parse_header_from_csv(csv_file, delim);
+	struct DataTable* header = __parse_header_from_csv(&source, delim, &position, &record);
+	if (!header)
+		goto cleanup;
+
+	if (__init_csv_layout(header, options, &layout) != DT_SUCCESS)
+	{
+		dt_table_free(&header);
+		goto cleanup;
+	}
+
+	table = __select_csv_columns(header, options);
 	if (!table)
+		goto cleanup;
+
+	enum status_code_e status = DT_SUCCESS;
+	if (options->lazy)
+		status = __read_lazy_csv(&source, delim, position, table, &layout, options);
+	else
 	{
-		fclose(csv_file);
+		const size_t n_chunks = __csv_chunk_count(options->n_threads, source.size - position);
+		status = __read_csv_records(
+				&source,
+				delim,
+				position,
+				table,
+				&layout,
+				column_types,
+				options->n_inference_rows,
+				n_chunks);
+
+		if (status == DT_SUCCESS && !column_types && options->shrink)
+			status = dt_table_shrink(table);
+	}
+
+	if (status != DT_SUCCESS)
+		dt_table_free(&table);
+
+cleanup:
+	__free_csv_layout(&layout, record.allocator);
+	dt_csv_record_free(&record);
+	dt_csv_source_close(&source);
+
+	return table;
+}
+
+struct dt_csv_reader*
+dt_csv_reader_open(
+	const char* const filepath,
+	const struct dt_csv_options* const options)
+{
+	const struct dt_allocator* const allocator = dt_get_default_allocator();
+	struct dt_csv_reader* reader = dt_calloc(allocator, 1, sizeof(*reader));
+	if (!reader)
+		return NULL;
+
+	if (dt_csv_stream_open(filepath, &reader->stream) != DT_SUCCESS)
+	{
+		dt_csv_stream_close(&reader->stream);
+		dt_free(allocator, reader);
 		return NULL;
 	}
 
+	reader->chunk.source = &reader->stream.window;
+	reader->chunk.delim = options->delim;
+	reader->chunk.status = DT_SUCCESS;
+	dt_csv_record_init(&reader->chunk.record, allocator);
+
+	// the whole input can't be looked at before the first batch
+	const size_t n_inference_rows = options->n_inference_rows > 0
+		? options->n_inference_rows
+		: DT_CSV_DEFAULT_INFERENCE_ROWS;
+	reader->status = __read_csv_schema(reader, options, n_inference_rows);
+	if (reader->status != DT_SUCCESS)
+		dt_csv_reader_close(&reader);
 
-	__parse_body_from_csv(csv_file, delim, table);
+	return reader;
+}
+
+struct DataTable*
+dt_csv_reader_next(
+	struct dt_csv_reader* const reader,
+	const size_t max_rows)
+{
+	if (reader->status != DT_SUCCESS || max_rows == 0)
+		return NULL;
 
-	// if passing custom column types, can change them from the default string
-	// type and parse body with type conversion
-	if (column_types)
+	struct DataTable* table = dt_table_copy_skeleton(reader->skeleton);
+	if (!table)
 	{
-		for (size_t i = 0; i < table->n_columns; ++i)
+		reader->status = DT_ALLOC_ERROR;
+		return NULL;
+	}
+
+	reader->chunk.table = table;
+	reader->chunk.status = DT_SUCCESS;
+	while (table->n_rows < max_rows)
+	{
+		bool has_record = false;
+		reader->status = __next_streamed_csv_record(reader, &reader->position, &has_record);
+		if (reader->status != DT_SUCCESS || !has_record)
+			break;
+
+		if (!__append_csv_record(&reader->chunk))
 		{
-			table->columns[i].column->type = column_types[i];
-			table->columns[i].column->type_size = dt_type_to_size(column_types[i]);
+			reader->status = reader->chunk.status;
+			break;
 		}
-		__convert_csv_column_types_from_string(table);
 	}
-	// infer column types if they're not provided by the user
-	else
-		__infer_csv_types(table);
+	reader->chunk.table = NULL;
+
+	if (reader->status != DT_SUCCESS || table->n_rows == 0)
+		dt_table_free(&table);
 
-  fclose(csv_file);
-	
 	return table;
 }
 
+enum status_code_e
+dt_csv_reader_status(
+	const struct dt_csv_reader* const reader)
+{
+	return reader->status;
+}
+
+const struct DataTable*
+dt_csv_reader_schema(
+	const struct dt_csv_reader* const reader)
+{
+	return reader->skeleton;
+}
+
+void
+dt_csv_reader_close(
+	struct dt_csv_reader** reader)
+{
+	const struct dt_allocator* const allocator = (*reader)->chunk.record.allocator;
+
+	if ((*reader)->skeleton)
+		dt_table_free(&(*reader)->skeleton);
+	__free_csv_layout(&(*reader)->layout, allocator);
+	dt_csv_record_free(&(*reader)->chunk.record);
+	dt_free(allocator, (*reader)->chunk.value);
+	dt_csv_stream_close(&(*reader)->stream);
+
+	dt_free(allocator, *reader);
+	*reader = NULL;
+}
+
 enum status_code_e
 dt_table_append_by_column(
 	struct DataTable* const dest,
 	const struct DataTable* const src)
 {
+	if (__load_columns(dest) != DT_SUCCESS || __load_columns(src) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
 	for (size_t i = 0; i < src->n_columns; ++i)
 	{
 		enum status_code_e status = dt_table_insert_column(
@@ -1026,12 +1449,29 @@ dt_table_cast_columns(
 		if (is_error)
 			return DT_COLUMN_NOT_FOUND;
 
+		if (__load_column(table, column_idx) != DT_SUCCESS)
+			return DT_ALLOC_ERROR;
+
 		dt_column_cast(table->columns[column_idx].column, new_column_types[i]);
 	}
 
 	return DT_SUCCESS;
 }
 
+enum status_code_e
+dt_table_shrink(
+	struct DataTable* const table)
+{
+	if (__load_columns(table) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	for (size_t i = 0; i < table->n_columns; ++i)
+		if (dt_column_shrink(table->columns[i].column) != DT_SUCCESS)
+			return DT_ALLOC_ERROR;
+
+	return DT_SUCCESS;
+}
+
 static struct DataTable*
 __dt_setup_join(
   const struct DataTable* const left_table,
@@ -1063,11 +1503,11 @@ __dt_setup_join(
   if (!*right_table_hash)
     goto cleanup;
 
-  combined_columns = calloc(left_table->n_columns + right_table->n_columns, sizeof(*combined_columns));
+  combined_columns = dt_calloc(left_table->allocator, left_table->n_columns + right_table->n_columns, sizeof(*combined_columns));
   if (!combined_columns)
     goto cleanup;
 
-  combined_types = calloc(left_table->n_columns + right_table->n_columns, sizeof(*combined_types));
+  combined_types = dt_calloc(left_table->allocator, left_table->n_columns + right_table->n_columns, sizeof(*combined_types));
   if (!combined_types)
     goto cleanup;
 
@@ -1083,12 +1523,17 @@ __dt_setup_join(
     memcpy(combined_columns[i], right_table->columns[i - left_table->n_columns].name, DT_MAX_COL_LEN);
   }
 
-  join_table = dt_table_create(left_table->n_columns + right_table->n_columns, combined_columns, combined_types);
+  // the joined table (and its scratch memory) uses the left table's allocator
+  join_table = dt_table_create_with_allocator(
+      left_table->n_columns + right_table->n_columns,
+      combined_columns,
+      combined_types,
+      left_table->allocator);
   if (!join_table)
     goto cleanup;
 
-  free(combined_columns);
-  free(combined_types);
+  dt_free(left_table->allocator, combined_columns);
+  dt_free(left_table->allocator, combined_types);
 
   goto success;
 
@@ -1147,6 +1592,9 @@ dt_table_join_inner(
   if (!left_table || !right_table)
     return NULL;
 
+  if (__load_columns(left_table) != DT_SUCCESS || __load_columns(right_table) != DT_SUCCESS)
+    return NULL;
+
   size_t* left_table_indices = NULL;
   size_t* right_table_indices = NULL;
   struct HashTable* left_table_hash = NULL;
@@ -1202,6 +1650,9 @@ dt_table_join_left(
   if (!left_table || !right_table)
     return NULL;
 
+  if (__load_columns(left_table) != DT_SUCCESS || __load_columns(right_table) != DT_SUCCESS)
+    return NULL;
+
   size_t* left_table_indices = NULL;
   size_t* right_table_indices = NULL;
   struct HashTable* left_table_hash = NULL;
@@ -1268,6 +1719,9 @@ dt_table_join_right(
   if (!left_table || !right_table)
     return NULL;
 
+  if (__load_columns(left_table) != DT_SUCCESS || __load_columns(right_table) != DT_SUCCESS)
+    return NULL;
+
   size_t* left_table_indices = NULL;
   size_t* right_table_indices = NULL;
   struct HashTable* left_table_hash = NULL;
@@ -1334,6 +1788,9 @@ dt_table_join_full(
   if (!left_table || !right_table)
     return NULL;
 
+  if (__load_columns(left_table) != DT_SUCCESS || __load_columns(right_table) != DT_SUCCESS)
+    return NULL;
+
   struct DataTable* left_join 
     = dt_table_join_left(left_table, right_table, n_join_columns, join_columns);
 
@@ -1367,6 +1824,9 @@ dt_table_check_isnull(
   const size_t row_idx,
   const size_t col_idx)
 {
+  if (__load_column(table, col_idx) != DT_SUCCESS)
+    return false;
+
   struct DataColumn* column = table->columns[col_idx].column;
   for (size_t i = 0; i < column->n_null_values; ++i)
     if (column->null_value_indices[i] == row_idx)
@@ -1392,6 +1852,9 @@ dt_table_column_contains_null(
   const struct DataTable* const table,
   const size_t col_idx)
 {
+  if (__load_column(table, col_idx) != DT_SUCCESS)
+    return false;
+
   struct DataColumn* column = table->columns[col_idx].column;
   return column->n_null_values > 0;
 }
@@ -1402,40 +1865,235 @@ dt_table_to_csv(
   const char* const filepath,
   const char delim)
 {
-  FILE* csv_file = fopen(filepath, "w+");
-  char* err_msg = "Warning: couldn't write table to file: %s\n";
+  struct dt_csv_write_options options;
+  dt_csv_write_options_init(&options);
+  options.delim = delim;
+  return dt_table_to_csv_with_options(table, filepath, &options);
+}
 
-  if (!csv_file)
-  {
-    printf(err_msg, filepath);
-    return false;
-  }
+void
+dt_csv_write_options_init(
+	struct dt_csv_write_options* const options)
+{
+	options->delim = ',';
+	options->n_threads = 0;
+	options->append = false;
+	options->sync = false;
+}
 
-  char write_buffer[4096] = {0};
+bool
+dt_table_to_csv_with_options(
+	const struct DataTable* const table,
+	const char* const filepath,
+	const struct dt_csv_write_options* const options)
+{
+	if (__load_columns(table) != DT_SUCCESS)
+		return false;
 
-  // buffer size is one length less to append a \n character at the end of the buffer
-  __table_headers_to_string(table, write_buffer, 4095, delim);
-  strncat(write_buffer, "\n", 1);
-  size_t write_len = strlen(write_buffer);
-  if (fwrite(write_buffer, sizeof(char), write_len, csv_file) < write_len)
-  {
-    fclose(csv_file);
-    return false;
-  }
+	// compressed when the name ends with .gz or .zst
+	struct dt_csv_output output;
+	char* err_msg = "Warning: couldn't write table to file: %s\n";
 
-  // write body
-  for (size_t i = 0; i < table->n_rows; ++i)
-  {
-    __table_row_to_string(table, i, write_buffer, 4095, delim);
-    strncat(write_buffer, "\n", 1);
-    write_len = strlen(write_buffer);
-    if (fwrite(write_buffer, sizeof(char), write_len, csv_file) < write_len)
-    {
-      fclose(csv_file);
-      return false;
-    }
-  }
+	if (dt_csv_output_open(filepath, options->append, &output) != DT_SUCCESS)
+	{
+		printf(err_msg, filepath);
+		return false;
+	}
+
+	enum status_code_e status = __write_csv_table(table, &output, options->delim, options->n_threads, output.is_empty);
+	if (status == DT_SUCCESS && options->sync)
+		status = dt_csv_output_sync(&output);
+
+	return dt_csv_output_close(&output) == DT_SUCCESS && status == DT_SUCCESS;
+}
+
+struct dt_csv_writer*
+dt_csv_writer_open(
+	const char* const filepath,
+	const struct DataTable* const schema,
+	const struct dt_csv_write_options* const options)
+{
+	const struct dt_allocator* const allocator = dt_get_default_allocator();
+	struct dt_csv_writer* writer = dt_calloc(allocator, 1, sizeof(*writer));
+	if (!writer)
+		return NULL;
+
+	writer->writer.output = &writer->output;
+	writer->writer.capacity = DT_CSV_WRITE_BUFFER_SIZE;
+	writer->writer.allocator = allocator;
+	writer->writer.delim = options->delim;
+	writer->writer.status = DT_SUCCESS;
+	writer->n_threads = options->n_threads;
+	writer->sync = options->sync;
+
+	writer->writer.buffer = dt_alloc(allocator, DT_CSV_WRITE_BUFFER_SIZE);
+	writer->skeleton = dt_table_copy_skeleton(schema);
+	if (!writer->writer.buffer || !writer->skeleton)
+	{
+		dt_free(allocator, writer->writer.buffer);
+		if (writer->skeleton)
+			dt_table_free(&writer->skeleton);
+		dt_free(allocator, writer);
+		return NULL;
+	}
+
+	if (dt_csv_output_open(filepath, options->append, &writer->output) != DT_SUCCESS)
+	{
+		dt_csv_writer_close(&writer);
+		return NULL;
+	}
+
+	if (writer->output.is_empty)
+		__write_csv_header(&writer->writer, writer->skeleton);
+
+	return writer;
+}
+
+enum status_code_e
+dt_csv_writer_write_batch(
+	struct dt_csv_writer* const writer,
+	const struct DataTable* const batch)
+{
+	if (writer->writer.status != DT_SUCCESS)
+		return writer->writer.status;
+
+	const enum status_code_e status = __check_csv_batch(writer->skeleton, batch);
+	if (status != DT_SUCCESS)
+		return status;
+
+	if (__load_columns(batch) != DT_SUCCESS)
+	{
+		writer->writer.status = DT_ALLOC_ERROR;
+		return writer->writer.status;
+	}
+
+	__write_csv_body(&writer->writer, batch, writer->n_threads);
+	if (writer->sync)
+	{
+		__flush_csv_writer(&writer->writer);
+		if (writer->writer.status == DT_SUCCESS)
+			writer->writer.status = dt_csv_output_sync(&writer->output);
+	}
+
+	return writer->writer.status;
+}
+
+enum status_code_e
+dt_csv_writer_close(
+	struct dt_csv_writer** writer)
+{
+	const struct dt_allocator* const allocator = (*writer)->writer.allocator;
+	enum status_code_e status = DT_SUCCESS;
+
+	if ((*writer)->output.file)
+	{
+		__flush_csv_writer(&(*writer)->writer);
+		status = (*writer)->writer.status;
+		if (status == DT_SUCCESS && (*writer)->sync)
+			status = dt_csv_output_sync(&(*writer)->output);
+		if (dt_csv_output_close(&(*writer)->output) != DT_SUCCESS && status == DT_SUCCESS)
+			status = DT_FAILURE;
+	}
+
+	if ((*writer)->skeleton)
+		dt_table_free(&(*writer)->skeleton);
+	dt_free(allocator, (*writer)->writer.buffer);
+
+	dt_free(allocator, *writer);
+	*writer = NULL;
+
+	return status;
+}
+
+enum status_code_e
+dt_table_save(
+	const struct DataTable* const table,
+	const char* const filepath)
+{
+	if (__load_columns(table) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	struct __table_file_column* descriptors = dt_calloc(table->allocator, table->n_columns + 1, sizeof(*descriptors));
+	if (!descriptors)
+		return DT_ALLOC_ERROR;
+
+	FILE* file = fopen(filepath, "wb");
+	if (!file)
+	{
+		dt_free(table->allocator, descriptors);
+		return DT_FAILURE;
+	}
+
+	enum status_code_e status = __write_table_file_contents(table, file, descriptors);
+	if (fclose(file) != 0 && status == DT_SUCCESS)
+		status = DT_FAILURE;
+
+	dt_free(table->allocator, descriptors);
+	return status;
+}
 
-  fclose(csv_file);
-  return true;
+struct DataTable*
+dt_table_load(
+	const char* const filepath)
+{
+	const struct dt_allocator* const allocator = dt_get_default_allocator();
+	struct dt_mapped_table* mapped = dt_calloc(allocator, 1, sizeof(*mapped));
+	if (!mapped)
+		return NULL;
+
+	if (dt_csv_source_open(filepath, &mapped->source) != DT_SUCCESS)
+	{
+		dt_free(allocator, mapped);
+		return NULL;
+	}
+
+	// the header and the column descriptors must be complete, then every column
+	const char* const data = mapped->source.data;
+	const uint64_t file_size = mapped->source.size;
+	const struct __table_file_header* const header = (const struct __table_file_header*)data;
+	const struct __table_file_column* const descriptors = (const struct __table_file_column*)(header + 1);
+	bool is_valid = file_size >= sizeof(*header)
+		&& memcmp(header->magic, DT_TABLE_FILE_MAGIC, sizeof(header->magic)) == 0
+		&& header->version == DT_TABLE_FILE_VERSION
+		&& header->byte_order == DT_TABLE_FILE_BYTE_ORDER
+		&& header->file_size == file_size
+		&& header->n_columns <= (file_size - sizeof(*header)) / sizeof(*descriptors);
+
+	for (size_t i = 0; is_valid && i < header->n_columns; ++i)
+		is_valid = __is_table_file_column(data, file_size, header->n_rows, &descriptors[i]);
+
+	struct DataTable* table = is_valid ? dt_calloc(allocator, 1, sizeof(*table)) : NULL;
+	if (!table)
+	{
+		dt_csv_source_close(&mapped->source);
+		dt_free(allocator, mapped);
+		return NULL;
+	}
+
+	table->allocator = allocator;
+	table->mapped = mapped;
+	table->n_rows = header->n_rows;
+	table->column_capacity = header->n_columns;
+	table->columns = dt_calloc(allocator, header->n_columns + 1, sizeof(struct ColumnPair));
+	mapped->strings = dt_calloc(allocator, header->n_columns + 1, sizeof(char**));
+	if (!table->columns || !mapped->strings)
+	{
+		dt_table_free(&table);
+		return NULL;
+	}
+
+	for (size_t i = 0; i < header->n_columns; ++i)
+	{
+		struct ColumnPair* const pair = &table->columns[i];
+		strncat(pair->name, descriptors[i].name, DT_MAX_COL_LEN - 1);
+		pair->column = __wrap_table_file_column(table, &descriptors[i]);
+		if (!pair->column)
+		{
+			dt_table_free(&table);
+			return NULL;
+		}
+		table->n_columns++;
+	}
+
+	return table;
 }
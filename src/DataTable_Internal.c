@@ -8,11 +8,17 @@
 #include <time.h>
 #include <ctype.h>
 
+#ifdef DT_HAVE_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 static size_t*
 __generate_range(
+  const struct dt_allocator* const allocator,
   const size_t upper_bound_exclusive)
 {
-  size_t* values = calloc(upper_bound_exclusive, sizeof(size_t));
+  size_t* values = dt_calloc(allocator, upper_bound_exclusive, sizeof(size_t));
   if (!values)
     return NULL;
 
@@ -50,7 +56,7 @@ __get_multiple_column_indices(
 	const char (*column_names)[DT_MAX_COL_LEN],
 	const size_t n_columns)
 {
-	size_t* column_indices = calloc(n_columns, sizeof(size_t));
+	size_t* column_indices = dt_calloc(table->allocator, n_columns, sizeof(size_t));
 	if (!column_indices)
 		return NULL;
 
@@ -60,7 +66,7 @@ __get_multiple_column_indices(
 		column_indices[i] = __get_column_index(table, column_names[i], &is_error);
 		if (is_error)
 		{
-			free(column_indices);
+			dt_free(table->allocator, column_indices);
 			return NULL;
 		}
 	}
@@ -68,16 +74,67 @@ __get_multiple_column_indices(
 	return column_indices;
 }
 
+// create a table whose columns are views (see dt_column_view) over [length] rows
+// of the specified columns of [table] starting at [offset].
+// NO values are copied; the parent table must outlive the returned table.
+// returns NULL on failure.
+static struct DataTable*
+__create_view_table(
+	const struct DataTable* const table,
+	const size_t n_columns,
+	const size_t* const column_indices,
+	const size_t offset,
+	const size_t length)
+{
+	struct DataTable* view_table = dt_alloc(table->allocator, sizeof(*view_table));
+	if (!view_table)
+		return NULL;
+
+	view_table->allocator = table->allocator;
+	view_table->lazy = NULL;
+	view_table->mapped = NULL;
+	view_table->arrow = NULL;
+
+	view_table->columns = dt_calloc(table->allocator, n_columns, sizeof(struct ColumnPair));
+	if (!view_table->columns && n_columns > 0)
+	{
+		dt_free(table->allocator, view_table);
+		return NULL;
+	}
+
+	view_table->n_columns = 0;
+	view_table->column_capacity = n_columns;
+	view_table->n_rows = length;
+
+	for (size_t i = 0; i < n_columns; ++i)
+	{
+		const struct ColumnPair* const source = &table->columns[column_indices[i]];
+		struct ColumnPair* const target = &view_table->columns[i];
+
+		memcpy(target->name, source->name, DT_MAX_COL_LEN);
+		target->column = dt_column_view(source->column, offset, length);
+		if (!target->column)
+		{
+			dt_table_free(&view_table);
+			return NULL;
+		}
+		view_table->n_columns++;
+	}
+
+	return view_table;
+}
+
 // take boolean arrays on each column and apply OR operator on all columns.
 // returns back a single array after applying the operator on each column
 // can used in __filter_multiple
 static size_t* 
 or_callback(
+	const struct dt_allocator* const allocator,
 	size_t** boolean_arrays,
 	const size_t n_rows,
 	const size_t n_columns)
 {
-	size_t* filter_idx = calloc(n_rows, sizeof(size_t));
+	size_t* filter_idx = dt_aligned_calloc(allocator, n_rows, sizeof(size_t));
 	if (!filter_idx)
 		return NULL;
 
@@ -101,11 +158,12 @@ or_callback(
 // can be used in __filter_multiple
 static size_t*
 and_callback(
+	const struct dt_allocator* const allocator,
 	size_t** boolean_arrays, 
 	const size_t n_rows,
 	const size_t n_columns)
 {
-	size_t* filter_idx = calloc(n_rows, sizeof(size_t));
+	size_t* filter_idx = dt_aligned_calloc(allocator, n_rows, sizeof(size_t));
 	if (!filter_idx)
 		return NULL;
 
@@ -133,13 +191,13 @@ __filter_multiple(
 	const size_t n_columns,
 	const size_t* column_indices,
 	bool (**filter_callback)(void* item, void* user_data),
-	size_t* (*or_and_callback)(size_t** boolean_arrays, size_t n_rows, size_t n_columns),
+	size_t* (*or_and_callback)(const struct dt_allocator* allocator, size_t** boolean_arrays, size_t n_rows, size_t n_columns),
   void* user_data)
 {
 	// create pointer to pointer of size_t "arrays" to store the
 	// boolean size_t arrays when calling column filter on each
 	// provided index
-	size_t** filter_idx_arrays = calloc(n_columns, sizeof(*filter_idx_arrays));
+	size_t** filter_idx_arrays = dt_calloc(table->allocator, n_columns, sizeof(*filter_idx_arrays));
 	if (!filter_idx_arrays)
 		return NULL;
 
@@ -155,12 +213,12 @@ __filter_multiple(
 	// create the final "boolean" size_t array which iterates all of
 	// the others (row-by-row) and sets it to 1 if AT LEAST ONE of the
 	// columns is 1 (OR LOGIC)
-	size_t* filter_idx = or_and_callback(filter_idx_arrays, table->n_rows, n_columns);
+	size_t* filter_idx = or_and_callback(table->allocator, filter_idx_arrays, table->n_rows, n_columns);
 	if (!filter_idx)
 	{
 		for (size_t i = 0; i < n_columns; ++i)
-			free(filter_idx_arrays[i]);
-		free(filter_idx_arrays);
+			dt_aligned_free(table->allocator, filter_idx_arrays[i]);
+		dt_free(table->allocator, filter_idx_arrays);
 		return NULL;
 	}
 	
@@ -179,10 +237,10 @@ __filter_multiple(
 	filtered_table->n_rows = filtered_table->columns[0].column->n_values;
 
 	// cleanup and return
-	free(filter_idx);
+	dt_aligned_free(table->allocator, filter_idx);
 	for (size_t i = 0; i < n_columns; ++i)
-		free(filter_idx_arrays[i]);
-	free(filter_idx_arrays);
+		dt_aligned_free(table->allocator, filter_idx_arrays[i]);
+	dt_free(table->allocator, filter_idx_arrays);
 
 	return filtered_table;
 }
@@ -223,6 +281,17 @@ __two_values_equal(
 		|| (value1_type != STRING && value2_type == STRING))
 		return false;
 	
+	// same for booleans (BOOL values are only equal to BOOL values)
+	if (value1_type == BOOL || value2_type == BOOL)
+		return value1_type == value2_type && *(bool*)value1 == *(bool*)value2;
+
+	// dates and timestamps are plain integers, but only comparable to their own type
+	if (value1_type == DATE || value2_type == DATE)
+		return value1_type == value2_type && *(int32_t*)value1 == *(int32_t*)value2;
+
+	if (value1_type == TIMESTAMP || value2_type == TIMESTAMP)
+		return value1_type == value2_type && *(int64_t*)value1 == *(int64_t*)value2;
+
 	bool is_equal = false;
 
 	// if both are a string, use the string comparison
@@ -282,6 +351,9 @@ __two_values_equal(
 				case FLOAT:
 				case DOUBLE:
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -317,6 +389,9 @@ __two_values_equal(
 				case FLOAT:
 				case DOUBLE:
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -352,6 +427,9 @@ __two_values_equal(
 				case FLOAT:
 				case DOUBLE:
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -387,6 +465,9 @@ __two_values_equal(
 				case FLOAT:
 				case DOUBLE:
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -422,6 +503,9 @@ __two_values_equal(
 				case FLOAT:
 				case DOUBLE:
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -457,6 +541,9 @@ __two_values_equal(
 				case FLOAT:
 				case DOUBLE:
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -492,6 +579,9 @@ __two_values_equal(
 				case FLOAT:
 				case DOUBLE:
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -527,6 +617,9 @@ __two_values_equal(
 				case FLOAT:
 				case DOUBLE:
 				case STRING:
+				case BOOL:
+				case DATE:
+				case TIMESTAMP:
 					break;
 			}
 			break;
@@ -534,6 +627,9 @@ __two_values_equal(
 		case FLOAT:
 		case DOUBLE:
 		case STRING:
+		case BOOL:
+		case DATE:
+		case TIMESTAMP:
 			break;
 	}
 
@@ -568,6 +664,30 @@ __transfer_row(
 	return DT_SUCCESS;
 }
 
+// drop the values of [column] past its first [n_values] (freeing their strings), e.g. the
+// rows appended to some of the columns of a table before an allocation failed
+static void
+__trim_column(
+	struct DataColumn* const column,
+	const size_t n_values)
+{
+	if (column->type == STRING)
+	{
+		for (size_t i = n_values; i < column->n_values; ++i)
+		{
+			char** value = (char**)dt_column_get_value_ptr(column, i);
+			dt_free(column->allocator, *value);
+			*value = NULL;
+		}
+	}
+
+	// null values are appended in order, so the trimmed ones are at the end
+	while (column->n_null_values > 0 && column->null_value_indices[column->n_null_values - 1] >= n_values)
+		column->n_null_values--;
+
+	column->n_values = n_values;
+}
+
 static void
 __drop_column(
 	struct DataTable* table,
@@ -576,11 +696,7 @@ __drop_column(
 	if (table->n_columns == 0)
 		return;
 
-	struct DataColumn* column = dt_table_get_column_ptr_by_index(
-			table, 
-			column_index);
-
-	dt_column_free(&column);
+	dt_column_free(&table->columns[column_index].column);
 	for (size_t i = column_index; i < table->n_columns - 1; ++i)
 		memcpy(&table->columns[i], &table->columns[i + 1], sizeof(*table->columns));
 	memset(&table->columns[table->n_columns - 1], 0, sizeof(*table->columns));
@@ -597,7 +713,7 @@ __get_null_column_indices(
 	bool contains_null = false;
 	
 	// could be wrapped in a struct but not bothering with that right now
-	size_t* null_column_indices = calloc(1, sizeof(size_t));
+	size_t* null_column_indices = dt_calloc(table->allocator, 1, sizeof(size_t));
 	*n_null_columns = 0;
 	size_t null_column_capacity = 1;
 
@@ -612,11 +728,15 @@ __get_null_column_indices(
 			null_column_indices[(*n_null_columns)++] = i;
 			if (*n_null_columns == null_column_capacity)
 			{
-				size_t new_capacity = null_column_capacity *= 2;
-				void* alloc = realloc(null_column_indices, new_capacity * sizeof(size_t));
+				size_t new_capacity = null_column_capacity * 2;
+				void* alloc = dt_realloc(
+					table->allocator,
+					null_column_indices,
+					null_column_capacity * sizeof(size_t),
+					new_capacity * sizeof(size_t));
 				if (!alloc)
 				{
-					free(null_column_indices);
+					dt_free(table->allocator, null_column_indices);
 					return NULL;
 				}
 
@@ -628,7 +748,7 @@ __get_null_column_indices(
 
 	if (!contains_null)
 	{
-		free(null_column_indices);
+		dt_free(table->allocator, null_column_indices);
 		return NULL;
 	}
 
@@ -653,6 +773,7 @@ sizet_compare(
 
 static size_t*
 __get_distinct_indices(
+	const struct dt_allocator* const allocator,
 	size_t* indices,
 	const size_t n_indices,
 	size_t* n_distinct_indices)
@@ -660,7 +781,7 @@ __get_distinct_indices(
 	qsort(indices, n_indices, sizeof(size_t), &sizet_compare);
 
 	// initially allocate to same size but reallocate to proper size afterwards
-	size_t* distinct_indices = calloc(n_indices, sizeof(size_t));
+	size_t* distinct_indices = dt_calloc(allocator, n_indices, sizeof(size_t));
 	*n_distinct_indices = 0;
 
 	distinct_indices[(*n_distinct_indices)++] = indices[0];
@@ -668,10 +789,14 @@ __get_distinct_indices(
 		if (indices[i] != indices[i - 1])
 			distinct_indices[(*n_distinct_indices)++] = indices[i];
 
-	void* alloc = realloc(distinct_indices, *n_distinct_indices * sizeof(size_t));
+	void* alloc = dt_realloc(
+		allocator,
+		distinct_indices,
+		n_indices * sizeof(size_t),
+		*n_distinct_indices * sizeof(size_t));
 	if (!alloc)
 	{
-		free(distinct_indices);
+		dt_free(allocator, distinct_indices);
 		return NULL;
 	}
 	distinct_indices = alloc;
@@ -698,7 +823,7 @@ __get_null_row_indices(
 		n_candidate_row_indices += table->columns[column_index].column->n_null_values;
 	}
 
-	size_t* candidate_row_indices = calloc(n_candidate_row_indices, sizeof(size_t));
+	size_t* candidate_row_indices = dt_calloc(table->allocator, n_candidate_row_indices, sizeof(size_t));
 	if (!candidate_row_indices)
 		return NULL;
 
@@ -712,9 +837,13 @@ __get_null_row_indices(
 			candidate_row_indices[current_idx++] = column->null_value_indices[k];
 	}
 
-	size_t* distinct_indices = __get_distinct_indices(candidate_row_indices, n_candidate_row_indices, n_row_indices);
+	size_t* distinct_indices = __get_distinct_indices(
+		table->allocator,
+		candidate_row_indices,
+		n_candidate_row_indices,
+		n_row_indices);
 
-	free(candidate_row_indices);
+	dt_free(table->allocator, candidate_row_indices);
 	return distinct_indices;
 }
 
@@ -774,7 +903,7 @@ __sample_without_replacement(
 	if (!samples)
 		return NULL;
 
-  size_t* table_column_indices = __generate_range(table->n_columns);
+  size_t* table_column_indices = __generate_range(table->allocator, table->n_columns);
   if (!table_column_indices)
     return NULL;
 
@@ -790,486 +919,2819 @@ __sample_without_replacement(
 		}
 	}
 
-  free(table_column_indices);
+  dt_free(table->allocator, table_column_indices);
 	hash_free(&htable);
 
 	return samples;
 }
 
-static void
-__tokenize_line(
-	const char* const line,
+// copy the value of [span] into [*buffer] (grown as needed) as a null-terminated string
+// and store its length into [length] (unless NULL).
+// returns NULL if the buffer couldn't be grown.
+static char*
+__csv_span_to_string(
+	const char* const data,
+	const struct dt_csv_span* const span,
+	const struct dt_allocator* const allocator,
+	char** buffer,
+	size_t* capacity,
+	size_t* const length)
+{
+	if (span->length + 1 > *capacity)
+	{
+		const size_t new_capacity = (span->length + 1) * 2;
+		char* new_buffer = dt_realloc(allocator, *buffer, *capacity, new_capacity);
+		if (!new_buffer)
+			return NULL;
+		*buffer = new_buffer;
+		*capacity = new_capacity;
+	}
+
+	const size_t value_length = dt_csv_span_copy(data, span, *buffer);
+	if (length)
+		*length = value_length;
+	return *buffer;
+}
+
+// create a table of STRING columns named after the header record at [*position]
+static struct DataTable*
+__parse_header_from_csv(
+	const struct dt_csv_source* const source,
 	const char delim,
-	char* tokens,
-	size_t* n_tokens)
+	size_t* const position,
+	struct dt_csv_record* const record)
 {
-	*n_tokens = 0;
-	memset(tokens, 0, 4096);
+	// skip a UTF-8 byte order mark so it doesn't end up in the first column name
+	if (source->size >= 3 && memcmp(source->data, "\xEF\xBB\xBF", 3) == 0)
+		*position = 3;
 
-	const size_t len = strlen(line);
+	if (dt_csv_tokenize_record(source->data, source->size, delim, position, record) != DT_SUCCESS
+			|| record->n_spans == 0)
+		return NULL;
+
+	const size_t n_columns = record->n_spans;
+	const struct dt_allocator* const allocator = dt_get_default_allocator();
 
-	bool inside_quotes = false;
-	size_t tokens_idx = 0;
-	char quote_start_char = 0;
+	char (*column_names)[DT_MAX_COL_LEN] = dt_calloc(allocator, n_columns, sizeof(*column_names));
+	enum data_type_e* dtypes = dt_calloc(allocator, n_columns, sizeof(*dtypes));
+	char* name = NULL;
+	size_t name_capacity = 0;
+	struct DataTable* table = NULL;
 
-	for (size_t i = 0; i < len; ++i)
+	if (!column_names || !dtypes)
+		goto cleanup;
+
+	for (size_t i = 0; i < n_columns; ++i)
 	{
-		// hitting delimiter or newline character
-		if ((line[i] == delim && !inside_quotes) || line[i] == '\n')
-		{
-			tokens[tokens_idx++] = '\0';
-			(*n_tokens)++;
-			continue;
-		}
+		if (!__csv_span_to_string(source->data, &record->spans[i], allocator, &name, &name_capacity, NULL))
+			goto cleanup;
 
-		if (line[i] == '\'' || line[i] == '\"')
-		{
-			if (!inside_quotes)
-			{
-				quote_start_char = line[i];
-				inside_quotes = true;
-			}
-			else if (inside_quotes && quote_start_char == line[i])
-				inside_quotes = false;
-		}
+		// ensure column name is NOT NULL
+		if (strlen(name) == 0)
+			goto cleanup;
 
-		tokens[tokens_idx++] = line[i];
+		// longer names are truncated
+		strncpy(column_names[i], name, DT_MAX_COL_LEN - 1);
+		dtypes[i] = STRING;
 	}
+
+	table = dt_table_create_with_allocator(n_columns, column_names, dtypes, allocator);
+
+cleanup:
+	dt_free(allocator, column_names);
+	dt_free(allocator, dtypes);
+	dt_free(allocator, name);
+
+	return table;
 }
 
-// this makes a huge assumption that the caller knows what they're doing.
-//
-// takes a character buffer with multiple NULL characters separating tokens.
-// finds the n-th NULL terminating character to extract a pointer to that specific token
-//
-// EXAMPLE:
-// tokens = "value1\0value2\0value3\0"
-// if we search for the second token, we will find the first NULL
-// character and return a pointer to the beginning of "value2"
-static const char* 
-__get_token(
-	const char* const tokens,
-	const size_t token_idx)
+// integers with at most this many digits always fit in an int64_t
+#define DT_MAX_SAFE_INTEGER_DIGITS 18
+
+// what type inference has seen in (a part of) a column of strings.
+// the facts of several parts merge into the facts of the whole column, so a
+// column read in pieces is inferred exactly like the whole column would be.
+struct __inference_facts
 {
-	// if getting first token, it's the beginning of the buffer
-	if (token_idx == 0)
-		return tokens;
+	bool contains_value;
+	bool all_bool;
+	bool all_temporal;
+	bool contains_time;
+	bool contains_string;
+	bool contains_decimal;
+	bool contains_negative;
+
+	// integers above INT64_MAX, and those that don't fit in 64 bits at all
+	bool contains_large_integer;
+	bool contains_huge_integer;
+};
 
-	size_t idx = 0;
-	size_t current_token_idx = 0;
+static void
+__init_inference_facts(
+	struct __inference_facts* const facts)
+{
+	facts->contains_value = false;
+	facts->all_bool = true;
+	facts->all_temporal = true;
+	facts->contains_time = false;
+	facts->contains_string = false;
+	facts->contains_decimal = false;
+	facts->contains_negative = false;
+	facts->contains_large_integer = false;
+	facts->contains_huge_integer = false;
+}
 
-	while (true)
+// type inferred from a plain number of [length] characters (digits and '.', with an optional
+// leading '-'), the same as __type_from_inference_facts would give, or STRING if it's anything else.
+// plain numbers are neither booleans nor dates, so the usual case doesn't need those parsers
+static enum data_type_e
+__csv_number_type(
+	const char* const str,
+	const size_t length)
+{
+	const bool is_negative = length > 0 && str[0] == '-';
+	bool is_decimal = false;
+	for (size_t k = is_negative; k < length; ++k)
 	{
+		if (str[k] == '.')
+			is_decimal = true;
+		else if (!isdigit(str[k]))
+			return STRING;
+	}
 
-		if (current_token_idx == token_idx)
-			return &tokens[idx];
+	if (is_decimal)
+		return DOUBLE;
 
-		if (tokens[idx++] == '\0')
-			current_token_idx++;
-	}
+	int64_t signed_value = 0;
+	uint64_t unsigned_value = 0;
+	if (length > DT_MAX_SAFE_INTEGER_DIGITS
+			&& (is_negative
+				? dt_parse_int64(str, length, &signed_value)
+				: dt_parse_uint64(str, length, &unsigned_value)) != length)
+		return DOUBLE;
 
-	// unreachable
-	return NULL;
+	return is_negative ? INT64 : UINT64;
 }
 
-static struct DataTable*
-__parse_header_from_csv(
-	FILE* csv_file,
-	const char delim)
+// whether an unsigned integer of [length] digits is above INT64_MAX
+static bool
+__is_large_integer(
+	const char* const str,
+	const size_t length)
 {
-	char current_line[4096] = {0};
-	
-	char tokens[4096] = {0};
-	size_t n_tokens = 0;
+	int64_t value = 0;
+	return length > DT_MAX_SAFE_INTEGER_DIGITS && dt_parse_int64(str, length, &value) != length;
+}
 
-	// read header line
-	fgets(current_line, 4096, csv_file);
-	__tokenize_line(current_line, delim, tokens, &n_tokens);
+// update [facts] with one (non-null) value
+static void
+__add_inference_fact(
+	struct __inference_facts* const facts,
+	const char* const value_str)
+{
+	facts->contains_value = true;
 
-	// create array of column names after tokenizing header
-	char (*column_names)[DT_MAX_COL_LEN] = calloc(n_tokens, sizeof(*column_names));
-	if (!column_names)
-		return NULL;
-	for (size_t i = 0; i < n_tokens; ++i)
+	// every value is true/false (case-insensitive) --> BOOL
+	//     0/1 columns are left as integers; request BOOL explicitly for those
+	if (facts->all_bool)
 	{
-		// ensure column name is NOT NULL
-		const char* const token = __get_token(tokens, i);
-		if (strlen(token) == 0)
-			return NULL;
+		bool value = false;
+		facts->all_bool = !isdigit(value_str[0]) && dt_parse_bool(value_str, &value);
+	}
 
-		strcpy(column_names[i], __get_token(tokens, i));
+	// every value is an ISO-8601 date --> DATE
+	// every value is a date or date-time (with at least one time) --> TIMESTAMP
+	if (facts->all_temporal)
+	{
+		int64_t value = 0;
+		facts->all_temporal = dt_parse_timestamp(value_str, DT_DEFAULT_TIME_UNIT, &value);
+		if (facts->all_temporal && value_str[DT_DATE_STRING_LEN] != '\0')
+			facts->contains_time = true;
 	}
 
-	// create array of STRING types
-	enum data_type_e* dtypes = calloc(n_tokens, sizeof(*dtypes));
-	if (!dtypes)
+	// anything but a plain number (digits and '.', with an optional leading '-') --> STRING
+	//     nothing else needs to be checked after we find a single string
+	// check if any contain '.' (or don't fit in 64 bits) --> DOUBLE
+	// check if first character is '-' to determine negativity
+	// (the same classification as __csv_number_type, which promotes columns past the sample)
+	if (facts->contains_string)
+		return;
+
+	const size_t length = strlen(value_str);
+	const enum data_type_e number_type = __csv_number_type(value_str, length);
+	if (number_type == STRING)
 	{
-		free(column_names);
-		return NULL;
+		facts->contains_string = true;
+		return;
 	}
-	for (size_t i = 0; i < n_tokens; ++i)
-		dtypes[i] = STRING;
 
-	struct DataTable* table = dt_table_create(n_tokens, column_names, dtypes);
-	free(column_names);
-	free(dtypes);
+	if (number_type == DOUBLE && memchr(value_str, '.', length))
+		facts->contains_decimal = true;
+	else if (number_type == DOUBLE)
+		facts->contains_huge_integer = true;
+	else if (number_type == UINT64)
+		facts->contains_large_integer |= __is_large_integer(value_str, length);
 
-	return table;
+	if (value_str[0] == '-')
+		facts->contains_negative = true;
 }
 
 static void
-__parse_body_from_csv(
-	FILE* csv_file,
-	const char delim,
-	struct DataTable* const table)
+__merge_inference_facts(
+	struct __inference_facts* const dest,
+	const struct __inference_facts* const src)
 {
-	char current_line[4096] = {0};
-	
-	char tokens[4096] = {0};
-	size_t n_tokens = 0;
-
-	void* items = NULL;
+	dest->contains_value |= src->contains_value;
+	dest->all_bool &= src->all_bool;
+	dest->all_temporal &= src->all_temporal;
+	dest->contains_time |= src->contains_time;
+	dest->contains_string |= src->contains_string;
+	dest->contains_decimal |= src->contains_decimal;
+	dest->contains_negative |= src->contains_negative;
+	dest->contains_large_integer |= src->contains_large_integer;
+	dest->contains_huge_integer |= src->contains_huge_integer;
+}
 
-	// read next line in body
-	while (fgets(current_line, 4096, csv_file))
-	{
-		__tokenize_line(current_line, delim, tokens, &n_tokens);
-		if (!items)
-			items = calloc(n_tokens, sizeof(void*));
+// the rules (in order) to determine type.
+// only determines BOOL, DATE, TIMESTAMP, STRING, DOUBLE, INT64 or UINT64;
+// if user wants smaller types, they will have to convert separately
+// (null values are skipped by every rule)
+static enum data_type_e
+__type_from_inference_facts(
+	const struct __inference_facts* const facts)
+{
+	if (facts->all_bool && facts->contains_value)
+		return BOOL;
 
-    dt_table_insert_empty_row(table);
+	if (facts->all_temporal && facts->contains_value)
+		return facts->contains_time ? TIMESTAMP : DATE;
 
-		// create "shared" pointers to insert into table
-		for (size_t i = 0; i < table->n_columns; ++i)
-		{
-      // if length is zero, value is already NULL so we can ignore it
-			char* value = strdup(__get_token(tokens, i));
-			if (strlen(value) > 0)
-        dt_table_set_value(table, table->n_rows - 1, i, value);
+	if (facts->contains_string)
+		return STRING;
 
-      free(value);
-		}
+	// integers that don't fit in 64 bits are read as doubles, as are
+	// negative integers mixed with ones above INT64_MAX
+	if (facts->contains_decimal || facts->contains_huge_integer)
+		return DOUBLE;
 
-		// cleanup values after inserting (copies are made at insert time)
-		for (size_t i = 0; i < table->n_columns; ++i)
-		{
-			char** value_addr = (char**)((char*)items + i*sizeof(void*));
-			free(*value_addr);
-			*value_addr = NULL;
-		}
-	}
+	if (facts->contains_negative)
+		return facts->contains_large_integer ? DOUBLE : INT64;
 
-	free(items);
+	return UINT64;
 }
 
-static void
-__convert_column_type_from_string(
-	struct DataColumn* const column)
+// a value of any column type parsed from a CSV field
+union __csv_scalar
 {
-	// if the desired type is a string, no need for conversion
-	if (column->type == STRING)
-		return;
-
-	// iterate over each item in column and convert from string to
-	// appropriate type
-	//
-	// all of the current values in the column should be string addresses
-	//
-	// we have to do some voodoo magic to extract the string addresses
-	// because at this point we have already changed the column types and
-	// sizes. It will be a little gross
-	for (size_t i = 0; i < column->n_values; ++i)
+	uint8_t u8;
+	uint16_t u16;
+	uint32_t u32;
+	uint64_t u64;
+	int8_t i8;
+	int16_t i16;
+	int32_t i32;
+	int64_t i64;
+	float f32;
+	double f64;
+	bool b;
+	const char* string;
+};
+
+// parse [value_str] (of [length] characters) as [type] into [scalar] and return a pointer to the
+// value as it's stored in a column (a pointer to the string for STRING, which isn't copied).
+// values that can't be parsed (or are out of range for 64-bit integers) are read as 0
+// (false for BOOL) and narrower integers keep the low bits.
+static void*
+__parse_csv_scalar(
+	const enum data_type_e type,
+	const enum dt_time_unit_e time_unit,
+	const char* const value_str,
+	const size_t length,
+	union __csv_scalar* const scalar)
+{
+	scalar->u64 = 0;
+	switch (type)
 	{
-		char** value_addr = (char**)((char*)column->value + i*sizeof(char**));
-		char* value_str = *value_addr;
-		char* endptr = NULL;
+		case UINT8:
+			dt_parse_uint64(value_str, length, &scalar->u64);
+			scalar->u8 = (uint8_t)scalar->u64;
+			return &scalar->u8;
 
-		switch (column->type)
-		{
-			case UINT8:
-			{
-				uint8_t value = (uint8_t)strtoul(value_str, &endptr, 10);
-				dt_column_set_value(column, i, &value);
-				break;
-			}
+		case UINT16:
+			dt_parse_uint64(value_str, length, &scalar->u64);
+			scalar->u16 = (uint16_t)scalar->u64;
+			return &scalar->u16;
 
-			case UINT16:
-			{
-				uint16_t value = (uint16_t)strtoul(value_str, &endptr, 10);
-				dt_column_set_value(column, i, &value);
-				break;
-			}
+		case UINT32:
+			dt_parse_uint64(value_str, length, &scalar->u64);
+			scalar->u32 = (uint32_t)scalar->u64;
+			return &scalar->u32;
 
-			case UINT32:
-			{
-				uint32_t value = (uint32_t)strtoul(value_str, &endptr, 10);
-				dt_column_set_value(column, i, &value);
-				break;
-			}
+		case UINT64:
+			dt_parse_uint64(value_str, length, &scalar->u64);
+			return &scalar->u64;
 
-			case UINT64:
-			{
-				uint64_t value = (uint64_t)strtoull(value_str, &endptr, 10);
-				dt_column_set_value(column, i, &value);
-				break;
-			}
+		case INT8:
+			dt_parse_int64(value_str, length, &scalar->i64);
+			scalar->i8 = (int8_t)scalar->i64;
+			return &scalar->i8;
 
-			case INT8:
-			{
-				int8_t value = (int8_t)strtol(value_str, &endptr, 10);
-				dt_column_set_value(column, i, &value);
-				break;
-			}
+		case INT16:
+			dt_parse_int64(value_str, length, &scalar->i64);
+			scalar->i16 = (int16_t)scalar->i64;
+			return &scalar->i16;
 
-			case INT16:
-			{
-				int16_t value = (int16_t)strtol(value_str, &endptr, 10);
-				dt_column_set_value(column, i, &value);
-				break;
-			}
+		case INT32:
+			dt_parse_int64(value_str, length, &scalar->i64);
+			scalar->i32 = (int32_t)scalar->i64;
+			return &scalar->i32;
 
-			case INT32:
-			{
-				int32_t value = (int32_t)strtol(value_str, &endptr, 10);
-				dt_column_set_value(column, i, &value);
-				break;
-			}
+		case INT64:
+			dt_parse_int64(value_str, length, &scalar->i64);
+			return &scalar->i64;
 
-			case INT64:
-			{
-				int64_t value = (int64_t)strtoll(value_str, &endptr, 10);
-				dt_column_set_value(column, i, &value);
-				break;
-			}
+		case FLOAT:
+			scalar->f32 = 0.0f;
+			dt_parse_float(value_str, length, &scalar->f32);
+			return &scalar->f32;
 
-			case FLOAT:
-			{
-				float value = strtof(value_str, &endptr);
-				dt_column_set_value(column, i, &value);
-				break;
-			}
+		case DOUBLE:
+			scalar->f64 = 0.0;
+			dt_parse_double(value_str, length, &scalar->f64);
+			return &scalar->f64;
 
-			case DOUBLE:
-			{
-				double value = strtod(value_str, &endptr);
-				dt_column_set_value(column, i, &value);
-				break;
-			}
+		case BOOL:
+			scalar->b = false;
+			dt_parse_bool(value_str, &scalar->b);
+			return &scalar->b;
 
-			// do nothing, just here to avoid compiler warning
-			case STRING:
-				break;
-		}
+		case DATE:
+			scalar->i32 = 0;
+			dt_parse_date(value_str, &scalar->i32);
+			return &scalar->i32;
 
-		// strings are heap allocated so we free them after converting
-		free(value_str);
+		case TIMESTAMP:
+			dt_parse_timestamp(value_str, time_unit, &scalar->i64);
+			return &scalar->i64;
 
-		// disable deallocator since it's no longer heap allocated
-		column->deallocator = NULL;
+		case STRING:
+			scalar->string = value_str;
+			return &scalar->string;
 	}
+
+	return NULL;
 }
 
-static void
-__convert_csv_column_types_from_string(
-	struct DataTable* const table)
+// parse [value_str] (of [length] characters) according to the column type and append it to [column]
+// (see __parse_csv_scalar)
+static enum status_code_e
+__append_csv_value(
+	struct DataColumn* const column,
+	const char* const value_str,
+	const size_t length)
 {
-	for (size_t i = 0; i < table->n_columns; ++i)
-		__convert_column_type_from_string(table->columns[i].column);
+	// the only type that's copied to the heap
+	if (column->type == STRING)
+		return dt_column_append_value(column, value_str);
+
+	union __csv_scalar scalar;
+	void* value = __parse_csv_scalar(column->type, column->time_unit, value_str, length, &scalar);
+	return value ? dt_column_append_value(column, value) : DT_TYPE_MISMATCH;
 }
 
-// perform naive type inference which only determines:
-// STRING, DOUBLE, INT64 to UINT64
-// if user wants smaller types, they will have to convert separately
+// type inferred from a single (non-null) value, the same as __type_from_inference_facts would give
 static enum data_type_e
-__infer_column_type(
-	struct DataColumn* const column)
+__csv_value_type(
+	const char* const value_str)
 {
-	// below are the rules (in order) to determine type
-	
-	// check for any alpha characters --> STRING
-	//     can immediately terminate after we find a single alpha char
-	// check if any contain '.' --> DOUBLE
-	//     need to make sure NO alpha characters are present, so we must
-	//     still iterate over entire column
-	// check if first character is '-' to determine negativity
-	//     if not STRING or DOUBLE after iterating entire column, we can
-	//     choose either UINT64 or INT64 depending on presence of negation
-	
-	bool contains_decimal = false;
-	bool contains_negative = false;
+	const enum data_type_e type = __csv_number_type(value_str, strlen(value_str));
+	if (type != STRING)
+		return type;
+
+	struct __inference_facts facts;
+	__init_inference_facts(&facts);
+	__add_inference_fact(&facts, value_str);
+	return __type_from_inference_facts(&facts);
+}
 
-	for (size_t i = 0; i < column->n_values; ++i)
+// narrowest inferred type holding values of both [type1] and [type2]:
+// UINT64 -> INT64 -> DOUBLE and DATE -> TIMESTAMP, anything else is a STRING
+static enum data_type_e
+__join_inferred_types(
+	const enum data_type_e type1,
+	const enum data_type_e type2)
+{
+	if (type1 == type2)
+		return type1;
+
+	const bool is_number1 = type1 == UINT64 || type1 == INT64 || type1 == DOUBLE;
+	const bool is_number2 = type2 == UINT64 || type2 == INT64 || type2 == DOUBLE;
+	if (is_number1 && is_number2)
+		return type1 == DOUBLE || type2 == DOUBLE ? DOUBLE : INT64;
+
+	if ((type1 == DATE && type2 == TIMESTAMP) || (type1 == TIMESTAMP && type2 == DATE))
+		return TIMESTAMP;
+
+	return STRING;
+}
+
+// whether [value_str] (of [length] characters, null-terminated unless [type] is a number)
+// can be stored in a column inferred as [type] without promoting it
+static bool
+__fits_inferred_type(
+	const enum data_type_e type,
+	const char* const value_str,
+	const size_t length)
+{
+	switch (type)
 	{
-		char** value_addr = (char**)((char*)column->value + i*sizeof(char**));
-		size_t len = strlen(*value_addr);
-		for (size_t k = 0; k < len; ++k)
+		case BOOL:
+		{
+			bool value = false;
+			return !isdigit(value_str[0]) && dt_parse_bool(value_str, &value);
+		}
+
+		case DATE:
+		{
+			int32_t value = 0;
+			return dt_parse_date(value_str, &value);
+		}
+
+		case TIMESTAMP:
 		{
-			char current_char = (*value_addr)[k];
+			int64_t value = 0;
+			return dt_parse_timestamp(value_str, DT_DEFAULT_TIME_UNIT, &value);
+		}
 
-			if (k == 0 && current_char == '-')
-				contains_negative = true;
+		case STRING:
+			return true;
 
-			// if contains a non-digit value (besides '.' and '-') it is a string
-			if (!isdigit(current_char) && current_char != '.' && current_char != '-')
-				goto is_string;
+		// integers above INT64_MAX don't fit in INT64
+		case UINT64:
+		case INT64:
+		case DOUBLE:
+		{
+			const enum data_type_e value_type = __csv_number_type(value_str, length);
+			if (type == INT64 && value_type == UINT64)
+				return !__is_large_integer(value_str, length);
 
-			if (current_char == '.')
-				contains_decimal = true;
+			return __join_inferred_types(type, value_type) == type;
 		}
+
+		// never inferred
+		case UINT8:
+		case UINT16:
+		case UINT32:
+		case INT8:
+		case INT16:
+		case INT32:
+		case FLOAT:
+			return true;
 	}
 
-	// at this point, it's impossible to be a string, so numeric types are left
+	return true;
+}
 
-	if (contains_decimal)
-		return DOUBLE;
+// replace every (still empty) column of [table] with an empty column of [types]
+static enum status_code_e
+__set_empty_column_types(
+	struct DataTable* const table,
+	const enum data_type_e* const types)
+{
+	for (size_t i = 0; i < table->n_columns; ++i)
+	{
+		struct DataColumn* column = NULL;
+		if (dt_column_create_with_allocator(&column, 0, types[i], table->allocator) != DT_SUCCESS)
+			return DT_ALLOC_ERROR;
 
-	if (contains_negative)
-		return INT64;
+		dt_column_free(&table->columns[i].column);
+		table->columns[i].column = column;
+	}
 
-	return UINT64;
+	return DT_SUCCESS;
+}
 
-	// special case, this will only be reached from inside the loops
-is_string:
-	return STRING;
+// inputs are only split between threads if every thread gets at least this many bytes
+#define DT_CSV_MIN_CHUNK_SIZE (1024 * 1024)
+
+// number of threads to read [n_bytes] of records with ([requested] = 0 for one per CPU core)
+static size_t
+__csv_chunk_count(
+	const size_t requested,
+	const size_t n_bytes)
+{
+	size_t n_threads = requested;
+#ifdef DT_HAVE_PTHREADS
+	if (n_threads == 0)
+	{
+		const long n_cores = sysconf(_SC_NPROCESSORS_ONLN);
+		n_threads = n_cores > 0 ? (size_t)n_cores : 1;
+	}
+#else
+	n_threads = 1;
+#endif
+
+	const size_t max_chunks = n_bytes / DT_CSV_MIN_CHUNK_SIZE;
+	if (n_threads > max_chunks)
+		n_threads = max_chunks;
+
+	return n_threads > 0 ? n_threads : 1;
 }
 
-static void
-__infer_csv_types(
-	struct DataTable* const table)
+// fields of every record that are read (see dt_csv_options)
+struct __csv_layout
 {
-	for (size_t i = 0; i < table->n_columns; ++i)
+	// field of every column of the table, followed by the field of every filter
+	size_t* fields;
+	size_t n_columns;
+	size_t n_filters;
+
+	// filters are parsed as [filter_types] (set once the types are known)
+	enum data_type_e* filter_types;
+	bool (**filter_callbacks)(void* item, void* user_data);
+	void* filter_user_data;
+};
+
+// resolve the columns to read and to filter by in [options] against the names of the columns of
+// [header] (every column of the input) into [layout], which is freed with __free_csv_layout.
+// returns DT_COLUMN_NOT_FOUND if a column isn't in the header.
+// returns DT_ALLOC_ERROR if couldn't allocate memory.
+// returns DT_SUCCESS otherwise.
+static enum status_code_e
+__init_csv_layout(
+	const struct DataTable* const header,
+	const struct dt_csv_options* const options,
+	struct __csv_layout* const layout)
+{
+	layout->n_columns = options->columns ? options->n_columns : header->n_columns;
+	layout->n_filters = options->n_filters;
+	layout->filter_callbacks = options->filter_callbacks;
+	layout->filter_user_data = options->filter_user_data;
+
+	const size_t n_fields = layout->n_columns + layout->n_filters;
+	layout->fields = n_fields > 0 ? dt_calloc(header->allocator, n_fields, sizeof(size_t)) : NULL;
+	layout->filter_types = layout->n_filters > 0
+		? dt_calloc(header->allocator, layout->n_filters, sizeof(enum data_type_e))
+		: NULL;
+	if ((n_fields > 0 && !layout->fields) || (layout->n_filters > 0 && !layout->filter_types))
+		return DT_ALLOC_ERROR;
+
+	for (size_t i = 0; i < n_fields; ++i)
 	{
-		enum data_type_e inferred_dtype = __infer_column_type(table->columns[i].column);
-		table->columns[i].column->type = inferred_dtype;
-		table->columns[i].column->type_size = dt_type_to_size(inferred_dtype);
+		bool is_error = false;
+		if (i >= layout->n_columns)
+			layout->fields[i] = __get_column_index(header, options->filter_columns[i - layout->n_columns], &is_error);
+		else if (options->columns)
+			layout->fields[i] = __get_column_index(header, options->columns[i], &is_error);
+		else
+			layout->fields[i] = i;
+
+		if (is_error)
+			return DT_COLUMN_NOT_FOUND;
 	}
 
-	// take inferred types and cast entire table
-	__convert_csv_column_types_from_string(table);
+	return DT_SUCCESS;
 }
 
 static void
-__table_headers_to_string(
-  const struct DataTable* const table,
-  char* write_buffer,
-  const size_t write_buffer_max_len,
-  const char delim)
-{
-  memset(write_buffer, 0, write_buffer_max_len);
-  for (size_t i = 0; i < table->n_columns - 1; ++i)
-  {
-    size_t max_write_len = write_buffer_max_len - strlen(write_buffer) - 1;
-    strncat(write_buffer, table->columns[i].name, max_write_len);
-    strncat(write_buffer, &delim, 1);
-  }
-  size_t max_write_len = write_buffer_max_len - strlen(write_buffer) - 1;
-  strncat(write_buffer, table->columns[table->n_columns - 1].name, max_write_len);
+__free_csv_layout(
+	struct __csv_layout* const layout,
+	const struct dt_allocator* const allocator)
+{
+	dt_free(allocator, layout->fields);
+	dt_free(allocator, layout->filter_types);
+	layout->fields = NULL;
+	layout->filter_types = NULL;
 }
 
-static void
-__table_cell_value_to_string(
-  const struct DataTable* const table,
-  const size_t row_idx,
-  const size_t col_idx,
-  char* cell_value,
-  const size_t cell_value_max_len,
-  const char delim,
-  const bool include_delim)
-{
-  switch (table->columns[col_idx].column->type)
-  {
-    case FLOAT:
-    {
-      const float* value = dt_table_get_value(table, row_idx, col_idx);
-      snprintf(cell_value, cell_value_max_len, "%f", *value);
-      break;
-    }
-    case DOUBLE:
-    {
-      const double* value = dt_table_get_value(table, row_idx, col_idx);
-      snprintf(cell_value, cell_value_max_len, "%f", *value);
-      break;
-    }
-    case INT8:
-    {
-      const int8_t* value = dt_table_get_value(table, row_idx, col_idx);
-      snprintf(cell_value, cell_value_max_len, "%d", *value);
-      break;
-    }
-    case INT16:
-    {
-      const int16_t* value = dt_table_get_value(table, row_idx, col_idx);
-      snprintf(cell_value, cell_value_max_len, "%d", *value);
-      break;
-    }
-    case INT32:
-    {
-      const int32_t* value = dt_table_get_value(table, row_idx, col_idx);
-      snprintf(cell_value, cell_value_max_len, "%d", *value);
-      break;
-    }
-    case UINT8:
-    {
-      const uint8_t* value = dt_table_get_value(table, row_idx, col_idx);
-      snprintf(cell_value, cell_value_max_len, "%u", *value);
-      break;
-    }
-    case UINT16:
-    {
-      const uint16_t* value = dt_table_get_value(table, row_idx, col_idx);
-      snprintf(cell_value, cell_value_max_len, "%u", *value);
-      break;
-    }
-    case UINT32:
-    {
-      const uint32_t* value = dt_table_get_value(table, row_idx, col_idx);
-      snprintf(cell_value, cell_value_max_len, "%ul", *value);
-      break;
-    }
-    case INT64:
-    {
-      const int64_t* value = dt_table_get_value(table, row_idx, col_idx);
-      snprintf(cell_value, cell_value_max_len, "%lld", (long long)*value);
-      break;
-    }
-    case UINT64:
-    {
-      const uint64_t* value = dt_table_get_value(table, row_idx, col_idx);
-      snprintf(cell_value, cell_value_max_len, "%llu", (long long unsigned)*value);
-      break;
-    }
-    case STRING:
-    {
-      const char* value = dt_table_get_value(table, row_idx, col_idx);
-      snprintf(cell_value, cell_value_max_len, "%s", value);
-      break;
-    }
-  }
-
-  if (include_delim)
-    strncat(cell_value, &delim, 1);
+// empty table of the columns read with [options] (in that order) out of [header], which is
+// freed unless every column is read (then it's returned as is).
+// returns NULL on failure
+static struct DataTable*
+__select_csv_columns(
+	struct DataTable* header,
+	const struct dt_csv_options* const options)
+{
+	if (!options->columns)
+		return header;
+
+	struct DataTable* selection = dt_table_select(header, options->n_columns, options->columns);
+	struct DataTable* table = selection ? dt_table_copy_skeleton(selection) : NULL;
+
+	if (selection)
+		dt_table_free(&selection);
+	dt_table_free(&header);
+
+	return table;
 }
 
-static void
-__table_row_to_string(
-  const struct DataTable* const table,
-  const size_t row_idx,
-  char* write_buffer,
-  const size_t write_buffer_max_len,
-  const char delim)
-{
-  memset(write_buffer, 0, write_buffer_max_len);
-  for (size_t i = 0; i < table->n_columns - 1; ++i)
-  {
-    size_t max_write_len = write_buffer_max_len - strlen(write_buffer) - 1;
-    char cell_value[4096] = {0};
-
-    __table_cell_value_to_string(table, row_idx, i, cell_value, write_buffer_max_len, delim, true);
-    strncat(write_buffer, cell_value, max_write_len);
-  }
-
-  size_t max_write_len = write_buffer_max_len - strlen(write_buffer) - 1;
-  char cell_value[4096] = {0};
-  __table_cell_value_to_string(table, row_idx, table->n_columns - 1, cell_value, write_buffer_max_len, delim, false);
-  strncat(write_buffer, cell_value, max_write_len);
+// a byte range of a CSV input, read on its own thread
+struct __csv_chunk
+{
+	const struct dt_csv_source* source;
+	char delim;
+	const struct __csv_layout* layout;
+
+	// records starting in [start, end) belong to this chunk
+	size_t start;
+	size_t end;
+
+	// position after the last record (where the next chunk must start)
+	size_t end_position;
+
+	// for lazy tables, the start of every record of the chunk instead of [start, end)
+	// (gathered by __index_csv_chunk, then parsed by __parse_csv_rows)
+	size_t* rows;
+	size_t n_rows;
+	size_t row_capacity;
+
+	// facts for type inference of every column, then of every filter (inference pass only)
+	// gathered from the first [max_records] records (0 for all of them)
+	struct __inference_facts* facts;
+	size_t max_records;
+
+	// promote columns whose inferred type doesn't fit a value (parsing pass only)
+	bool promote;
+
+	// table with the parsed values (parsing pass only)
+	struct DataTable* table;
+
+	struct dt_csv_record record;
+
+	// scratch buffer for (null-terminated) values
+	char* value;
+	size_t value_capacity;
+
+	enum status_code_e status;
+
+#ifdef DT_HAVE_PTHREADS
+	pthread_t thread;
+	bool is_thread_started;
+#endif
+};
+
+// tokenize the next record of [chunk] that has any fields.
+// returns false once there are no more records starting before chunk->end (or on error)
+static bool
+__next_csv_record(
+	struct __csv_chunk* const chunk,
+	size_t* const position)
+{
+	while (*position < chunk->end)
+	{
+		chunk->status = dt_csv_tokenize_record(
+				chunk->source->data,
+				chunk->source->size,
+				chunk->delim,
+				position,
+				&chunk->record);
+		if (chunk->status != DT_SUCCESS)
+			return false;
+
+		// blank lines are skipped
+		if (chunk->record.n_spans > 0)
+			return true;
+	}
+
+	return false;
+}
+
+static bool
+__is_number_type(
+	const enum data_type_e type)
+{
+	return type != STRING && type != BOOL && type != DATE && type != TIMESTAMP;
+}
+
+// value of field [i] of the current record to be parsed as [type] and its [length].
+// numbers are parsed straight from the input (the value isn't null-terminated) unless they're
+// quoted; anything else is copied as a null-terminated string to the chunk's scratch buffer.
+// returns NULL if the field is empty (or missing) or the buffer couldn't grow.
+static const char*
+__csv_value(
+	struct __csv_chunk* const chunk,
+	const size_t i,
+	const enum data_type_e type,
+	size_t* const length)
+{
+	if (i >= chunk->record.n_spans || chunk->record.spans[i].length == 0)
+		return NULL;
+
+	const struct dt_csv_span* const span = &chunk->record.spans[i];
+	if (!span->is_quoted && __is_number_type(type))
+	{
+		*length = span->length;
+		return chunk->source->data + span->offset;
+	}
+
+	const char* value = __csv_span_to_string(
+			chunk->source->data,
+			span,
+			chunk->record.allocator,
+			&chunk->value,
+			&chunk->value_capacity,
+			length);
+	if (!value)
+		chunk->status = DT_ALLOC_ERROR;
+
+	return value;
+}
+
+// value of field [i] of the current record as a null-terminated string (see __csv_value)
+static const char*
+__csv_field(
+	struct __csv_chunk* const chunk,
+	const size_t i)
+{
+	size_t length = 0;
+	return __csv_value(chunk, i, STRING, &length);
+}
+
+// promote column [k] of the chunk's table to [type], keeping the values read so far.
+// numbers and dates are cast in place; STRING values are read again from the records
+// before the current one, so they're exactly the text of the fields.
+static enum status_code_e
+__promote_csv_column(
+	struct __csv_chunk* const chunk,
+	const size_t k,
+	const enum data_type_e type)
+{
+	struct DataTable* const table = chunk->table;
+	struct DataColumn* const column = table->columns[k].column;
+	const size_t field = chunk->layout->fields[k];
+
+	// nothing to convert, only as many nulls
+	if (column->n_null_values == column->n_values)
+	{
+		struct DataColumn* nulls = NULL;
+		if (dt_column_create_with_allocator(&nulls, 0, type, table->allocator) != DT_SUCCESS)
+			return DT_ALLOC_ERROR;
+
+		for (size_t i = 0; i < column->n_values; ++i)
+		{
+			if (dt_column_append_value(nulls, NULL) != DT_SUCCESS)
+			{
+				dt_column_free(&nulls);
+				return DT_ALLOC_ERROR;
+			}
+		}
+
+		dt_column_free(&table->columns[k].column);
+		table->columns[k].column = nulls;
+		return DT_SUCCESS;
+	}
+
+	if (type != STRING)
+	{
+		dt_column_cast(column, type);
+		return column->type == type ? DT_SUCCESS : DT_ALLOC_ERROR;
+	}
+
+	struct DataColumn* strings = NULL;
+	if (dt_column_create_with_allocator(&strings, 0, STRING, table->allocator) != DT_SUCCESS)
+		return DT_ALLOC_ERROR;
+
+	struct dt_csv_record record;
+	dt_csv_record_init(&record, table->allocator);
+	char* value = NULL;
+	size_t value_capacity = 0;
+	enum status_code_e status = DT_SUCCESS;
+
+	size_t position = chunk->start;
+	while (strings->n_values < column->n_values && status == DT_SUCCESS)
+	{
+		if (chunk->rows)
+			position = chunk->rows[strings->n_values];
+
+		status = dt_csv_tokenize_record(chunk->source->data, chunk->source->size, chunk->delim, &position, &record);
+		if (status != DT_SUCCESS || record.n_spans == 0)
+			continue;
+
+		if (field >= record.n_spans || record.spans[field].length == 0)
+			status = dt_column_append_value(strings, NULL);
+		else if (__csv_span_to_string(chunk->source->data, &record.spans[field], table->allocator, &value, &value_capacity, NULL))
+			status = dt_column_append_value(strings, value);
+		else
+			status = DT_ALLOC_ERROR;
+	}
+
+	dt_csv_record_free(&record);
+	dt_free(table->allocator, value);
+
+	if (status != DT_SUCCESS)
+	{
+		dt_column_free(&strings);
+		return status;
+	}
+
+	dt_column_free(&table->columns[k].column);
+	table->columns[k].column = strings;
+	return DT_SUCCESS;
+}
+
+// whether [column] has UINT64 values above INT64_MAX
+static bool
+__has_large_integers(
+	const struct DataColumn* const column)
+{
+	uint64_t max = 0;
+	if (column->type != UINT64 || column->n_null_values == column->n_values)
+		return false;
+
+	dt_column_max(column, &max);
+	return max > INT64_MAX;
+}
+
+// promote column [k] of the chunk's table so that it can hold its field of the current record
+// (which doesn't fit its type). a column without any (non-null) value yet takes the type of the
+// value instead, so the final type of every column doesn't depend on where the input was split.
+static enum status_code_e
+__promote_csv_column_for_field(
+	struct __csv_chunk* const chunk,
+	const size_t k)
+{
+	const struct DataColumn* const column = chunk->table->columns[k].column;
+	const char* value_str = __csv_field(chunk, chunk->layout->fields[k]);
+	if (!value_str)
+		return chunk->status;
+
+	const enum data_type_e value_type = __csv_value_type(value_str);
+	enum data_type_e type = column->n_null_values == column->n_values
+		? value_type
+		: __join_inferred_types(column->type, value_type);
+
+	// negative integers and ones above INT64_MAX only fit in a DOUBLE
+	if (type == INT64 && (value_type == UINT64 || __has_large_integers(column)))
+		type = DOUBLE;
+
+	return type != column->type ? __promote_csv_column(chunk, k, type) : DT_SUCCESS;
+}
+
+// inference pass: gather the facts of every column (and filter) without storing any values
+static void*
+__infer_csv_chunk(
+	void* arg)
+{
+	struct __csv_chunk* chunk = arg;
+	size_t position = chunk->start;
+	chunk->status = DT_SUCCESS;
+
+	const size_t n_fields = chunk->layout->n_columns + chunk->layout->n_filters;
+	for (size_t i = 0; i < n_fields; ++i)
+		__init_inference_facts(&chunk->facts[i]);
+
+	size_t n_records = 0;
+	while ((chunk->max_records == 0 || n_records < chunk->max_records) && __next_csv_record(chunk, &position))
+	{
+		for (size_t i = 0; i < n_fields; ++i)
+		{
+			const char* value = __csv_field(chunk, chunk->layout->fields[i]);
+			if (value)
+				__add_inference_fact(&chunk->facts[i], value);
+			else if (chunk->status != DT_SUCCESS)
+				return NULL;
+		}
+		n_records++;
+	}
+
+	chunk->end_position = position;
+	return NULL;
+}
+
+// whether the current record passes every filter of the chunk's layout.
+// sets chunk->status on error
+static bool
+__filter_csv_record(
+	struct __csv_chunk* const chunk)
+{
+	const struct __csv_layout* const layout = chunk->layout;
+	for (size_t f = 0; f < layout->n_filters; ++f)
+	{
+		const enum data_type_e type = layout->filter_types[f];
+		size_t length = 0;
+		const char* value = __csv_value(chunk, layout->fields[layout->n_columns + f], type, &length);
+		if (!value && chunk->status != DT_SUCCESS)
+			return false;
+
+		union __csv_scalar scalar;
+		void* item = value
+			? __parse_csv_scalar(type, DT_DEFAULT_TIME_UNIT, value, length, &scalar)
+			: NULL;
+		if (!layout->filter_callbacks[f](item, layout->filter_user_data))
+			return false;
+	}
+
+	return true;
+}
+
+// parse the fields of the current record straight into the typed columns of the chunk's table,
+// unless it doesn't pass the filters. fields of other columns are never looked at.
+// empty and missing fields are null values.
+// returns false on error (see chunk->status).
+static bool
+__append_csv_record(
+	struct __csv_chunk* const chunk)
+{
+	if (!__filter_csv_record(chunk))
+		return chunk->status == DT_SUCCESS;
+
+	struct DataTable* const table = chunk->table;
+	const size_t* const fields = chunk->layout->fields;
+	for (size_t i = 0; i < table->n_columns; ++i)
+	{
+		struct DataColumn* column = table->columns[i].column;
+		size_t length = 0;
+		const char* value = __csv_value(chunk, fields[i], column->type, &length);
+		if (!value && chunk->status != DT_SUCCESS)
+			return false;
+
+		if (value && chunk->promote && !__fits_inferred_type(column->type, value, length))
+		{
+			if ((chunk->status = __promote_csv_column_for_field(chunk, i)) != DT_SUCCESS)
+				return false;
+
+			column = table->columns[i].column;
+			if (!(value = __csv_value(chunk, fields[i], column->type, &length)))
+				return false;
+		}
+
+		chunk->status = value
+			? __append_csv_value(column, value, length)
+			: dt_column_append_value(column, NULL);
+		if (chunk->status != DT_SUCCESS)
+			return false;
+	}
+	table->n_rows++;
+
+	return true;
+}
+
+// parsing pass: parse every record of the chunk into its table
+static void*
+__parse_csv_chunk(
+	void* arg)
+{
+	struct __csv_chunk* chunk = arg;
+	size_t position = chunk->start;
+	chunk->status = DT_SUCCESS;
+
+	while (__next_csv_record(chunk, &position))
+	{
+		if (!__append_csv_record(chunk))
+			return NULL;
+	}
+
+	chunk->end_position = position;
+	return NULL;
+}
+
+// run [work] on every chunk, each on its own thread (the first one on the calling thread).
+// chunks whose thread couldn't be started are run on the calling thread instead.
+static void
+__run_csv_chunks(
+	void* (*work)(void*),
+	struct __csv_chunk* const chunks,
+	const size_t n_chunks)
+{
+#ifdef DT_HAVE_PTHREADS
+	for (size_t i = 1; i < n_chunks; ++i)
+		chunks[i].is_thread_started = pthread_create(&chunks[i].thread, NULL, work, &chunks[i]) == 0;
+
+	work(&chunks[0]);
+
+	for (size_t i = 1; i < n_chunks; ++i)
+	{
+		if (chunks[i].is_thread_started)
+			pthread_join(chunks[i].thread, NULL);
+		else
+			work(&chunks[i]);
+	}
+#else
+	for (size_t i = 0; i < n_chunks; ++i)
+		work(&chunks[i]);
+#endif
+}
+
+// check the guessed chunk starts in order. a chunk that doesn't start exactly where the
+// previous (by now correct) one ended is run again from there with [work].
+static enum status_code_e
+__fix_csv_chunk_starts(
+	void* (*work)(void*),
+	struct __csv_chunk* const chunks,
+	const size_t n_chunks,
+	const struct DataTable* const skeleton)
+{
+	for (size_t i = 0; i < n_chunks; ++i)
+	{
+		struct __csv_chunk* chunk = &chunks[i];
+		if (i > 0 && chunk->start != chunks[i - 1].end_position)
+		{
+			if (chunk->table)
+			{
+				dt_table_free(&chunk->table);
+				chunk->table = dt_table_copy_skeleton(skeleton);
+				if (!chunk->table)
+					return DT_ALLOC_ERROR;
+			}
+
+			chunk->start = chunks[i - 1].end_position;
+			if (chunk->end < chunk->start)
+				chunk->end = chunk->start;
+			work(chunk);
+		}
+
+		if (chunk->status != DT_SUCCESS)
+			return chunk->status;
+	}
+
+	return DT_SUCCESS;
+}
+
+// split the records from [position] of [source] between [n_chunks] chunks at guessed record
+// boundaries (see dt_csv_speculate_record_start and __fix_csv_chunk_starts), with [facts]
+// (if any) for the fields of [layout] of every chunk one after the other
+static void
+__init_csv_chunks(
+	struct __csv_chunk* const chunks,
+	const size_t n_chunks,
+	const struct dt_csv_source* const source,
+	const char delim,
+	const size_t position,
+	const struct __csv_layout* const layout,
+	struct __inference_facts* const facts)
+{
+	const size_t n_fields = layout->n_columns + layout->n_filters;
+	const size_t chunk_size = (source->size - position) / n_chunks;
+	for (size_t i = 0; i < n_chunks; ++i)
+	{
+		struct __csv_chunk* chunk = &chunks[i];
+		chunk->source = source;
+		chunk->delim = delim;
+		chunk->layout = layout;
+		chunk->facts = facts ? &facts[i * n_fields] : NULL;
+		chunk->status = DT_SUCCESS;
+		dt_csv_record_init(&chunk->record, source->allocator);
+
+		if (i == 0)
+			chunk->start = position;
+		else
+		{
+			chunk->start = dt_csv_speculate_record_start(source->data, source->size, delim, position + i * chunk_size);
+			if (chunk->start < chunks[i - 1].start)
+				chunk->start = chunks[i - 1].start;
+			chunks[i - 1].end = chunk->start;
+		}
+		chunk->end = source->size;
+	}
+}
+
+// infer the [types] of the fields of the chunk's layout from its first [n_records] records
+// (which may run past the end of the chunk)
+static enum status_code_e
+__infer_csv_sample(
+	struct __csv_chunk* const chunk,
+	const size_t n_records,
+	enum data_type_e* const types)
+{
+	struct __csv_chunk sample = *chunk;
+	sample.end = chunk->source->size;
+	sample.max_records = n_records;
+	__infer_csv_chunk(&sample);
+
+	// the record and the scratch buffer may have grown
+	chunk->record = sample.record;
+	chunk->value = sample.value;
+	chunk->value_capacity = sample.value_capacity;
+	if (sample.status != DT_SUCCESS)
+		return sample.status;
+
+	for (size_t k = 0; k < chunk->layout->n_columns + chunk->layout->n_filters; ++k)
+		types[k] = __type_from_inference_facts(&sample.facts[k]);
+
+	return DT_SUCCESS;
+}
+
+// move the rows parsed by every chunk into the table of the first one, in order.
+// chunks may have promoted their columns differently, so they're promoted to the widest
+// type among them first.
+static enum status_code_e
+__join_csv_chunks(
+	struct __csv_chunk* const chunks,
+	const size_t n_chunks)
+{
+	struct DataTable* const table = chunks[0].table;
+	enum status_code_e status = DT_SUCCESS;
+
+	for (size_t k = 0; k < table->n_columns && chunks[0].promote; ++k)
+	{
+		// columns with only nulls keep the type they started with
+		enum data_type_e type = table->columns[k].column->type;
+		bool contains_value = false;
+		for (size_t i = 0; i < n_chunks; ++i)
+		{
+			const struct DataColumn* column = chunks[i].table->columns[k].column;
+			if (column->n_null_values < column->n_values)
+			{
+				type = contains_value ? __join_inferred_types(type, column->type) : column->type;
+				contains_value = true;
+			}
+		}
+
+		for (size_t i = 0; i < n_chunks && type == INT64; ++i)
+		{
+			if (__has_large_integers(chunks[i].table->columns[k].column))
+				type = DOUBLE;
+		}
+
+		for (size_t i = 0; i < n_chunks; ++i)
+		{
+			if (chunks[i].table->columns[k].column->type != type
+					&& (status = __promote_csv_column(&chunks[i], k, type)) != DT_SUCCESS)
+				return status;
+		}
+	}
+
+	for (size_t i = 1; i < n_chunks; ++i)
+	{
+		for (size_t k = 0; k < table->n_columns; ++k)
+		{
+			status = dt_column_append_move(table->columns[k].column, chunks[i].table->columns[k].column);
+			if (status != DT_SUCCESS)
+				return status;
+		}
+		table->n_rows += chunks[i].table->n_rows;
+		chunks[i].table->n_rows = 0;
+	}
+
+	return DT_SUCCESS;
+}
+
+// read the records from [position] into [table] (whose columns are still empty) with [n_chunks]
+// threads, parsing the fields of [layout] straight into columns of [column_types] (one per field of
+// the input, inferred if NULL). records that don't pass the filters of [layout] are skipped.
+//
+// the input is split at guessed record boundaries (see dt_csv_speculate_record_start) and
+// every chunk is parsed into its own table before they're moved into [table] in order.
+// a chunk is read again from the right place if the previous one didn't end exactly where it
+// was guessed to start, so the result is always the same as reading with a single chunk.
+//
+// to infer types, a first pass only gathers the facts of every column (see __infer_csv_chunk),
+// so values are never stored as strings before being converted. with [n_inference_rows],
+// the first pass only reads that many records and columns are promoted while parsing
+// when a later value doesn't fit (see __promote_csv_column_for_field); chunks are then promoted
+// to the widest type among them before being moved into [table]. filters need their type before
+// parsing starts, so with filters every record is looked at first.
+static enum status_code_e
+__read_csv_records(
+	const struct dt_csv_source* const source,
+	const char delim,
+	const size_t position,
+	struct DataTable* const table,
+	struct __csv_layout* const layout,
+	const enum data_type_e* const column_types,
+	const size_t n_inference_rows,
+	const size_t n_chunks)
+{
+	const struct dt_allocator* const allocator = table->allocator;
+	const size_t n_columns = table->n_columns;
+	const size_t n_fields = n_columns + layout->n_filters;
+	enum status_code_e status = DT_SUCCESS;
+
+	struct __csv_chunk* chunks = dt_calloc(allocator, n_chunks, sizeof(*chunks));
+	struct __inference_facts* facts = column_types || n_fields == 0
+		? NULL
+		: dt_calloc(allocator, n_chunks * n_fields, sizeof(*facts));
+	enum data_type_e* types = n_fields == 0
+		? NULL
+		: dt_calloc(allocator, n_fields, sizeof(*types));
+
+	if (!chunks || (n_fields > 0 && !types) || (!column_types && n_fields > 0 && !facts))
+	{
+		status = DT_ALLOC_ERROR;
+		goto cleanup;
+	}
+
+	__init_csv_chunks(chunks, n_chunks, source, delim, position, layout, facts);
+
+	if (column_types)
+	{
+		for (size_t k = 0; k < n_fields; ++k)
+			types[k] = column_types[layout->fields[k]];
+	}
+	else if (n_inference_rows > 0 && layout->n_filters == 0)
+	{
+		if ((status = __infer_csv_sample(&chunks[0], n_inference_rows, types)) != DT_SUCCESS)
+			goto cleanup;
+
+		for (size_t i = 0; i < n_chunks; ++i)
+			chunks[i].promote = true;
+	}
+	else
+	{
+		__run_csv_chunks(&__infer_csv_chunk, chunks, n_chunks);
+		if ((status = __fix_csv_chunk_starts(&__infer_csv_chunk, chunks, n_chunks, NULL)) != DT_SUCCESS)
+			goto cleanup;
+
+		for (size_t k = 0; k < n_fields; ++k)
+		{
+			struct __inference_facts column_facts;
+			__init_inference_facts(&column_facts);
+			for (size_t i = 0; i < n_chunks; ++i)
+				__merge_inference_facts(&column_facts, &chunks[i].facts[k]);
+			types[k] = __type_from_inference_facts(&column_facts);
+		}
+	}
+
+	if ((status = __set_empty_column_types(table, types)) != DT_SUCCESS)
+		goto cleanup;
+
+	for (size_t f = 0; f < layout->n_filters; ++f)
+		layout->filter_types[f] = types[n_columns + f];
+
+	// the first chunk fills [table] directly
+	for (size_t i = 0; i < n_chunks; ++i)
+	{
+		chunks[i].table = i == 0 ? table : dt_table_copy_skeleton(table);
+		if (!chunks[i].table)
+		{
+			status = DT_ALLOC_ERROR;
+			goto cleanup;
+		}
+	}
+
+	__run_csv_chunks(&__parse_csv_chunk, chunks, n_chunks);
+	if ((status = __fix_csv_chunk_starts(&__parse_csv_chunk, chunks, n_chunks, table)) != DT_SUCCESS)
+		goto cleanup;
+
+	status = __join_csv_chunks(chunks, n_chunks);
+
+cleanup:
+	if (chunks)
+	{
+		for (size_t i = 0; i < n_chunks; ++i)
+		{
+			if (chunks[i].record.allocator)
+				dt_csv_record_free(&chunks[i].record);
+			if (chunks[i].value)
+				dt_free(allocator, chunks[i].value);
+			if (i > 0 && chunks[i].table)
+				dt_table_free(&chunks[i].table);
+		}
+	}
+	dt_free(allocator, chunks);
+	dt_free(allocator, facts);
+	dt_free(allocator, types);
+
+	return status;
+}
+
+// records streamed with a dt_csv_reader: only a window of the input is held (see dt_csv_stream),
+// and every batch is parsed into a copy of [skeleton] with the chunk's tokenizer and scratch buffer
+struct dt_csv_reader
+{
+	struct dt_csv_stream stream;
+
+	// start of the next record in the window
+	size_t position;
+
+	// empty table with the names and types of the columns of every batch
+	struct DataTable* skeleton;
+
+	struct __csv_layout layout;
+	struct __csv_chunk chunk;
+
+	enum status_code_e status;
+};
+
+// tokenize the next record with any fields at [*position] of the reader's window into its record
+// and move [*position] past it. the input is read further until the record is complete, i.e.
+// followed by more data or the end of the input; data before the reader's position is dropped
+// then, so [*position] moves back by as much.
+// [*has_record] is false at the end of the input.
+static enum status_code_e
+__next_streamed_csv_record(
+	struct dt_csv_reader* const reader,
+	size_t* const position,
+	bool* const has_record)
+{
+	struct dt_csv_stream* const stream = &reader->stream;
+	struct __csv_chunk* const chunk = &reader->chunk;
+	*has_record = false;
+
+	while (*position < stream->window.size || !stream->is_eof)
+	{
+		if (*position < stream->window.size)
+		{
+			size_t next = *position;
+			const enum status_code_e status = dt_csv_tokenize_record(
+					stream->window.data,
+					stream->window.size,
+					chunk->delim,
+					&next,
+					&chunk->record);
+			if (status != DT_SUCCESS)
+				return status;
+
+			if (next < stream->window.size || stream->is_eof)
+			{
+				*position = next;
+				if (chunk->record.n_spans == 0)
+					continue;
+
+				*has_record = true;
+				return DT_SUCCESS;
+			}
+		}
+
+		// [position] may be the reader's position
+		const size_t offset = *position - reader->position;
+		const enum status_code_e status = dt_csv_stream_read(stream, reader->position);
+		if (status != DT_SUCCESS)
+			return status;
+
+		reader->position = 0;
+		*position = offset;
+		chunk->record.block_data = NULL;
+	}
+
+	return DT_SUCCESS;
+}
+
+// read the header and the first [n_inference_rows] records (without consuming them) to set up
+// the reader's layout and skeleton table (of the columns in [options]) with options->column_types,
+// or the types inferred from those records
+static enum status_code_e
+__read_csv_schema(
+	struct dt_csv_reader* const reader,
+	const struct dt_csv_options* const options,
+	const size_t n_inference_rows)
+{
+	struct __csv_chunk* const chunk = &reader->chunk;
+	struct __csv_layout* const layout = &reader->layout;
+
+	// the header must be complete in the window before it's parsed
+	size_t position = 0;
+	bool has_record = false;
+	enum status_code_e status = __next_streamed_csv_record(reader, &position, &has_record);
+	if (status != DT_SUCCESS)
+		return status;
+
+	struct DataTable* header = __parse_header_from_csv(&reader->stream.window, chunk->delim, &reader->position, &chunk->record);
+	if (!header)
+		return DT_FAILURE;
+
+	if ((status = __init_csv_layout(header, options, layout)) != DT_SUCCESS)
+	{
+		dt_table_free(&header);
+		return status;
+	}
+
+	reader->skeleton = __select_csv_columns(header, options);
+	if (!reader->skeleton)
+		return DT_ALLOC_ERROR;
+	chunk->layout = layout;
+
+	const struct dt_allocator* const allocator = reader->skeleton->allocator;
+	const size_t n_fields = layout->n_columns + layout->n_filters;
+	struct __inference_facts* facts = NULL;
+	enum data_type_e* types = n_fields > 0 ? dt_calloc(allocator, n_fields, sizeof(*types)) : NULL;
+	if (n_fields > 0 && !types)
+		return DT_ALLOC_ERROR;
+
+	if (options->column_types)
+	{
+		for (size_t i = 0; i < n_fields; ++i)
+			types[i] = options->column_types[layout->fields[i]];
+		goto set_types;
+	}
+
+	facts = n_fields > 0 ? dt_calloc(allocator, n_fields, sizeof(*facts)) : NULL;
+	if (n_fields > 0 && !facts)
+	{
+		status = DT_ALLOC_ERROR;
+		goto cleanup;
+	}
+
+	for (size_t i = 0; i < n_fields; ++i)
+		__init_inference_facts(&facts[i]);
+
+	position = reader->position;
+	for (size_t n_records = 0; n_records < n_inference_rows; ++n_records)
+	{
+		status = __next_streamed_csv_record(reader, &position, &has_record);
+		if (status != DT_SUCCESS || !has_record)
+			break;
+
+		for (size_t i = 0; i < n_fields; ++i)
+		{
+			const char* value = __csv_field(chunk, layout->fields[i]);
+			if (value)
+				__add_inference_fact(&facts[i], value);
+			else if ((status = chunk->status) != DT_SUCCESS)
+				goto cleanup;
+		}
+	}
+
+	if (status != DT_SUCCESS)
+		goto cleanup;
+
+	for (size_t i = 0; i < n_fields; ++i)
+		types[i] = __type_from_inference_facts(&facts[i]);
+
+set_types:
+	for (size_t f = 0; f < layout->n_filters; ++f)
+		layout->filter_types[f] = types[layout->n_columns + f];
+	status = __set_empty_column_types(reader->skeleton, types);
+
+cleanup:
+	dt_free(allocator, facts);
+	dt_free(allocator, types);
+
+	return status;
+}
+
+// pending columns of a table read with dt_csv_options.lazy. when the table is read, the input
+// is kept open and only the start of every record is indexed; each column is then parsed on its
+// own (with the same threads, inference and promotion as when reading eagerly) the first time
+// it's needed (see __load_column)
+struct dt_lazy_csv
+{
+	struct dt_csv_source source;
+	char delim;
+
+	// start of the record of every row
+	size_t* rows;
+
+	// columns of the table that haven't been parsed yet (still empty, of the type given or
+	// inferred from the sample) and the field each one is read from
+	struct DataColumn** columns;
+	size_t* fields;
+	size_t n_columns;
+
+	// columns are promoted when a value doesn't fit (i.e. their type was inferred)
+	bool promote;
+	bool shrink;
+	size_t n_threads;
+};
+
+// indexing pass of a lazy table: gather the start of every record of the chunk that passes the
+// filters, without parsing the fields of any column
+static void*
+__index_csv_chunk(
+	void* arg)
+{
+	struct __csv_chunk* chunk = arg;
+	size_t position = chunk->start;
+	chunk->status = DT_SUCCESS;
+	chunk->n_rows = 0;
+
+	while (position < chunk->end)
+	{
+		const size_t record_start = position;
+		chunk->status = dt_csv_tokenize_record(
+				chunk->source->data,
+				chunk->source->size,
+				chunk->delim,
+				&position,
+				&chunk->record);
+		if (chunk->status != DT_SUCCESS)
+			return NULL;
+
+		// blank lines are skipped
+		if (chunk->record.n_spans == 0)
+			continue;
+
+		if (!__filter_csv_record(chunk))
+		{
+			if (chunk->status != DT_SUCCESS)
+				return NULL;
+			continue;
+		}
+
+		if (chunk->n_rows == chunk->row_capacity)
+		{
+			const size_t capacity = chunk->row_capacity > 0 ? chunk->row_capacity * 2 : 1024;
+			size_t* rows = dt_realloc(
+					chunk->record.allocator,
+					chunk->rows,
+					chunk->row_capacity * sizeof(*rows),
+					capacity * sizeof(*rows));
+			if (!rows)
+			{
+				chunk->status = DT_ALLOC_ERROR;
+				return NULL;
+			}
+			chunk->rows = rows;
+			chunk->row_capacity = capacity;
+		}
+		chunk->rows[chunk->n_rows++] = record_start;
+	}
+
+	chunk->end_position = position;
+	return NULL;
+}
+
+// parsing pass of a lazy column: parse the indexed records of the chunk into its table
+static void*
+__parse_csv_rows(
+	void* arg)
+{
+	struct __csv_chunk* chunk = arg;
+	chunk->status = DT_SUCCESS;
+
+	for (size_t r = 0; r < chunk->n_rows; ++r)
+	{
+		size_t position = chunk->rows[r];
+		chunk->status = dt_csv_tokenize_record(
+				chunk->source->data,
+				chunk->source->size,
+				chunk->delim,
+				&position,
+				&chunk->record);
+		if (chunk->status != DT_SUCCESS || !__append_csv_record(chunk))
+			return NULL;
+	}
+
+	return NULL;
+}
+
+// release the input and the index of a lazy [table] (its pending columns stay empty)
+static void
+__free_lazy_csv(
+	struct DataTable* const table)
+{
+	struct dt_lazy_csv* const lazy = table->lazy;
+	if (!lazy)
+		return;
+
+	if (lazy->source.data)
+		dt_csv_source_close(&lazy->source);
+	dt_free(table->allocator, lazy->rows);
+	dt_free(table->allocator, lazy->columns);
+	dt_free(table->allocator, lazy->fields);
+	dt_free(table->allocator, lazy);
+	table->lazy = NULL;
+}
+
+// index the records from [position] of [source] into the lazy [table] (whose columns are still
+// empty) with the fields, filters and [options] of [layout]: the types of the columns are given
+// or inferred from a sample, and the rows that pass the filters are counted and indexed with
+// several threads (see __read_csv_records). [source] is then owned by the table.
+static enum status_code_e
+__read_lazy_csv(
+	struct dt_csv_source* const source,
+	const char delim,
+	const size_t position,
+	struct DataTable* const table,
+	struct __csv_layout* const layout,
+	const struct dt_csv_options* const options)
+{
+	const struct dt_allocator* const allocator = table->allocator;
+	const size_t n_columns = table->n_columns;
+	const size_t n_fields = n_columns + layout->n_filters;
+	const size_t n_chunks = __csv_chunk_count(options->n_threads, source->size - position);
+	enum status_code_e status = DT_SUCCESS;
+
+	struct dt_lazy_csv* lazy = dt_calloc(allocator, 1, sizeof(*lazy));
+	struct __csv_chunk* chunks = dt_calloc(allocator, n_chunks, sizeof(*chunks));
+	struct __inference_facts* facts = options->column_types || n_fields == 0
+		? NULL
+		: dt_calloc(allocator, n_fields, sizeof(*facts));
+	enum data_type_e* types = n_fields == 0
+		? NULL
+		: dt_calloc(allocator, n_fields, sizeof(*types));
+
+	if (!lazy || !chunks || (n_fields > 0 && !types) || (!options->column_types && n_fields > 0 && !facts))
+	{
+		status = DT_ALLOC_ERROR;
+		goto cleanup;
+	}
+
+	table->lazy = lazy;
+	lazy->columns = n_columns > 0 ? dt_calloc(allocator, n_columns, sizeof(*lazy->columns)) : NULL;
+	lazy->fields = n_columns > 0 ? dt_calloc(allocator, n_columns, sizeof(*lazy->fields)) : NULL;
+	if (n_columns > 0 && (!lazy->columns || !lazy->fields))
+	{
+		status = DT_ALLOC_ERROR;
+		goto cleanup;
+	}
+
+	// only the first chunk gathers facts (from the sample)
+	__init_csv_chunks(chunks, n_chunks, source, delim, position, layout, NULL);
+	chunks[0].facts = facts;
+
+	if (options->column_types)
+	{
+		for (size_t k = 0; k < n_fields; ++k)
+			types[k] = options->column_types[layout->fields[k]];
+	}
+	else
+	{
+		// the input isn't parsed up front, so the types are always sampled
+		const size_t n_inference_rows = options->n_inference_rows > 0
+			? options->n_inference_rows
+			: DT_CSV_DEFAULT_INFERENCE_ROWS;
+		if ((status = __infer_csv_sample(&chunks[0], n_inference_rows, types)) != DT_SUCCESS)
+			goto cleanup;
+	}
+
+	for (size_t f = 0; f < layout->n_filters; ++f)
+		layout->filter_types[f] = types[n_columns + f];
+
+	if ((status = __set_empty_column_types(table, types)) != DT_SUCCESS)
+		goto cleanup;
+
+	__run_csv_chunks(&__index_csv_chunk, chunks, n_chunks);
+	if ((status = __fix_csv_chunk_starts(&__index_csv_chunk, chunks, n_chunks, NULL)) != DT_SUCCESS)
+		goto cleanup;
+
+	size_t n_rows = 0;
+	for (size_t i = 0; i < n_chunks; ++i)
+		n_rows += chunks[i].n_rows;
+
+	lazy->rows = n_rows > 0 ? dt_alloc(allocator, n_rows * sizeof(*lazy->rows)) : NULL;
+	if (n_rows > 0 && !lazy->rows)
+	{
+		status = DT_ALLOC_ERROR;
+		goto cleanup;
+	}
+
+	for (size_t i = 0; i < n_chunks; ++i)
+	{
+		if (chunks[i].n_rows > 0)
+			memcpy(&lazy->rows[table->n_rows], chunks[i].rows, chunks[i].n_rows * sizeof(*lazy->rows));
+		table->n_rows += chunks[i].n_rows;
+	}
+
+	for (size_t k = 0; k < n_columns; ++k)
+	{
+		lazy->columns[k] = table->columns[k].column;
+		lazy->fields[k] = layout->fields[k];
+	}
+	lazy->n_columns = n_columns;
+	lazy->delim = delim;
+	lazy->promote = !options->column_types;
+	lazy->shrink = options->shrink && !options->column_types;
+	lazy->n_threads = options->n_threads;
+
+	lazy->source = *source;
+	source->data = NULL;
+	source->size = 0;
+	source->is_mapped = false;
+
+cleanup:
+	if (chunks)
+	{
+		for (size_t i = 0; i < n_chunks; ++i)
+		{
+			if (chunks[i].record.allocator)
+				dt_csv_record_free(&chunks[i].record);
+			dt_free(allocator, chunks[i].value);
+			dt_free(allocator, chunks[i].rows);
+		}
+	}
+	dt_free(allocator, chunks);
+	dt_free(allocator, facts);
+	dt_free(allocator, types);
+
+	if (status != DT_SUCCESS)
+	{
+		if (table->lazy)
+			__free_lazy_csv(table);
+		else
+			dt_free(allocator, lazy);
+	}
+
+	return status;
+}
+
+// parse column [i] of [table] if it's still pending (see dt_lazy_csv). the input is released
+// once every column is parsed. the table is logically unchanged, so const tables are loaded too
+// (which isn't thread-safe).
+// returns DT_SUCCESS unless parsing failed (the column then stays empty)
+static enum status_code_e
+__load_column(
+	const struct DataTable* const table,
+	const size_t i)
+{
+	struct dt_lazy_csv* const lazy = table->lazy;
+	if (!lazy || i >= table->n_columns)
+		return DT_SUCCESS;
+
+	struct DataColumn* const column = table->columns[i].column;
+	size_t k = 0;
+	while (k < lazy->n_columns && lazy->columns[k] != column)
+		++k;
+	if (k == lazy->n_columns)
+		return DT_SUCCESS;
+
+	const struct dt_allocator* const allocator = table->allocator;
+	const size_t n_rows = table->n_rows;
+	const size_t n_chunks = __csv_chunk_count(lazy->n_threads, lazy->source.size);
+	enum status_code_e status = DT_SUCCESS;
+
+	struct __csv_layout layout = {
+		.fields = &lazy->fields[k],
+		.n_columns = 1
+	};
+
+	struct __csv_chunk* chunks = dt_calloc(allocator, n_chunks, sizeof(*chunks));
+	struct DataTable* loaded = dt_table_create_with_allocator(
+			1,
+			&table->columns[i].name,
+			&column->type,
+			allocator);
+	if (!chunks || !loaded)
+	{
+		status = DT_ALLOC_ERROR;
+		goto cleanup;
+	}
+
+	// every chunk parses as many rows
+	const size_t chunk_rows = n_rows / n_chunks;
+	for (size_t c = 0; c < n_chunks; ++c)
+	{
+		struct __csv_chunk* chunk = &chunks[c];
+		chunk->source = &lazy->source;
+		chunk->delim = lazy->delim;
+		chunk->layout = &layout;
+		chunk->promote = lazy->promote;
+		chunk->status = DT_SUCCESS;
+		chunk->rows = lazy->rows ? &lazy->rows[c * chunk_rows] : NULL;
+		chunk->n_rows = c + 1 < n_chunks ? chunk_rows : n_rows - c * chunk_rows;
+		dt_csv_record_init(&chunk->record, allocator);
+
+		chunk->table = c == 0 ? loaded : dt_table_copy_skeleton(loaded);
+		if (!chunk->table)
+		{
+			status = DT_ALLOC_ERROR;
+			goto cleanup;
+		}
+	}
+
+	__run_csv_chunks(&__parse_csv_rows, chunks, n_chunks);
+	for (size_t c = 0; c < n_chunks && status == DT_SUCCESS; ++c)
+		status = chunks[c].status;
+
+	if (status == DT_SUCCESS)
+		status = __join_csv_chunks(chunks, n_chunks);
+	if (status == DT_SUCCESS && lazy->shrink)
+		status = dt_column_shrink(loaded->columns[0].column);
+	if (status != DT_SUCCESS)
+		goto cleanup;
+
+	// the column keeps its address (pointers to it stay valid)
+	struct DataColumn parsed = *loaded->columns[0].column;
+	*loaded->columns[0].column = *column;
+	*column = parsed;
+
+	lazy->columns[k] = lazy->columns[lazy->n_columns - 1];
+	lazy->fields[k] = lazy->fields[lazy->n_columns - 1];
+	lazy->n_columns--;
+
+cleanup:
+	if (chunks)
+	{
+		for (size_t c = 0; c < n_chunks; ++c)
+		{
+			if (chunks[c].record.allocator)
+				dt_csv_record_free(&chunks[c].record);
+			dt_free(allocator, chunks[c].value);
+			if (c > 0 && chunks[c].table)
+				dt_table_free(&chunks[c].table);
+		}
+	}
+	dt_free(allocator, chunks);
+	dt_table_free(&loaded);
+
+	if (lazy->n_columns == 0)
+		__free_lazy_csv((struct DataTable*)table);
+
+	return status;
+}
+
+// parse every pending column of [table] (see __load_column)
+static enum status_code_e
+__load_columns(
+	const struct DataTable* const table)
+{
+	for (size_t i = 0; i < table->n_columns && table->lazy; ++i)
+	{
+		const enum status_code_e status = __load_column(table, i);
+		if (status != DT_SUCCESS)
+			return status;
+	}
+
+	return DT_SUCCESS;
+}
+
+// stop tracking [column] of a lazy [table] (e.g. it's dropped before being parsed)
+static void
+__forget_lazy_column(
+	struct DataTable* const table,
+	const struct DataColumn* const column)
+{
+	struct dt_lazy_csv* const lazy = table->lazy;
+	if (!lazy)
+		return;
+
+	for (size_t k = 0; k < lazy->n_columns; ++k)
+	{
+		if (lazy->columns[k] == column)
+		{
+			lazy->columns[k] = lazy->columns[lazy->n_columns - 1];
+			lazy->fields[k] = lazy->fields[lazy->n_columns - 1];
+			lazy->n_columns--;
+			break;
+		}
+	}
+
+	if (lazy->n_columns == 0)
+		__free_lazy_csv(table);
+}
+
+// dt_table_to_csv formats rows into a buffer of this many bytes written to the file at once
+#define DT_CSV_WRITE_BUFFER_SIZE (1024 * 1024)
+
+// formatted output waiting to be written to [output] (or kept in the buffer, which grows,
+// if [output] is NULL)
+struct __csv_writer
+{
+	struct dt_csv_output* output;
+	char* buffer;
+	size_t size;
+	size_t capacity;
+	const struct dt_allocator* allocator;
+	char delim;
+	enum status_code_e status;
+};
+
+// a column being written and its null values (sorted) from [next_null] on
+struct __csv_output_column
+{
+	const struct DataColumn* column;
+	size_t* nulls;
+	size_t next_null;
+};
+
+// blocks of rows formatted in parallel (see __export_csv_rows)
+#define DT_CSV_EXPORT_FIRST_BLOCK_ROWS 4096
+
+// rows of a table formatted by several threads into a ring of buffers ([n_slots] per thread)
+// that the calling thread writes in order. blocks are taken in order (from [next_row]) and
+// sized so that their text is about DT_CSV_WRITE_BUFFER_SIZE bytes.
+struct __csv_export
+{
+	const struct DataTable* table;
+	const struct __csv_output_column* columns;
+	char delim;
+
+	struct __csv_writer* slots;
+	// block formatted (or being formatted) in each slot, SIZE_MAX if free
+	size_t* slot_blocks;
+	bool* is_slot_ready;
+	size_t n_slots;
+
+	size_t next_row;
+	size_t next_block;
+	size_t rows_per_block;
+
+	enum status_code_e status;
+
+#ifdef DT_HAVE_PTHREADS
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+#endif
+};
+
+static enum status_code_e
+__flush_csv_writer(
+	struct __csv_writer* const writer)
+{
+	if (writer->size > 0 && writer->status == DT_SUCCESS)
+		writer->status = dt_csv_output_write(writer->output, writer->buffer, writer->size);
+
+	writer->size = 0;
+	return writer->status;
+}
+
+// room for [n] more bytes at the end of the buffer, flushing (or growing, for longer values
+// or without an output) it first if needed. returns NULL (with writer->status set) on failure
+static char*
+__reserve_csv_writer(
+	struct __csv_writer* const writer,
+	const size_t n)
+{
+	if (writer->size + n > writer->capacity)
+	{
+		if (writer->output && __flush_csv_writer(writer) != DT_SUCCESS)
+			return NULL;
+
+		if (writer->size + n > writer->capacity)
+		{
+			const size_t capacity = writer->size + n > writer->capacity * 2 ? writer->size + n : writer->capacity * 2;
+			char* buffer = dt_realloc(writer->allocator, writer->buffer, writer->capacity, capacity);
+			if (!buffer)
+			{
+				writer->status = DT_ALLOC_ERROR;
+				return NULL;
+			}
+			writer->buffer = buffer;
+			writer->capacity = capacity;
+		}
+	}
+
+	return writer->buffer + writer->size;
+}
+
+// write [str] as a field, quoted (with quotes doubled) if it contains the delimiter, a quote
+// or a line break, or if it's empty (so it's read back as an empty string rather than null)
+static void
+__write_csv_string(
+	struct __csv_writer* const writer,
+	const char* const str)
+{
+	const size_t length = str ? strlen(str) : 0;
+	const char special[] = { writer->delim, '"', '\'', '\n', '\r', '\0' };
+	const bool is_quoted = length == 0 || str[strcspn(str, special)] != '\0';
+	if (!is_quoted)
+	{
+		char* dest = __reserve_csv_writer(writer, length);
+		if (!dest)
+			return;
+
+		memcpy(dest, str, length);
+		writer->size += length;
+		return;
+	}
+
+	char* dest = __reserve_csv_writer(writer, length * 2 + 2);
+	if (!dest)
+		return;
+
+	char* start = dest;
+	*dest++ = '"';
+	for (size_t i = 0; i < length; ++i)
+	{
+		if (str[i] == '"')
+			*dest++ = '"';
+		*dest++ = str[i];
+	}
+	*dest++ = '"';
+	writer->size += (size_t)(dest - start);
+}
+
+// write the [value] of [column] as a field
+static void
+__write_csv_value(
+	struct __csv_writer* const writer,
+	const struct DataColumn* const column,
+	const void* const value)
+{
+	if (column->type == STRING)
+	{
+		__write_csv_string(writer, *(char* const*)value);
+		return;
+	}
+
+	// large enough for every other type
+	char* dest = __reserve_csv_writer(writer, DT_TIMESTAMP_BUFFER_SIZE);
+	if (!dest)
+		return;
+
+	size_t length = 0;
+	switch (column->type)
+	{
+		case FLOAT:
+			length = dt_format_float(*(const float*)value, dest);
+			break;
+		case DOUBLE:
+			length = dt_format_double(*(const double*)value, dest);
+			break;
+		case INT8:
+			length = dt_format_int64(*(const int8_t*)value, dest);
+			break;
+		case INT16:
+			length = dt_format_int64(*(const int16_t*)value, dest);
+			break;
+		case INT32:
+			length = dt_format_int64(*(const int32_t*)value, dest);
+			break;
+		case INT64:
+			length = dt_format_int64(*(const int64_t*)value, dest);
+			break;
+		case UINT8:
+			length = dt_format_uint64(*(const uint8_t*)value, dest);
+			break;
+		case UINT16:
+			length = dt_format_uint64(*(const uint16_t*)value, dest);
+			break;
+		case UINT32:
+			length = dt_format_uint64(*(const uint32_t*)value, dest);
+			break;
+		case UINT64:
+			length = dt_format_uint64(*(const uint64_t*)value, dest);
+			break;
+		case BOOL:
+			length = *(const bool*)value ? 4 : 5;
+			memcpy(dest, *(const bool*)value ? "true" : "false", length);
+			break;
+		case DATE:
+			length = dt_format_date(*(const int32_t*)value, dest);
+			break;
+		case TIMESTAMP:
+			length = dt_format_timestamp(*(const int64_t*)value, column->time_unit, dest);
+			break;
+		case STRING:
+			break;
+	}
+
+	writer->size += length;
+}
+
+// write [c] (a delimiter or line break)
+static void
+__write_csv_char(
+	struct __csv_writer* const writer,
+	const char c)
+{
+	char* dest = __reserve_csv_writer(writer, 1);
+	if (!dest)
+		return;
+
+	*dest = c;
+	writer->size++;
+}
+
+// format rows [start, end) of [table] into [writer]. [columns] (a copy per thread) are moved
+// to the first null value at or after [start]
+static void
+__write_csv_rows(
+	struct __csv_writer* const writer,
+	const struct DataTable* const table,
+	struct __csv_output_column* const columns,
+	const size_t start,
+	const size_t end)
+{
+	for (size_t i = 0; i < table->n_columns; ++i)
+	{
+		struct __csv_output_column* output_column = &columns[i];
+		size_t low = 0;
+		size_t high = output_column->column->n_null_values;
+		while (low < high)
+		{
+			const size_t middle = low + (high - low) / 2;
+			if (output_column->nulls[middle] < start)
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		output_column->next_null = low;
+	}
+
+	for (size_t row = start; row < end && writer->status == DT_SUCCESS; ++row)
+	{
+		for (size_t i = 0; i < table->n_columns; ++i)
+		{
+			if (i > 0)
+				__write_csv_char(writer, writer->delim);
+
+			struct __csv_output_column* output_column = &columns[i];
+			const struct DataColumn* column = output_column->column;
+			if (output_column->next_null < column->n_null_values && output_column->nulls[output_column->next_null] == row)
+			{
+				output_column->next_null++;
+				continue;
+			}
+
+			__write_csv_value(writer, column, dt_column_get_value_ptr(column, row));
+		}
+		__write_csv_char(writer, '\n');
+	}
+}
+
+// number of threads to write [n_rows] rows with ([requested] = 0 for one per CPU core)
+static size_t
+__csv_export_thread_count(
+	const size_t requested,
+	const size_t n_rows)
+{
+	size_t n_threads = requested;
+#ifdef DT_HAVE_PTHREADS
+	if (n_threads == 0)
+	{
+		const long n_cores = sysconf(_SC_NPROCESSORS_ONLN);
+		n_threads = n_cores > 0 ? (size_t)n_cores : 1;
+	}
+#else
+	n_threads = 1;
+#endif
+
+	const size_t max_threads = n_rows / DT_CSV_MIN_EXPORT_ROWS;
+	if (n_threads > max_threads)
+		n_threads = max_threads;
+
+	return n_threads > 0 ? n_threads : 1;
+}
+
+#ifdef DT_HAVE_PTHREADS
+// export thread: take the next block of rows whenever its slot is free and format it there
+static void*
+__export_csv_rows(
+	void* arg)
+{
+	struct __csv_export* export = arg;
+	const struct DataTable* table = export->table;
+
+	struct __csv_output_column* columns = dt_alloc(table->allocator, (table->n_columns + 1) * sizeof(*columns));
+	pthread_mutex_lock(&export->mutex);
+	if (!columns)
+	{
+		export->status = DT_ALLOC_ERROR;
+		pthread_cond_broadcast(&export->cond);
+	}
+	else
+		memcpy(columns, export->columns, table->n_columns * sizeof(*columns));
+
+	while (export->status == DT_SUCCESS && export->next_row < table->n_rows)
+	{
+		const size_t slot = export->next_block % export->n_slots;
+		if (export->slot_blocks[slot] != SIZE_MAX)
+		{
+			pthread_cond_wait(&export->cond, &export->mutex);
+			continue;
+		}
+
+		const size_t start = export->next_row;
+		const size_t end = table->n_rows - start > export->rows_per_block ? start + export->rows_per_block : table->n_rows;
+		export->slot_blocks[slot] = export->next_block++;
+		export->is_slot_ready[slot] = false;
+		export->next_row = end;
+		pthread_mutex_unlock(&export->mutex);
+
+		struct __csv_writer* writer = &export->slots[slot];
+		writer->size = 0;
+		__write_csv_rows(writer, table, columns, start, end);
+
+		pthread_mutex_lock(&export->mutex);
+		if (writer->status != DT_SUCCESS)
+			export->status = writer->status;
+
+		// aim for buffers of about DT_CSV_WRITE_BUFFER_SIZE bytes
+		const size_t row_size = writer->size / (end - start) + 1;
+		export->rows_per_block = DT_CSV_WRITE_BUFFER_SIZE / row_size + 1;
+		export->is_slot_ready[slot] = true;
+		pthread_cond_broadcast(&export->cond);
+	}
+	pthread_mutex_unlock(&export->mutex);
+
+	dt_free(table->allocator, columns);
+	return NULL;
+}
+
+// write the rows of [table] to [writer]'s output with [n_threads] threads formatting blocks
+// of rows while the calling thread writes the ones before them in order
+static void
+__export_csv_table(
+	struct __csv_writer* const writer,
+	const struct DataTable* const table,
+	struct __csv_output_column* const columns,
+	const size_t n_threads)
+{
+	struct __csv_export export = {
+		.table = table,
+		.columns = columns,
+		.delim = writer->delim,
+		.n_slots = n_threads * 2,
+		.rows_per_block = DT_CSV_EXPORT_FIRST_BLOCK_ROWS,
+		.status = DT_SUCCESS
+	};
+
+	pthread_t* threads = dt_calloc(table->allocator, n_threads, sizeof(pthread_t));
+	bool* is_thread_started = dt_calloc(table->allocator, n_threads, sizeof(bool));
+	export.slots = dt_calloc(table->allocator, export.n_slots, sizeof(*export.slots));
+	export.slot_blocks = dt_calloc(table->allocator, export.n_slots, sizeof(size_t));
+	export.is_slot_ready = dt_calloc(table->allocator, export.n_slots, sizeof(bool));
+	if (!threads || !is_thread_started || !export.slots || !export.slot_blocks || !export.is_slot_ready)
+	{
+		writer->status = DT_ALLOC_ERROR;
+		goto cleanup;
+	}
+
+	for (size_t i = 0; i < export.n_slots; ++i)
+	{
+		export.slot_blocks[i] = SIZE_MAX;
+		export.slots[i] = (struct __csv_writer){
+			.output = NULL,
+			.buffer = dt_alloc(table->allocator, DT_CSV_WRITE_BUFFER_SIZE),
+			.capacity = DT_CSV_WRITE_BUFFER_SIZE,
+			.allocator = table->allocator,
+			.delim = writer->delim,
+			.status = DT_SUCCESS
+		};
+		if (!export.slots[i].buffer)
+		{
+			writer->status = DT_ALLOC_ERROR;
+			goto cleanup;
+		}
+	}
+
+	pthread_mutex_init(&export.mutex, NULL);
+	pthread_cond_init(&export.cond, NULL);
+
+	size_t n_started = 0;
+	for (size_t i = 0; i < n_threads; ++i)
+	{
+		is_thread_started[i] = pthread_create(&threads[i], NULL, &__export_csv_rows, &export) == 0;
+		n_started += is_thread_started[i];
+	}
+
+	// formatted on the calling thread instead
+	if (n_started == 0)
+	{
+		__write_csv_rows(writer, table, columns, 0, table->n_rows);
+		__flush_csv_writer(writer);
+	}
+
+	for (size_t block = 0; n_started > 0; ++block)
+	{
+		const size_t slot = block % export.n_slots;
+
+		pthread_mutex_lock(&export.mutex);
+		while (export.status == DT_SUCCESS && writer->status == DT_SUCCESS
+				&& !(export.slot_blocks[slot] == block && export.is_slot_ready[slot])
+				&& !(export.next_block == block && export.next_row == table->n_rows))
+			pthread_cond_wait(&export.cond, &export.mutex);
+
+		const bool is_done = export.status != DT_SUCCESS || writer->status != DT_SUCCESS
+			|| export.slot_blocks[slot] != block;
+		pthread_mutex_unlock(&export.mutex);
+		if (is_done)
+			break;
+
+		const struct __csv_writer* formatted = &export.slots[slot];
+		if (writer->status == DT_SUCCESS && formatted->size > 0)
+			writer->status = dt_csv_output_write(writer->output, formatted->buffer, formatted->size);
+
+		pthread_mutex_lock(&export.mutex);
+		export.slot_blocks[slot] = SIZE_MAX;
+		// stops the other threads after a write error
+		if (writer->status != DT_SUCCESS)
+			export.status = writer->status;
+		pthread_cond_broadcast(&export.cond);
+		pthread_mutex_unlock(&export.mutex);
+	}
+
+	for (size_t i = 0; i < n_threads; ++i)
+		if (is_thread_started[i])
+			pthread_join(threads[i], NULL);
+
+	if (writer->status == DT_SUCCESS)
+		writer->status = export.status;
+
+	pthread_mutex_destroy(&export.mutex);
+	pthread_cond_destroy(&export.cond);
+
+cleanup:
+	if (export.slots)
+		for (size_t i = 0; i < export.n_slots; ++i)
+			dt_free(table->allocator, export.slots[i].buffer);
+	dt_free(table->allocator, export.slots);
+	dt_free(table->allocator, export.slot_blocks);
+	dt_free(table->allocator, export.is_slot_ready);
+	dt_free(table->allocator, threads);
+	dt_free(table->allocator, is_thread_started);
+}
+#endif
+
+// write the column names of [table] as a header line
+static void
+__write_csv_header(
+	struct __csv_writer* const writer,
+	const struct DataTable* const table)
+{
+	for (size_t i = 0; i < table->n_columns; ++i)
+	{
+		if (i > 0)
+			__write_csv_char(writer, writer->delim);
+		__write_csv_string(writer, table->columns[i].name);
+	}
+	__write_csv_char(writer, '\n');
+}
+
+// write every row of [table] with up to [n_threads] threads (see dt_csv_write_options):
+// values are formatted without snprintf (see NumberParsing.h) into large buffers and null
+// values are left empty. rows formatted on the calling thread may stay in [writer]'s buffer
+static enum status_code_e
+__write_csv_body(
+	struct __csv_writer* const writer,
+	const struct DataTable* const table,
+	const size_t n_threads)
+{
+	struct __csv_output_column* columns = dt_calloc(table->allocator, table->n_columns + 1, sizeof(*columns));
+	if (!columns)
+	{
+		writer->status = DT_ALLOC_ERROR;
+		return writer->status;
+	}
+
+	// rows are written in order, so each column's nulls are visited in order too
+	for (size_t i = 0; i < table->n_columns; ++i)
+	{
+		const struct DataColumn* column = table->columns[i].column;
+		columns[i].column = column;
+		if (column->n_null_values == 0)
+			continue;
+
+		columns[i].nulls = dt_alloc(table->allocator, column->n_null_values * sizeof(size_t));
+		if (!columns[i].nulls)
+		{
+			writer->status = DT_ALLOC_ERROR;
+			goto cleanup;
+		}
+		memcpy(columns[i].nulls, column->null_value_indices, column->n_null_values * sizeof(size_t));
+		qsort(columns[i].nulls, column->n_null_values, sizeof(size_t), &sizet_compare);
+	}
+
+	const size_t n_export_threads = __csv_export_thread_count(n_threads, table->n_rows);
+#ifdef DT_HAVE_PTHREADS
+	if (n_export_threads > 1)
+	{
+		__flush_csv_writer(writer);
+		if (writer->status == DT_SUCCESS)
+			__export_csv_table(writer, table, columns, n_export_threads);
+		goto cleanup;
+	}
+#else
+	(void)n_export_threads;
+#endif
+
+	__write_csv_rows(writer, table, columns, 0, table->n_rows);
+
+cleanup:
+	for (size_t i = 0; i < table->n_columns; ++i)
+		dt_free(table->allocator, columns[i].nulls);
+	dt_free(table->allocator, columns);
+	return writer->status;
+}
+
+// write [table] (with a header line if [header]) to [output], see __write_csv_body
+static enum status_code_e
+__write_csv_table(
+	const struct DataTable* const table,
+	struct dt_csv_output* const output,
+	const char delim,
+	const size_t n_threads,
+	const bool header)
+{
+	struct __csv_writer writer = {
+		.output = output,
+		.buffer = dt_alloc(table->allocator, DT_CSV_WRITE_BUFFER_SIZE),
+		.size = 0,
+		.capacity = DT_CSV_WRITE_BUFFER_SIZE,
+		.allocator = table->allocator,
+		.delim = delim,
+		.status = DT_SUCCESS
+	};
+	if (!writer.buffer)
+		return DT_ALLOC_ERROR;
+
+	if (header)
+		__write_csv_header(&writer, table);
+
+	__write_csv_body(&writer, table, n_threads);
+	__flush_csv_writer(&writer);
+
+	dt_free(table->allocator, writer.buffer);
+	return writer.status;
+}
+
+// writes CSV batches to the same output (see dt_csv_writer_open)
+struct dt_csv_writer
+{
+	struct dt_csv_output output;
+
+	// rows formatted but not written yet; writer.output is &output
+	struct __csv_writer writer;
+
+	// empty table with the names and types of the columns of every batch
+	struct DataTable* skeleton;
+
+	size_t n_threads;
+	bool sync;
+};
+
+// whether [batch] has the columns of [skeleton] (same count, names aren't compared)
+static enum status_code_e
+__check_csv_batch(
+	const struct DataTable* const skeleton,
+	const struct DataTable* const batch)
+{
+	if (batch->n_columns != skeleton->n_columns)
+		return DT_SIZE_MISMATCH;
+
+	for (size_t i = 0; i < skeleton->n_columns; ++i)
+	{
+		if (batch->columns[i].column->type != skeleton->columns[i].column->type)
+			return DT_TYPE_MISMATCH;
+	}
+
+	return DT_SUCCESS;
+}
+
+/*
+ * binary format of dt_table_save / dt_table_load. integers are in the byte order of the
+ * machine that wrote the file (checked with [byte_order] when reading):
+ *
+ *   struct __table_file_header
+ *   struct __table_file_column   (one per column)
+ *   buffers                      (each starting on a DT_BUFFER_ALIGNMENT boundary, zero padded)
+ *
+ * the values buffer of a column is laid out as in memory (one bit per value in 64-bit words
+ * for BOOL), except for STRING columns: n_rows + 1 uint64_t offsets into a bytes buffer where
+ * every value is followed by a null terminator (so it can be used in place) and null values
+ * take no bytes at all. columns with null values also have a validity bitmap (see
+ * dt_column_wrap). the header is written last, so an incomplete file has no magic number.
+ */
+#define DT_TABLE_FILE_MAGIC "DTBL"
+#define DT_TABLE_FILE_VERSION 1
+#define DT_TABLE_FILE_BYTE_ORDER 0x01020304
+#define DT_TABLE_FILE_NAME_SIZE 128
+
+// values staged at once for columns that can't be written as one buffer (e.g. chunked)
+#define DT_TABLE_FILE_BLOCK_SIZE 4096
+
+// 64 bytes
+struct __table_file_header
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t byte_order;
+	uint32_t reserved;
+	uint64_t n_rows;
+	uint64_t n_columns;
+
+	// size of the whole file (a shorter file was truncated)
+	uint64_t file_size;
+	uint64_t padding[3];
+};
+
+// 192 bytes; offsets are from the start of the file
+struct __table_file_column
+{
+	uint32_t type;
+	uint32_t time_unit;
+	uint64_t n_null_values;
+	uint64_t values_offset;
+	uint64_t values_size;
+
+	// 0 without null values
+	uint64_t validity_offset;
+
+	// STRING columns only
+	uint64_t bytes_offset;
+	uint64_t bytes_size;
+
+	uint64_t reserved;
+	char name[DT_TABLE_FILE_NAME_SIZE];
+};
+
+// file mapped by dt_table_load, which the columns of the table use in place
+struct dt_mapped_table
+{
+	struct dt_csv_source source;
+
+	// char* arrays (pointing into [source]) of the STRING columns
+	char*** strings;
+	size_t n_strings;
+};
+
+static void
+__free_mapped_table(
+	struct DataTable* const table)
+{
+	struct dt_mapped_table* const mapped = table->mapped;
+	if (!mapped)
+		return;
+
+	for (size_t i = 0; i < mapped->n_strings; ++i)
+		dt_free(table->allocator, mapped->strings[i]);
+	dt_free(table->allocator, mapped->strings);
+	if (mapped->source.data)
+		dt_csv_source_close(&mapped->source);
+	dt_free(table->allocator, mapped);
+	table->mapped = NULL;
+}
+
+// write [size] bytes at [data] at [*position] of [file] and move [*position] past them
+static bool
+__write_table_file(
+	FILE* const file,
+	const void* const data,
+	const size_t size,
+	uint64_t* const position)
+{
+	*position += size;
+	return fwrite(data, 1, size, file) == size;
+}
+
+// write zeros up to the next DT_BUFFER_ALIGNMENT boundary
+static bool
+__pad_table_file(
+	FILE* const file,
+	uint64_t* const position)
+{
+	static const char zeros[DT_BUFFER_ALIGNMENT] = {0};
+	const size_t padding = (DT_BUFFER_ALIGNMENT - *position % DT_BUFFER_ALIGNMENT) % DT_BUFFER_ALIGNMENT;
+	return __write_table_file(file, zeros, padding, position);
+}
+
+// write the values buffer of [column] (except for STRING columns)
+static enum status_code_e
+__write_table_file_values(
+	FILE* const file,
+	const struct DataColumn* const column,
+	uint64_t* const position)
+{
+	const size_t n_values = column->n_values;
+	if (column->type == BOOL)
+	{
+		// bits after the last value (and before the first one of a view) are zeroed
+		uint64_t words[DT_TABLE_FILE_BLOCK_SIZE];
+		for (size_t start = 0; start < n_values; start += DT_TABLE_FILE_BLOCK_SIZE * 64)
+		{
+			const size_t end = n_values - start > DT_TABLE_FILE_BLOCK_SIZE * 64 ? start + DT_TABLE_FILE_BLOCK_SIZE * 64 : n_values;
+			const size_t n_words = (end - start + 63) / 64;
+			memset(words, 0, n_words * sizeof(uint64_t));
+			for (size_t i = start; i < end; ++i)
+				if (*(bool*)dt_column_get_value_ptr(column, i))
+					words[(i - start) >> 6] |= (uint64_t)1 << ((i - start) & 63);
+
+			if (!__write_table_file(file, words, n_words * sizeof(uint64_t), position))
+				return DT_FAILURE;
+		}
+		return DT_SUCCESS;
+	}
+
+	if (column->chunk_size == 0)
+		return __write_table_file(file, column->value, n_values * column->type_size, position) ? DT_SUCCESS : DT_FAILURE;
+
+	// one write per run of values in the same chunk
+	for (size_t i = 0; i < n_values;)
+	{
+		const size_t in_chunk = column->chunk_size - ((column->chunk_offset + i) & (column->chunk_size - 1));
+		const size_t n_run = n_values - i < in_chunk ? n_values - i : in_chunk;
+		if (!__write_table_file(file, dt_column_get_value_ptr(column, i), n_run * column->type_size, position))
+			return DT_FAILURE;
+		i += n_run;
+	}
+
+	return DT_SUCCESS;
+}
+
+// write the offsets buffer, then (aligned) the bytes buffer of a STRING [column]
+static enum status_code_e
+__write_table_file_strings(
+	FILE* const file,
+	const struct DataColumn* const column,
+	struct __table_file_column* const descriptor,
+	uint64_t* const position)
+{
+	uint64_t offsets[DT_TABLE_FILE_BLOCK_SIZE];
+	uint64_t offset = 0;
+	size_t n_staged = 0;
+	for (size_t i = 0; i <= column->n_values; ++i)
+	{
+		offsets[n_staged++] = offset;
+		if (n_staged == DT_TABLE_FILE_BLOCK_SIZE || i == column->n_values)
+		{
+			if (!__write_table_file(file, offsets, n_staged * sizeof(uint64_t), position))
+				return DT_FAILURE;
+			n_staged = 0;
+		}
+
+		if (i < column->n_values)
+		{
+			const char* const value = *(char**)dt_column_get_value_ptr(column, i);
+			offset += value ? strlen(value) + 1 : 0;
+		}
+	}
+
+	if (!__pad_table_file(file, position))
+		return DT_FAILURE;
+
+	descriptor->bytes_offset = *position;
+	descriptor->bytes_size = offset;
+	for (size_t i = 0; i < column->n_values; ++i)
+	{
+		const char* const value = *(char**)dt_column_get_value_ptr(column, i);
+		if (value && !__write_table_file(file, value, strlen(value) + 1, position))
+			return DT_FAILURE;
+	}
+
+	return DT_SUCCESS;
+}
+
+// write the validity bitmap of [column] (which has null values)
+static enum status_code_e
+__write_table_file_validity(
+	FILE* const file,
+	const struct DataColumn* const column,
+	const struct dt_allocator* const allocator,
+	uint64_t* const position)
+{
+	const size_t size = (column->n_values + 7) / 8;
+	uint8_t* validity = dt_alloc(allocator, size);
+	if (!validity)
+		return DT_ALLOC_ERROR;
+
+	memset(validity, 0xFF, size);
+	for (size_t i = 0; i < column->n_null_values; ++i)
+	{
+		const size_t index = column->null_value_indices[i];
+		validity[index >> 3] &= (uint8_t)~(1u << (index & 7));
+	}
+
+	const bool is_written = __write_table_file(file, validity, size, position);
+	dt_free(allocator, validity);
+	return is_written ? DT_SUCCESS : DT_FAILURE;
+}
+
+// write the buffers of every column of [table] after the space left for the header
+// and the column descriptors, then the header and the descriptors
+static enum status_code_e
+__write_table_file_contents(
+	const struct DataTable* const table,
+	FILE* const file,
+	struct __table_file_column* const descriptors)
+{
+	const size_t header_size = sizeof(struct __table_file_header) + table->n_columns * sizeof(struct __table_file_column);
+	if (fseek(file, (long)header_size, SEEK_SET) != 0)
+		return DT_FAILURE;
+
+	uint64_t position = header_size;
+	for (size_t i = 0; i < table->n_columns; ++i)
+	{
+		const struct DataColumn* const column = table->columns[i].column;
+		struct __table_file_column* const descriptor = &descriptors[i];
+		strncpy(descriptor->name, table->columns[i].name, DT_MAX_COL_LEN);
+		descriptor->type = column->type;
+		descriptor->time_unit = column->time_unit;
+		descriptor->n_null_values = column->n_null_values;
+
+		if (!__pad_table_file(file, &position))
+			return DT_FAILURE;
+		descriptor->values_offset = position;
+
+		enum status_code_e status = column->type == STRING
+			? __write_table_file_strings(file, column, descriptor, &position)
+			: __write_table_file_values(file, column, &position);
+		if (status != DT_SUCCESS)
+			return status;
+
+		descriptor->values_size = column->type == STRING
+			? (column->n_values + 1) * sizeof(uint64_t)
+			: (uint64_t)(column->type == BOOL ? (column->n_values + 63) / 64 * sizeof(uint64_t) : column->n_values * column->type_size);
+
+		if (column->n_null_values > 0)
+		{
+			if (!__pad_table_file(file, &position))
+				return DT_FAILURE;
+			descriptor->validity_offset = position;
+
+			status = __write_table_file_validity(file, column, table->allocator, &position);
+			if (status != DT_SUCCESS)
+				return status;
+		}
+	}
+
+	struct __table_file_header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, DT_TABLE_FILE_MAGIC, sizeof(header.magic));
+	header.version = DT_TABLE_FILE_VERSION;
+	header.byte_order = DT_TABLE_FILE_BYTE_ORDER;
+	header.n_rows = table->n_rows;
+	header.n_columns = table->n_columns;
+	header.file_size = position;
+
+	// the header goes last so an incomplete file can't be loaded
+	if (fseek(file, (long)sizeof(header), SEEK_SET) != 0
+			|| fwrite(descriptors, sizeof(*descriptors), table->n_columns, file) < table->n_columns
+			|| fflush(file) != 0
+			|| fseek(file, 0, SEEK_SET) != 0
+			|| fwrite(&header, sizeof(header), 1, file) < 1)
+		return DT_FAILURE;
+
+	return DT_SUCCESS;
+}
+
+// whether the [size] bytes at [offset] are an aligned buffer within a file of [file_size] bytes
+static bool
+__is_table_file_buffer(
+	const uint64_t offset,
+	const uint64_t size,
+	const uint64_t file_size)
+{
+	return offset % DT_BUFFER_ALIGNMENT == 0 && offset <= file_size && size <= file_size - offset;
+}
+
+// check the descriptor of a column of [n_rows] values against the file of [file_size] bytes at
+// [data]: the buffers must fit in the file and, for STRING columns, every value must be within
+// the bytes buffer and end with a null terminator
+static bool
+__is_table_file_column(
+	const char* const data,
+	const uint64_t file_size,
+	const uint64_t n_rows,
+	const struct __table_file_column* const descriptor)
+{
+	if (descriptor->type > TIMESTAMP || descriptor->time_unit > DT_TIME_UNIT_NANOSECONDS
+			|| !memchr(descriptor->name, '\0', DT_MAX_COL_LEN)
+			|| descriptor->n_null_values > n_rows)
+		return false;
+
+	const enum data_type_e type = descriptor->type;
+	const uint64_t values_size = type == STRING ? (n_rows + 1) * sizeof(uint64_t)
+		: type == BOOL ? (n_rows + 63) / 64 * sizeof(uint64_t)
+		: n_rows * dt_type_to_size(type);
+	if (descriptor->values_size != values_size
+			|| !__is_table_file_buffer(descriptor->values_offset, values_size, file_size))
+		return false;
+
+	if (descriptor->n_null_values > 0 && !__is_table_file_buffer(descriptor->validity_offset, (n_rows + 7) / 8, file_size))
+		return false;
+
+	if (type != STRING)
+		return true;
+
+	if (!__is_table_file_buffer(descriptor->bytes_offset, descriptor->bytes_size, file_size))
+		return false;
+
+	const uint64_t* const offsets = (const uint64_t*)(data + descriptor->values_offset);
+	const char* const bytes = data + descriptor->bytes_offset;
+	if (offsets[0] != 0 || offsets[n_rows] != descriptor->bytes_size)
+		return false;
+
+	for (size_t i = 0; i < n_rows; ++i)
+	{
+		if (offsets[i + 1] < offsets[i] || offsets[i + 1] > descriptor->bytes_size
+				|| (offsets[i + 1] > offsets[i] && bytes[offsets[i + 1] - 1] != '\0'))
+			return false;
+	}
+
+	return true;
+}
+
+// create the column described by [descriptor] over the buffers of the mapped file of [table]
+// (a char* array pointing into the file is added to it for STRING columns)
+static struct DataColumn*
+__wrap_table_file_column(
+	struct DataTable* const table,
+	const struct __table_file_column* const descriptor)
+{
+	struct dt_mapped_table* const mapped = table->mapped;
+	const char* const data = mapped->source.data;
+	const size_t n_rows = table->n_rows;
+
+	const void* values = data + descriptor->values_offset;
+	if (descriptor->type == STRING)
+	{
+		char** strings = dt_alloc(table->allocator, (n_rows > 0 ? n_rows : 1) * sizeof(char*));
+		if (!strings)
+			return NULL;
+		mapped->strings[mapped->n_strings++] = strings;
+
+		const uint64_t* const offsets = values;
+		const char* const bytes = data + descriptor->bytes_offset;
+		for (size_t i = 0; i < n_rows; ++i)
+			strings[i] = offsets[i + 1] > offsets[i] ? (char*)bytes + offsets[i] : NULL;
+		values = strings;
+	}
+
+	const uint8_t* const validity = descriptor->n_null_values > 0
+		? (const uint8_t*)data + descriptor->validity_offset
+		: NULL;
+	struct DataColumn* column = dt_column_wrap(descriptor->type, values, validity, 0, n_rows, table->allocator);
+	if (!column)
+		return NULL;
+
+	column->time_unit = descriptor->time_unit;
+	if (column->n_null_values != descriptor->n_null_values)
+		dt_column_free(&column);
+
+	return column;
+}
+
+// release the Arrow array of a table created with dt_table_import_arrow
+static void
+__release_imported_arrow(
+	struct DataTable* const table)
+{
+	if (!table->arrow)
+		return;
+
+	if (table->arrow->release)
+		table->arrow->release(table->arrow);
+	dt_free(table->allocator, table->arrow);
+	table->arrow = NULL;
 }
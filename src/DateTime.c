@@ -0,0 +1,337 @@
+#include "DateTime.h"
+#include <stdio.h>
+
+#define SECONDS_PER_DAY 86400
+
+/*
+ * conversions between the proleptic gregorian calendar and days since 1970-01-01
+ * without any tables or libc time functions (which depend on the local time zone).
+ * the calendar is split into 400-year "eras" starting on March 1st so that the leap
+ * day is the last day of the (shifted) year.
+ */
+static int64_t
+__days_from_civil(
+	int64_t year,
+	const int64_t month,
+	const int64_t day)
+{
+	year -= month <= 2;
+	const int64_t era = (year >= 0 ? year : year - 399) / 400;
+	const int64_t year_of_era = year - era * 400;
+	const int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+	const int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+	return era * 146097 + day_of_era - 719468;
+}
+
+static void
+__civil_from_days(
+	int64_t days,
+	int64_t* const year,
+	int64_t* const month,
+	int64_t* const day)
+{
+	days += 719468;
+	const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+	const int64_t day_of_era = days - era * 146097;
+	const int64_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+	const int64_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+	const int64_t shifted_month = (5 * day_of_year + 2) / 153;
+
+	*day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+	*month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+	*year = year_of_era + era * 400 + (*month <= 2);
+}
+
+static bool
+__is_leap_year(
+	const int64_t year)
+{
+	return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static int64_t
+__days_in_month(
+	const int64_t year,
+	const int64_t month)
+{
+	static const int64_t days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	return month == 2 && __is_leap_year(year) ? 29 : days[month - 1];
+}
+
+// read exactly [n_digits] digits starting at [str]
+static bool
+__read_digits(
+	const char* const str,
+	const size_t n_digits,
+	int64_t* const value)
+{
+	int64_t result = 0;
+	for (size_t i = 0; i < n_digits; ++i)
+	{
+		const unsigned digit = (unsigned)(str[i] - '0');
+		if (digit > 9)
+			return false;
+		result = result * 10 + digit;
+	}
+
+	*value = result;
+	return true;
+}
+
+// parse "YYYY-MM-DD" at the start of [str] into days since the epoch
+static bool
+__parse_date_prefix(
+	const char* const str,
+	int64_t* const days)
+{
+	int64_t year = 0;
+	int64_t month = 0;
+	int64_t day = 0;
+
+	if (!__read_digits(str, 4, &year) || str[4] != '-'
+			|| !__read_digits(str + 5, 2, &month) || str[7] != '-'
+			|| !__read_digits(str + 8, 2, &day))
+		return false;
+
+	if (month < 1 || month > 12 || day < 1 || day > __days_in_month(year, month))
+		return false;
+
+	*days = __days_from_civil(year, month, day);
+	return true;
+}
+
+int64_t
+dt_time_unit_per_second(
+	const enum dt_time_unit_e unit)
+{
+	switch (unit)
+	{
+		case DT_TIME_UNIT_SECONDS:
+			return 1;
+		case DT_TIME_UNIT_MILLISECONDS:
+			return 1000;
+		case DT_TIME_UNIT_MICROSECONDS:
+			return 1000000;
+		case DT_TIME_UNIT_NANOSECONDS:
+			return 1000000000;
+	}
+
+	return 1;
+}
+
+bool
+dt_parse_date(
+	const char* const str,
+	int32_t* const days)
+{
+	if (!str)
+		return false;
+
+	int64_t result = 0;
+	if (!__parse_date_prefix(str, &result) || str[10] != '\0')
+		return false;
+
+	*days = (int32_t)result;
+	return true;
+}
+
+bool
+dt_parse_timestamp(
+	const char* const str,
+	const enum dt_time_unit_e unit,
+	int64_t* const value)
+{
+	if (!str)
+		return false;
+
+	int64_t days = 0;
+	if (!__parse_date_prefix(str, &days))
+		return false;
+
+	const char* current = str + 10;
+	int64_t seconds = 0;
+	int64_t fraction = 0;
+	const int64_t per_second = dt_time_unit_per_second(unit);
+
+	if (*current == 'T' || *current == 't' || *current == ' ')
+	{
+		int64_t hours = 0;
+		int64_t minutes = 0;
+		if (!__read_digits(current + 1, 2, &hours) || current[3] != ':'
+				|| !__read_digits(current + 4, 2, &minutes)
+				|| hours > 23 || minutes > 59)
+			return false;
+		seconds = hours * 3600 + minutes * 60;
+		current += 6;
+
+		if (*current == ':')
+		{
+			int64_t secs = 0;
+			if (!__read_digits(current + 1, 2, &secs) || secs > 59)
+				return false;
+			seconds += secs;
+			current += 3;
+
+			if (*current == '.' || *current == ',')
+			{
+				// keep as many digits as the unit can hold, skip the rest
+				++current;
+				int64_t scale = per_second;
+				if ((unsigned)(*current - '0') > 9)
+					return false;
+				while ((unsigned)(*current - '0') <= 9)
+				{
+					if (scale > 1)
+					{
+						scale /= 10;
+						fraction += (*current - '0') * scale;
+					}
+					++current;
+				}
+			}
+		}
+
+		// time zone designator
+		if (*current == 'Z' || *current == 'z')
+			++current;
+		else if (*current == '+' || *current == '-')
+		{
+			const int64_t sign = *current == '+' ? 1 : -1;
+			int64_t offset_hours = 0;
+			int64_t offset_minutes = 0;
+			if (!__read_digits(current + 1, 2, &offset_hours))
+				return false;
+			current += 3;
+
+			if (*current == ':')
+				++current;
+			if ((unsigned)(*current - '0') <= 9)
+			{
+				if (!__read_digits(current, 2, &offset_minutes))
+					return false;
+				current += 2;
+			}
+
+			if (offset_hours > 23 || offset_minutes > 59)
+				return false;
+
+			// local time = UTC + offset
+			seconds -= sign * (offset_hours * 3600 + offset_minutes * 60);
+		}
+	}
+
+	if (*current != '\0')
+		return false;
+
+	// e.g. nanoseconds only reach 1677-09-21 to 2262-04-11
+	const int64_t total_seconds = days * SECONDS_PER_DAY + seconds;
+	if (total_seconds >= 0)
+	{
+		if (total_seconds > INT64_MAX / per_second || fraction > INT64_MAX - total_seconds * per_second)
+			return false;
+
+		*value = total_seconds * per_second + fraction;
+		return true;
+	}
+
+	// before the epoch the fraction (0 <= fraction < per_second) moves towards it: add it to
+	// the second after, minus a second, so the scaling can't overflow before the check
+	if (total_seconds + 1 < INT64_MIN / per_second)
+		return false;
+
+	const int64_t next_second = (total_seconds + 1) * per_second;
+	if (fraction - per_second < INT64_MIN - next_second)
+		return false;
+
+	*value = next_second + (fraction - per_second);
+	return true;
+}
+
+// write [value] (0 - 99) as two digits
+static char*
+__write_two_digits(
+	char* buffer,
+	const int64_t value)
+{
+	buffer[0] = (char)('0' + value / 10);
+	buffer[1] = (char)('0' + value % 10);
+	return buffer + 2;
+}
+
+static char*
+__write_date(
+	char* buffer,
+	const int64_t days)
+{
+	int64_t year = 0;
+	int64_t month = 0;
+	int64_t day = 0;
+	__civil_from_days(days, &year, &month, &day);
+
+	if (year >= 0 && year <= 9999)
+	{
+		buffer = __write_two_digits(buffer, year / 100);
+		buffer = __write_two_digits(buffer, year % 100);
+	}
+	else
+		// can't be parsed back, but at least show something meaningful
+		buffer += sprintf(buffer, "%lld", (long long)year);
+
+	*buffer++ = '-';
+	buffer = __write_two_digits(buffer, month);
+	*buffer++ = '-';
+	return __write_two_digits(buffer, day);
+}
+
+size_t
+dt_format_date(
+	const int32_t days,
+	char* const buffer)
+{
+	char* end = __write_date(buffer, days);
+	*end = '\0';
+	return (size_t)(end - buffer);
+}
+
+size_t
+dt_format_timestamp(
+	const int64_t value,
+	const enum dt_time_unit_e unit,
+	char* const buffer)
+{
+	const int64_t per_second = dt_time_unit_per_second(unit);
+	const int64_t per_day = per_second * SECONDS_PER_DAY;
+
+	// floor division so times before the epoch still count up from midnight
+	int64_t days = value / per_day;
+	int64_t remainder = value % per_day;
+	if (remainder < 0)
+	{
+		remainder += per_day;
+		days--;
+	}
+
+	const int64_t seconds = remainder / per_second;
+	int64_t fraction = remainder % per_second;
+
+	char* end = __write_date(buffer, days);
+	*end++ = 'T';
+	end = __write_two_digits(end, seconds / 3600);
+	*end++ = ':';
+	end = __write_two_digits(end, (seconds / 60) % 60);
+	*end++ = ':';
+	end = __write_two_digits(end, seconds % 60);
+
+	if (per_second > 1)
+	{
+		*end++ = '.';
+		for (int64_t scale = per_second / 10; scale > 0; scale /= 10)
+		{
+			*end++ = (char)('0' + fraction / scale);
+			fraction %= scale;
+		}
+	}
+
+	*end = '\0';
+	return (size_t)(end - buffer);
+}
@@ -59,6 +59,15 @@ hash_function(
 				generic_add(&hash_value, &_value, int64_t);
 			}	
 			break;
+			case BOOL:
+				generic_add(&hash_value, value, bool);
+				break;
+			case DATE:
+				generic_add(&hash_value, value, int32_t);
+				break;
+			case TIMESTAMP:
+				generic_add(&hash_value, value, int64_t);
+				break;
 			case STRING:
 			{
 				char* value_str = *(char**)value;
@@ -91,7 +100,11 @@ hash_insert(
 	bin->value[bin->n_values++] = row_idx;
 	if (bin->n_values == bin->capacity)
 	{
-		void* alloc = realloc(bin->value, (bin->capacity + 1) * sizeof(size_t));
+		void* alloc = dt_realloc(
+			htable->allocator,
+			bin->value,
+			bin->capacity * sizeof(size_t),
+			(bin->capacity + 1) * sizeof(size_t));
 		if (!alloc)
 			return DT_ALLOC_ERROR;
 		bin->value = alloc;
@@ -109,9 +122,13 @@ hash_create(
   size_t* column_indices,
   size_t n_column_indices)
 {
-	struct HashTable* htable = malloc(sizeof(*htable));
+	// everything (including bins) is allocated with the table's allocator
+	const struct dt_allocator* const allocator = table->allocator;
+
+	struct HashTable* htable = dt_alloc(allocator, sizeof(*htable));
 	if (!htable)
 		return NULL;
+	htable->allocator = allocator;
 
   // if user passes NULL, it defaults to use all columns
   // otherwise we copy the contents of [column_indices]
@@ -121,10 +138,10 @@ hash_create(
 
   if (!column_indices)
   {
-    htable->column_indices = calloc(n_indices, sizeof(size_t));
+    htable->column_indices = dt_calloc(allocator, n_indices, sizeof(size_t));
     if (!htable->column_indices)
     {
-      free(htable);
+      dt_free(allocator, htable);
       return NULL;
     }
     for (size_t i = 0; i < n_indices; ++i)
@@ -135,19 +152,20 @@ hash_create(
 	// only used as a reference when adding items to bins etc.
 	htable->table = table;
 
-	htable->bin = calloc(table->n_rows, sizeof(*htable->bin));
+	htable->bin = dt_calloc(allocator, table->n_rows, sizeof(*htable->bin));
 	htable->n_bins = table->n_rows;
 
 	if (!htable->bin)
 	{
-		free(htable);
+		dt_free(allocator, htable->column_indices);
+		dt_free(allocator, htable);
 		return NULL;
 	}
 
 	// by default, assign one slot per bin (will reallocate if necessary on collision) 
 	for (size_t i = 0; i < table->n_rows; ++i)
 	{
-		htable->bin[i].value = calloc(1, sizeof(size_t));
+		htable->bin[i].value = dt_calloc(allocator, 1, sizeof(size_t));
 		htable->bin[i].n_values = 0;
 		htable->bin[i].capacity = 1;
 
@@ -155,10 +173,10 @@ hash_create(
 		if (!htable->bin[i].value)
 		{
 			for (size_t k = 0; k < i; ++k)
-				free(htable->bin[i].value);
-			free(htable->bin);
-      free(htable->column_indices);
-			free(htable);
+				dt_free(allocator, htable->bin[k].value);
+			dt_free(allocator, htable->bin);
+      dt_free(allocator, htable->column_indices);
+			dt_free(allocator, htable);
 			return NULL;
 		}
 	}
@@ -221,18 +239,20 @@ void
 hash_free(
 	struct HashTable** htable)
 {
+	const struct dt_allocator* const allocator = (*htable)->allocator;
+
 	for (size_t i = 0; i < (*htable)->n_bins; ++i)
 	{
-		free((*htable)->bin[i].value);
+		dt_free(allocator, (*htable)->bin[i].value);
 		(*htable)->bin[i].value = NULL;
 	}	
 
-	free((*htable)->bin);
+	dt_free(allocator, (*htable)->bin);
 	(*htable)->bin = NULL;
 
-  free((*htable)->column_indices);
+  dt_free(allocator, (*htable)->column_indices);
   (*htable)->column_indices = NULL;
 
-	free(*htable);
+	dt_free(allocator, *htable);
 	*htable = NULL;
 }	
@@ -0,0 +1,151 @@
+#include "DataColumn.h"
+#include <stdio.h>
+
+static bool
+is_aligned(
+	const void* const ptr)
+{
+	return ((uintptr_t)ptr % DT_BUFFER_ALIGNMENT) == 0;
+}
+
+static bool
+filter_even(
+	void* item,
+	void* user_data)
+{
+	(void)user_data;
+	return *(int8_t*)item % 2 == 0;
+}
+
+// plain malloc allocator without allocate_aligned (forces the over-allocation path)
+static void*
+plain_allocate(
+	void* context,
+	size_t size)
+{
+	(void)context;
+	return malloc(size);
+}
+
+static void*
+plain_reallocate(
+	void* context,
+	void* ptr,
+	size_t old_size,
+	size_t new_size)
+{
+	(void)context;
+	(void)old_size;
+	return realloc(ptr, new_size);
+}
+
+static void
+plain_deallocate(
+	void* context,
+	void* ptr)
+{
+	(void)context;
+	free(ptr);
+}
+
+static int
+check_column(
+	const struct dt_allocator* const allocator)
+{
+	int status = -1;
+	struct DataColumn* column = NULL;
+	size_t* filtered_idx = NULL;
+	if (dt_column_create_with_allocator(&column, 3, INT8, allocator) != DT_SUCCESS)
+		return -1;
+
+	if (!is_aligned(column->value))
+	{
+		fprintf(stderr, "Expected value buffer to be aligned after create.\n");
+		goto cleanup;
+	}
+
+	// grow the buffer a few times; alignment must survive reallocation
+	for (int8_t i = 0; i < 100; ++i)
+		dt_column_append_value(column, &i);
+
+	if (!is_aligned(column->value))
+	{
+		fprintf(stderr, "Expected value buffer to be aligned after growing.\n");
+		goto cleanup;
+	}
+
+	// padding up to the next multiple of the alignment is zeroed
+	const size_t padded = dt_padded_size(column->value_capacity * column->type_size);
+	for (size_t i = column->n_values; i < padded; ++i)
+	{
+		if (((int8_t*)column->value)[i] != 0)
+		{
+			fprintf(stderr, "Expected padding byte %zu to be zero.\n", i);
+			goto cleanup;
+		}
+	}
+
+	for (size_t i = 0; i < 20; ++i)
+		dt_column_set_value(column, i, NULL);
+
+	if (!is_aligned(column->null_value_indices))
+	{
+		fprintf(stderr, "Expected null value buffer to be aligned.\n");
+		goto cleanup;
+	}
+
+	filtered_idx = dt_column_filter(column, &filter_even, NULL);
+	if (!filtered_idx || !is_aligned(filtered_idx))
+	{
+		fprintf(stderr, "Expected selection buffer to be aligned.\n");
+		goto cleanup;
+	}
+
+	int8_t value = 0;
+	dt_column_get_value(column, 102, &value);
+	if (value != 99)
+	{
+		fprintf(stderr, "Expected value 99 but got %d.\n", value);
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	dt_aligned_free(allocator, filtered_idx);
+	dt_column_free(&column);
+	return status;
+}
+
+int main()
+{
+	int status = -1;
+	struct dt_arena* arena = NULL;
+
+	if (dt_padded_size(0) != 64 || dt_padded_size(1) != 64
+			|| dt_padded_size(64) != 64 || dt_padded_size(65) != 128)
+	{
+		fprintf(stderr, "Unexpected padded sizes.\n");
+		goto cleanup;
+	}
+
+	if (check_column(dt_get_default_allocator()) != 0)
+		goto cleanup;
+
+	struct dt_allocator plain = {
+		.allocate = &plain_allocate,
+		.reallocate = &plain_reallocate,
+		.deallocate = &plain_deallocate,
+		.context = NULL
+	};
+	if (check_column(&plain) != 0)
+		goto cleanup;
+
+	arena = dt_arena_create(1024);
+	if (!arena || check_column(dt_arena_allocator(arena)) != 0)
+		goto cleanup;
+
+	status = 0;
+cleanup:
+	dt_arena_free(&arena);
+	return status;
+}
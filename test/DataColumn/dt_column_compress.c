@@ -0,0 +1,182 @@
+#include "CompressedColumn.h"
+#include <stdio.h>
+
+static int64_t
+as_int64(
+	const struct DataColumn* const column,
+	const size_t index)
+{
+	const void* value = dt_column_get_value_ptr(column, index);
+	switch (column->type)
+	{
+		case UINT16:
+			return *(const uint16_t*)value;
+		case INT32:
+			return *(const int32_t*)value;
+		default:
+			return *(const int64_t*)value;
+	}
+}
+
+// compare every compressed operation against the uncompressed column
+static int
+check_encoding(
+	const struct DataColumn* const column,
+	const enum dt_encoding_e encoding)
+{
+	int status = -1;
+	struct CompressedColumn* compressed = dt_column_compress(column, encoding);
+	struct DataColumn* decompressed = NULL;
+	size_t* filtered = NULL;
+	void* buffer = calloc(column->n_values + 1, column->type_size);
+	if (!compressed || !buffer)
+	{
+		fprintf(stderr, "Failed to compress column with encoding %d.\n", encoding);
+		goto cleanup;
+	}
+
+	dt_compressed_column_decode(compressed, buffer);
+	for (size_t i = 0; i < column->n_values; ++i)
+	{
+		if (memcmp((char*)buffer + i * column->type_size, dt_column_get_value_ptr(column, i), column->type_size) != 0)
+		{
+			fprintf(stderr, "Encoding %d: decoded value %zu differs.\n", encoding, i);
+			goto cleanup;
+		}
+	}
+
+	int64_t sum = 0, expected_sum = 0;
+	dt_compressed_column_sum(compressed, &sum);
+	dt_column_sum(column, &expected_sum);
+	int64_t min = 0, expected_min = 0, max = 0, expected_max = 0;
+	dt_compressed_column_min(compressed, &min);
+	dt_column_min(column, &expected_min);
+	dt_compressed_column_max(compressed, &max);
+	dt_column_max(column, &expected_max);
+	if (memcmp(&sum, &expected_sum, column->type_size) != 0
+			|| memcmp(&min, &expected_min, column->type_size) != 0
+			|| memcmp(&max, &expected_max, column->type_size) != 0)
+	{
+		fprintf(stderr, "Encoding %d: aggregates differ.\n", encoding);
+		goto cleanup;
+	}
+
+	// range filter between the values at index 10 and 20 (whichever is smaller first)
+	const size_t lower_idx = as_int64(column, 10) <= as_int64(column, 20) ? 10 : 20;
+	const size_t upper_idx = lower_idx == 10 ? 20 : 10;
+	const void* lower = dt_column_get_value_ptr(column, lower_idx);
+	const void* upper = dt_column_get_value_ptr(column, upper_idx);
+	const struct CompressedColumn* const c = compressed;
+	filtered = dt_compressed_column_filter_range(c, lower, upper);
+	size_t* lower_mask = dt_compressed_column_filter_range(c, lower, lower);
+	size_t* equal_mask = dt_compressed_column_filter_equal(c, lower);
+	bool equal_ok = lower_mask && equal_mask;
+	for (size_t i = 0; equal_ok && i < column->n_values; ++i)
+		equal_ok = lower_mask[i] == equal_mask[i]
+			&& equal_mask[i] == (memcmp(dt_column_get_value_ptr(column, i), lower, column->type_size) == 0);
+	dt_aligned_free(c->allocator, lower_mask);
+	dt_aligned_free(c->allocator, equal_mask);
+	if (!filtered || !equal_ok)
+	{
+		fprintf(stderr, "Encoding %d: equality filter differs.\n", encoding);
+		goto cleanup;
+	}
+
+	// naive range check through a decompressed copy
+	decompressed = dt_compressed_column_decompress(compressed);
+	if (!decompressed || decompressed->n_values != column->n_values
+			|| decompressed->n_null_values != column->n_null_values)
+	{
+		fprintf(stderr, "Encoding %d: failed to decompress.\n", encoding);
+		goto cleanup;
+	}
+
+	for (size_t i = 0; i < column->n_values; ++i)
+	{
+		const int64_t value = as_int64(decompressed, i);
+		const size_t in_range = value >= as_int64(column, lower_idx) && value <= as_int64(column, upper_idx);
+		if (filtered[i] != in_range)
+		{
+			fprintf(stderr, "Encoding %d: range filter differs at %zu.\n", encoding, i);
+			goto cleanup;
+		}
+	}
+
+	status = 0;
+cleanup:
+	free(buffer);
+	if (compressed)
+		dt_aligned_free(compressed->allocator, filtered);
+	dt_column_free(&decompressed);
+	dt_compressed_column_free(&compressed);
+	return status;
+}
+
+int main()
+{
+	int status = -1;
+	struct DataColumn* ids = NULL;
+	struct DataColumn* counters = NULL;
+	struct DataColumn* noise = NULL;
+	struct DataColumn* doubles = NULL;
+	struct CompressedColumn* compressed = NULL;
+
+	dt_column_create(&ids, 0, INT64);
+	dt_column_create(&counters, 0, UINT16);
+	dt_column_create(&noise, 0, INT32);
+	dt_column_create(&doubles, 1, DOUBLE);
+
+	uint32_t state = 12345;
+	for (int64_t i = 0; i < 3000; ++i)
+	{
+		int64_t id = 1000000 + i;
+		uint16_t counter = (uint16_t)(i / 100);
+		state = state * 1103515245u + 12345u;
+		int32_t random = (int32_t)(state >> 8) - (1 << 23);
+
+		dt_column_append_value(ids, i == 1500 ? NULL : &id);
+		dt_column_append_value(counters, &counter);
+		dt_column_append_value(noise, &random);
+	}
+
+	for (size_t e = 0; e < DT_N_ENCODINGS; ++e)
+		if (check_encoding(ids, e) != 0
+				|| check_encoding(counters, e) != 0
+				|| check_encoding(noise, e) != 0)
+			goto cleanup;
+
+	// sorted ids pack into a couple of bits each with delta encoding
+	struct CompressionReport reports[DT_N_ENCODINGS];
+	if (dt_column_compression_report(ids, reports) != DT_SUCCESS
+			|| reports[DT_ENCODING_DELTA].ratio < 8.0
+			|| reports[DT_ENCODING_FOR].ratio < 4.0)
+	{
+		fprintf(stderr, "Expected sorted ids to compress at least 4x.\n");
+		goto cleanup;
+	}
+
+	// low-range repeated counters compress best with RLE
+	if (dt_column_compression_report(counters, reports) != DT_SUCCESS
+			|| reports[DT_ENCODING_RLE].ratio < 8.0)
+	{
+		fprintf(stderr, "Expected counters to compress at least 8x with RLE.\n");
+		goto cleanup;
+	}
+
+	// only integer columns can be compressed
+	compressed = dt_column_compress(doubles, DT_ENCODING_FOR);
+	if (compressed || dt_column_compression_report(doubles, reports) != DT_TYPE_MISMATCH)
+	{
+		fprintf(stderr, "Expected non-integer columns to be rejected.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	dt_compressed_column_free(&compressed);
+	dt_column_free(&ids);
+	dt_column_free(&counters);
+	dt_column_free(&noise);
+	dt_column_free(&doubles);
+	return status;
+}
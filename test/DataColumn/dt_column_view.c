@@ -0,0 +1,57 @@
+#include "DataColumn.h"
+#include <stdio.h>
+
+int main()
+{
+	int status = -1;
+
+	struct DataColumn* column = NULL;
+	struct DataColumn* view = NULL;
+	dt_column_create(&column, 0, UINT16);
+
+	for (uint16_t i = 0; i < 8; ++i)
+		dt_column_append_value(column, &i);
+
+	view = dt_column_view(column, 2, 5);
+	if (!view || view->n_values != 5 || !view->is_view)
+	{
+		fprintf(stderr, "Expected a view with 5 values.\n");
+		goto cleanup;
+	}
+
+	uint16_t max = 0;
+	dt_column_max(view, &max);
+	if (max != 6)
+	{
+		fprintf(stderr, "Expected max of view to be 6 but got %u.\n", max);
+		goto cleanup;
+	}
+
+	// appending to a view copies it first (copy-on-write)
+	uint16_t value = 42;
+	dt_column_append_value(view, &value);
+	if (view->is_view || view->n_values != 6)
+	{
+		fprintf(stderr, "Expected view to be materialized after append.\n");
+		goto cleanup;
+	}
+
+	if (column->n_values != 8 || *(uint16_t*)dt_column_get_value_ptr(column, 7) != 7)
+	{
+		fprintf(stderr, "Expected parent column to be unchanged.\n");
+		goto cleanup;
+	}
+
+	if (dt_column_view(column, 4, 5) != NULL)
+	{
+		fprintf(stderr, "Expected out of bounds view to be NULL.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (view)
+		dt_column_free(&view);
+	dt_column_free(&column);
+	return status;
+}
@@ -0,0 +1,158 @@
+#include "DataTable.h"
+#include "CsvReader.h"
+#include "dt_test_helpers.h"
+#include <stdio.h>
+
+#define N_ROWS 200000
+
+// the first bytes of the file at [filepath] must tell its compression
+static bool
+has_magic(
+	const char* filepath,
+	const enum dt_csv_compression_e compression)
+{
+	unsigned char head[4] = {0};
+	FILE* file = fopen(filepath, "rb");
+	const size_t n_read = file ? fread(head, 1, sizeof(head), file) : 0;
+	if (file)
+		fclose(file);
+
+	return dt_csv_compression_from_data(head, n_read) == compression;
+}
+
+// write [table] to [filepath], read it back whole and with a streaming reader
+static bool
+round_trip(
+	const struct DataTable* table,
+	const char* filepath,
+	const enum dt_csv_compression_e compression)
+{
+	bool same = false;
+	struct DataTable* read = NULL;
+	struct dt_csv_reader* reader = NULL;
+	struct DataTable* batch = NULL;
+
+	if (!dt_table_to_csv(table, filepath, ',') || !has_magic(filepath, compression))
+		goto cleanup;
+
+	read = dt_table_read_csv(filepath, ',', NULL);
+	if (!read || !tables_identical(table, read))
+		goto cleanup;
+
+	struct dt_csv_options options;
+	dt_csv_options_init(&options);
+	reader = dt_csv_reader_open(filepath, &options);
+	if (!reader)
+		goto cleanup;
+
+	size_t n_read = 0;
+	while ((batch = dt_csv_reader_next(reader, 7000)))
+	{
+		for (size_t i = 0; i < batch->n_rows; ++i, ++n_read)
+		{
+			if (*(uint64_t*)dt_table_get_value(batch, i, 0) != *(uint64_t*)dt_table_get_value(table, n_read, 0))
+				goto cleanup;
+		}
+		dt_table_free(&batch);
+	}
+	same = dt_csv_reader_status(reader) == DT_SUCCESS && n_read == table->n_rows;
+
+cleanup:
+	if (read)
+		dt_table_free(&read);
+	if (batch)
+		dt_table_free(&batch);
+	if (reader)
+		dt_csv_reader_close(&reader);
+	remove(filepath);
+	return same;
+}
+
+int main()
+{
+	int status = -1;
+	struct DataTable* table = NULL;
+	struct DataTable* read = NULL;
+
+	if (dt_csv_compression_from_path("table.csv.gz") != DT_CSV_COMPRESSION_GZIP
+			|| dt_csv_compression_from_path("table.csv.zst") != DT_CSV_COMPRESSION_ZSTD
+			|| dt_csv_compression_from_path("table.csv") != DT_CSV_COMPRESSION_NONE)
+	{
+		fprintf(stderr, "Expected the compression to follow the extension.\n");
+		goto cleanup;
+	}
+
+	// large enough to take several blocks once decompressed
+	FILE* csv_file = fopen("compression_table.csv", "w");
+	fprintf(csv_file, "id,amount\n");
+	for (size_t i = 0; i < N_ROWS; ++i)
+		fprintf(csv_file, "%zu,%zu.5\n", i, i % 1000);
+	fclose(csv_file);
+
+	table = dt_table_read_csv("compression_table.csv", ',', NULL);
+	remove("compression_table.csv");
+	if (!table || table->n_rows != N_ROWS)
+	{
+		fprintf(stderr, "Expected %d rows.\n", N_ROWS);
+		goto cleanup;
+	}
+
+	if (!round_trip(table, "compression_table.csv", DT_CSV_COMPRESSION_NONE))
+	{
+		fprintf(stderr, "Expected an uncompressed round trip.\n");
+		goto cleanup;
+	}
+
+	if (dt_csv_compression_supported(DT_CSV_COMPRESSION_GZIP))
+	{
+		if (!round_trip(table, "compression_table.csv.gz", DT_CSV_COMPRESSION_GZIP))
+		{
+			fprintf(stderr, "Expected a gzip round trip.\n");
+			goto cleanup;
+		}
+
+		// truncated data is an error, not a shorter table
+		dt_table_to_csv(table, "compression_table.csv.gz", ',');
+		static char data[1 << 20];
+		FILE* file = fopen("compression_table.csv.gz", "rb");
+		const size_t size = fread(data, 1, sizeof(data), file);
+		fclose(file);
+		file = fopen("compression_table.csv.gz", "wb");
+		fwrite(data, 1, size / 2, file);
+		fclose(file);
+		read = dt_table_read_csv("compression_table.csv.gz", ',', NULL);
+		remove("compression_table.csv.gz");
+		if (read)
+		{
+			fprintf(stderr, "Expected a truncated gzip file to fail.\n");
+			goto cleanup;
+		}
+	}
+	else if (dt_table_to_csv(table, "compression_table.csv.gz", ','))
+	{
+		fprintf(stderr, "Expected gzip output to fail without zlib.\n");
+		goto cleanup;
+	}
+
+	if (dt_csv_compression_supported(DT_CSV_COMPRESSION_ZSTD))
+	{
+		if (!round_trip(table, "compression_table.csv.zst", DT_CSV_COMPRESSION_ZSTD))
+		{
+			fprintf(stderr, "Expected a zstd round trip.\n");
+			goto cleanup;
+		}
+	}
+	else if (dt_table_to_csv(table, "compression_table.csv.zst", ','))
+	{
+		fprintf(stderr, "Expected zstd output to fail without libzstd.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (table)
+		dt_table_free(&table);
+	if (read)
+		dt_table_free(&read);
+	return status;
+}
@@ -0,0 +1,163 @@
+#include "DataTable.h"
+#include <stdio.h>
+
+#define N_ROWS 25000
+#define BATCH_SIZE 1000
+
+// row [row1] of [table1] must be identical to row [row2] of [table2]
+static bool
+rows_identical(
+	const struct DataTable* table1,
+	const size_t row1,
+	const struct DataTable* table2,
+	const size_t row2)
+{
+	for (size_t col = 0; col < table1->n_columns; ++col)
+	{
+		const struct DataColumn* column = table1->columns[col].column;
+		const bool is_null = dt_table_check_isnull(table1, row1, col);
+		if (is_null != dt_table_check_isnull(table2, row2, col))
+			return false;
+		if (is_null)
+			continue;
+
+		const void* value1 = dt_table_get_value(table1, row1, col);
+		const void* value2 = dt_table_get_value(table2, row2, col);
+		if (column->type == STRING
+				? strcmp(*(char**)value1, *(char**)value2) != 0
+				: memcmp(value1, value2, column->type_size) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	int status = -1;
+
+	struct DataTable* whole = NULL;
+	struct DataTable* batch = NULL;
+	struct dt_csv_reader* reader = NULL;
+
+	// quoted fields spanning lines, nulls, blank lines and one field
+	// longer than the blocks the input is read in
+	FILE* csv_file = fopen("reader_table.csv", "w");
+	fprintf(csv_file, "id,amount,text,flag\r\n");
+	for (size_t i = 0; i < N_ROWS; ++i)
+	{
+		fprintf(csv_file, "%zu,", i);
+		if (i % 5 != 0)
+			fprintf(csv_file, "%.3f", (double)i / 8.0);
+		if (i == 12345)
+		{
+			fprintf(csv_file, ",\"");
+			for (size_t k = 0; k < 300000; ++k)
+				fprintf(csv_file, "long\n\"\"");
+			fprintf(csv_file, "\"");
+		}
+		else
+			fprintf(csv_file, ",\"row %zu,\nsecond line\"", i);
+		fprintf(csv_file, ",%s\r\n", i % 2 ? "true" : "false");
+		if (i % 1000 == 999)
+			fprintf(csv_file, "\r\n");
+	}
+	fclose(csv_file);
+
+	whole = dt_table_read_csv("reader_table.csv", ',', NULL);
+
+	struct dt_csv_options options;
+	dt_csv_options_init(&options);
+	reader = dt_csv_reader_open("reader_table.csv", &options);
+	if (!whole || !reader)
+	{
+		fprintf(stderr, "Failed to open CSV.\n");
+		goto cleanup;
+	}
+
+	// every batch has the schema of the whole table and holds the next rows
+	const struct DataTable* schema = dt_csv_reader_schema(reader);
+	size_t n_rows = 0;
+	size_t n_batches = 0;
+	while ((batch = dt_csv_reader_next(reader, BATCH_SIZE)))
+	{
+		for (size_t col = 0; col < whole->n_columns; ++col)
+		{
+			if (batch->columns[col].column->type != whole->columns[col].column->type
+					|| batch->columns[col].column->type != schema->columns[col].column->type
+					|| strcmp(batch->columns[col].name, whole->columns[col].name) != 0)
+			{
+				fprintf(stderr, "Expected column %zu of batch %zu to have the same type.\n", col, n_batches);
+				goto cleanup;
+			}
+		}
+
+		if (batch->n_rows > BATCH_SIZE || n_rows + batch->n_rows > whole->n_rows)
+		{
+			fprintf(stderr, "Unexpected batch of %zu rows.\n", batch->n_rows);
+			goto cleanup;
+		}
+
+		for (size_t row = 0; row < batch->n_rows; ++row)
+		{
+			if (!rows_identical(batch, row, whole, n_rows + row))
+			{
+				fprintf(stderr, "Row %zu differs from reading the whole file.\n", n_rows + row);
+				goto cleanup;
+			}
+		}
+
+		n_rows += batch->n_rows;
+		n_batches++;
+		dt_table_free(&batch);
+	}
+
+	if (dt_csv_reader_status(reader) != DT_SUCCESS || n_rows != N_ROWS || n_batches != N_ROWS / BATCH_SIZE)
+	{
+		fprintf(stderr, "Expected %d rows in %d batches but got %zu in %zu.\n",
+			N_ROWS, N_ROWS / BATCH_SIZE, n_rows, n_batches);
+		goto cleanup;
+	}
+	dt_csv_reader_close(&reader);
+
+	// reading from stdin, with types inferred from the first rows only
+	csv_file = fopen("reader_table.csv", "w");
+	fprintf(csv_file, "count,name\n1,a\n2,b\n-3,c\n");
+	fclose(csv_file);
+
+	if (!freopen("reader_table.csv", "rb", stdin))
+	{
+		fprintf(stderr, "Failed to redirect stdin.\n");
+		goto cleanup;
+	}
+
+	options.n_inference_rows = 2;
+	reader = dt_csv_reader_open(NULL, &options);
+	batch = reader ? dt_csv_reader_next(reader, 10) : NULL;
+	if (!batch || batch->n_rows != 3 || batch->columns[0].column->type != UINT64
+			|| *(uint64_t*)dt_table_get_value(batch, 1, 0) != 2
+			|| *(uint64_t*)dt_table_get_value(batch, 2, 0) != 0
+			|| strcmp(*(char**)dt_table_get_value(batch, 2, 1), "c") != 0)
+	{
+		fprintf(stderr, "Expected the stream to keep the types of its first rows.\n");
+		goto cleanup;
+	}
+	dt_table_free(&batch);
+
+	if (dt_csv_reader_next(reader, 10) || dt_csv_reader_status(reader) != DT_SUCCESS)
+	{
+		fprintf(stderr, "Expected the end of the stream.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (whole)
+		dt_table_free(&whole);
+	if (batch)
+		dt_table_free(&batch);
+	if (reader)
+		dt_csv_reader_close(&reader);
+	remove("reader_table.csv");
+	return status;
+}
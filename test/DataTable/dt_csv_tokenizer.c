@@ -0,0 +1,132 @@
+#include "CsvReader.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define N_ROUNDS 2000
+#define MAX_DATA_LEN 600
+
+// tokenize all of [data] with both tokenizers and compare every record and span
+static bool
+same_records(
+	const char* data,
+	const size_t size,
+	const char delim,
+	const enum dt_csv_simd_e simd)
+{
+	struct dt_csv_record scalar;
+	struct dt_csv_record vector;
+	dt_csv_record_init(&scalar, dt_get_default_allocator());
+	dt_csv_record_init(&vector, dt_get_default_allocator());
+	scalar.simd = DT_CSV_SIMD_NONE;
+	vector.simd = simd;
+
+	bool result = true;
+	size_t scalar_position = 0;
+	size_t vector_position = 0;
+	while (result && scalar_position < size)
+	{
+		dt_csv_tokenize_record(data, size, delim, &scalar_position, &scalar);
+		dt_csv_tokenize_record(data, size, delim, &vector_position, &vector);
+
+		result = scalar_position == vector_position && scalar.n_spans == vector.n_spans;
+		for (size_t i = 0; result && i < scalar.n_spans; ++i)
+			result = scalar.spans[i].offset == vector.spans[i].offset
+				&& scalar.spans[i].length == vector.spans[i].length
+				&& scalar.spans[i].is_quoted == vector.spans[i].is_quoted;
+	}
+
+	dt_csv_record_free(&scalar);
+	dt_csv_record_free(&vector);
+	return result;
+}
+
+int main()
+{
+	int status = -1;
+
+	// the scalar tokenizer on its own
+	const char* text = "a,\"b,\"\"c\"\"\nd\",e\r\nf,g\"h,i\"j";
+	struct dt_csv_record record;
+	dt_csv_record_init(&record, dt_get_default_allocator());
+	record.simd = DT_CSV_SIMD_NONE;
+
+	size_t position = 0;
+	char value[64];
+	dt_csv_tokenize_record(text, strlen(text), ',', &position, &record);
+	dt_csv_span_copy(text, &record.spans[1], value);
+	if (record.n_spans != 3 || strcmp(value, "b,\"c\"\nd") != 0)
+	{
+		fprintf(stderr, "Unexpected first record: %zu fields, %s\n", record.n_spans, value);
+		dt_csv_record_free(&record);
+		return -1;
+	}
+
+	dt_csv_tokenize_record(text, strlen(text), ',', &position, &record);
+	dt_csv_span_copy(text, &record.spans[1], value);
+	if (record.n_spans != 2 || strcmp(value, "g\"h,i\"j") != 0 || position != strlen(text))
+	{
+		fprintf(stderr, "Unexpected second record: %zu fields, %s\n", record.n_spans, value);
+		dt_csv_record_free(&record);
+		return -1;
+	}
+	dt_csv_record_free(&record);
+
+	// every instruction set up to the detected one gives exactly the same records
+	const enum dt_csv_simd_e detected = dt_csv_detect_simd();
+	const char alphabet[] = "ab,;\"\"'\n\r ";
+	const char* pieces[] = { "ab", "", " ", "\"\"", ",", "\n", "\r\n", "x;y" };
+	const size_t n_pieces = sizeof(pieces) / sizeof(pieces[0]);
+	char* data = malloc(MAX_DATA_LEN + 64);
+
+	srand(1234);
+	for (size_t round = 0; round < N_ROUNDS; ++round)
+	{
+		size_t size = 0;
+		if (round % 4 == 0)
+		{
+			// random characters (mostly handed to the scalar tokenizer)
+			size = (size_t)rand() % MAX_DATA_LEN;
+			for (size_t i = 0; i < size; ++i)
+				data[i] = alphabet[(size_t)rand() % (sizeof(alphabet) - 1)];
+		}
+		else
+		{
+			// well-formed fields, some quoted with delimiters, line breaks and escaped quotes inside
+			while (size < MAX_DATA_LEN)
+			{
+				const bool is_quoted = rand() % 3 == 0;
+				if (is_quoted)
+					data[size++] = '\"';
+				for (int k = rand() % 4; k > 0; --k)
+				{
+					const char* piece = pieces[(size_t)rand() % (is_quoted ? n_pieces : 3)];
+					memcpy(data + size, piece, strlen(piece));
+					size += strlen(piece);
+				}
+				if (is_quoted)
+					data[size++] = '\"';
+
+				const int separator = rand() % 8;
+				const char* end = separator < 5 ? (round % 2 ? "," : ";") : separator < 7 ? "\n" : "\r\n";
+				memcpy(data + size, end, strlen(end));
+				size += strlen(end);
+			}
+		}
+
+		for (int simd = DT_CSV_SIMD_SSE2; simd <= (int)detected; ++simd)
+		{
+			const char delim = round % 2 ? ',' : ';';
+			if (!same_records(data, size, delim, (enum dt_csv_simd_e)simd))
+			{
+				fprintf(stderr, "Tokenizers disagree in round %zu (instruction set %d).\n", round, simd);
+				goto cleanup;
+			}
+		}
+	}
+
+	status = 0;
+cleanup:
+	free(data);
+	return status;
+}
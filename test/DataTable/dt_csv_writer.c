@@ -0,0 +1,165 @@
+#include "DataTable.h"
+#include "CsvReader.h"
+#include "dt_test_helpers.h"
+#include <stdio.h>
+
+#define N_ROWS 50000
+#define BATCH_ROWS 7000
+
+// write [table] to [filepath] in batches of BATCH_ROWS rows with [options]
+static bool
+write_batches(
+	const struct DataTable* table,
+	const char* filepath,
+	const struct dt_csv_write_options* options)
+{
+	struct dt_csv_writer* writer = dt_csv_writer_open(filepath, table, options);
+	if (!writer)
+		return false;
+
+	bool written = true;
+	for (size_t start = 0; start < table->n_rows && written; start += BATCH_ROWS)
+	{
+		const size_t end = start + BATCH_ROWS < table->n_rows ? start + BATCH_ROWS : table->n_rows;
+		struct DataTable* batch = dt_table_copy_skeleton(table);
+		for (size_t row = start; row < end && batch; ++row)
+			dt_table_insert_row(batch, 3, dt_table_get_value(table, row, 0),
+				dt_table_get_value(table, row, 1), *(char**)dt_table_get_value(table, row, 2));
+
+		written = batch && dt_csv_writer_write_batch(writer, batch) == DT_SUCCESS;
+		if (batch)
+			dt_table_free(&batch);
+	}
+
+	return dt_csv_writer_close(&writer) == DT_SUCCESS && written && !writer;
+}
+
+int main()
+{
+	int status = -1;
+	struct DataTable* table = NULL;
+	struct DataTable* read = NULL;
+	struct DataTable* other = NULL;
+	struct dt_csv_writer* writer = NULL;
+
+	FILE* csv_file = fopen("writer_table.csv", "w");
+	fprintf(csv_file, "id,amount,label\n");
+	for (size_t i = 0; i < N_ROWS; ++i)
+		fprintf(csv_file, "%zu,%zu.25,\"label %zu, quoted\"\n", i, i % 100, i % 17);
+	fclose(csv_file);
+
+	table = dt_table_read_csv("writer_table.csv", ',', NULL);
+	if (!table || table->n_rows != N_ROWS)
+	{
+		fprintf(stderr, "Expected %d rows.\n", N_ROWS);
+		goto cleanup;
+	}
+
+	struct dt_csv_write_options options;
+	dt_csv_write_options_init(&options);
+	options.n_threads = 2;
+	if (!dt_table_to_csv_with_options(table, "writer_whole.csv", &options))
+	{
+		fprintf(stderr, "Failed to write the whole table.\n");
+		goto cleanup;
+	}
+
+	// batches give the same file as the whole table
+	if (!write_batches(table, "writer_batches.csv", &options)
+			|| !files_identical("writer_batches.csv", "writer_whole.csv"))
+	{
+		fprintf(stderr, "Expected the batches to give the same file as the whole table.\n");
+		goto cleanup;
+	}
+
+	// appending (synced) adds the rows without a second header
+	options.append = true;
+	options.sync = true;
+	remove("writer_appended.csv");
+	if (!write_batches(table, "writer_appended.csv", &options)
+			|| !dt_table_to_csv_with_options(table, "writer_appended.csv", &options))
+	{
+		fprintf(stderr, "Failed to append to a file.\n");
+		goto cleanup;
+	}
+
+	read = dt_table_read_csv("writer_appended.csv", ',', NULL);
+	if (!read || read->n_rows != 2 * N_ROWS || read->n_columns != 3
+			|| *(uint64_t*)dt_table_get_value(read, N_ROWS + 5, 0) != 5
+			|| strcmp(*(char**)dt_table_get_value(read, 2 * N_ROWS - 1, 2), "label 2, quoted") != 0)
+	{
+		fprintf(stderr, "Expected the appended rows after the first ones.\n");
+		goto cleanup;
+	}
+	dt_table_free(&read);
+
+	// appending to a compressed file adds a gzip member
+	if (dt_csv_compression_supported(DT_CSV_COMPRESSION_GZIP))
+	{
+		remove("writer_appended.csv.gz");
+		options.sync = false;
+		if (!write_batches(table, "writer_appended.csv.gz", &options)
+				|| !write_batches(table, "writer_appended.csv.gz", &options))
+		{
+			fprintf(stderr, "Failed to append to a gzip file.\n");
+			goto cleanup;
+		}
+
+		read = dt_table_read_csv("writer_appended.csv.gz", ',', NULL);
+		if (!read || read->n_rows != 2 * N_ROWS
+				|| *(uint64_t*)dt_table_get_value(read, 2 * N_ROWS - 1, 0) != N_ROWS - 1)
+		{
+			fprintf(stderr, "Expected both members of the gzip file to be read.\n");
+			goto cleanup;
+		}
+		dt_table_free(&read);
+	}
+
+	// batches must match the schema
+	dt_csv_write_options_init(&options);
+	writer = dt_csv_writer_open("writer_mismatch.csv", table, &options);
+	const char dropped[1][DT_MAX_COL_LEN] = { "label" };
+	other = dt_table_copy_skeleton(table);
+	if (!writer || !other || dt_table_drop_columns_by_name(other, 1, dropped) != DT_SUCCESS
+			|| dt_csv_writer_write_batch(writer, other) != DT_SIZE_MISMATCH)
+	{
+		fprintf(stderr, "Expected a batch with fewer columns to be rejected.\n");
+		goto cleanup;
+	}
+	dt_table_free(&other);
+
+	const char names[3][DT_MAX_COL_LEN] = { "id", "amount", "label" };
+	const enum data_type_e types[3] = { UINT64, DOUBLE, UINT32 };
+	other = dt_table_create(3, names, types);
+	if (!other || dt_csv_writer_write_batch(writer, other) != DT_TYPE_MISMATCH
+			|| dt_csv_writer_close(&writer) != DT_SUCCESS)
+	{
+		fprintf(stderr, "Expected a batch with other types to be rejected.\n");
+		goto cleanup;
+	}
+
+	read = dt_table_read_csv("writer_mismatch.csv", ',', NULL);
+	if (!read || read->n_rows != 0 || read->n_columns != 3)
+	{
+		fprintf(stderr, "Expected only the header to be written.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (table)
+		dt_table_free(&table);
+	if (read)
+		dt_table_free(&read);
+	if (other)
+		dt_table_free(&other);
+	if (writer)
+		dt_csv_writer_close(&writer);
+	remove("writer_table.csv");
+	remove("writer_whole.csv");
+	remove("writer_batches.csv");
+	remove("writer_appended.csv");
+	remove("writer_appended.csv.gz");
+	remove("writer_mismatch.csv");
+	return status;
+}
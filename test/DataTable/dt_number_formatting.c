@@ -0,0 +1,169 @@
+#include "DataTable.h"
+#include <stdio.h>
+#include <math.h>
+
+#define N_RANDOM 500000
+
+// [value] must be formatted as [expected]
+static bool
+formats_as(
+	const double value,
+	const char* expected)
+{
+	char buffer[DT_FORMAT_BUFFER_SIZE];
+	const size_t length = dt_format_double(value, buffer);
+	if (length != strlen(expected) || strcmp(buffer, expected) != 0)
+	{
+		fprintf(stderr, "Expected %.17g to be formatted as %s but got %s.\n", value, expected, buffer);
+		return false;
+	}
+
+	return true;
+}
+
+// number of significant digits (without trailing zeros) of a formatted value
+static int
+significant_digits(
+	const char* str)
+{
+	int n_digits = 0;
+	int n_trailing_zeros = 0;
+	bool started = false;
+	for (; *str && *str != 'e'; ++str)
+	{
+		if (*str < '0' || *str > '9')
+			continue;
+
+		started = started || *str != '0';
+		if (!started)
+			continue;
+
+		n_digits++;
+		n_trailing_zeros = *str == '0' ? n_trailing_zeros + 1 : 0;
+	}
+
+	return n_digits - n_trailing_zeros;
+}
+
+// [value] must be formatted with no more digits than the shortest %.*e that reads back the same,
+// and dt_parse_double must read back the exact same bits
+static bool
+round_trips(
+	const double value)
+{
+	char buffer[DT_FORMAT_BUFFER_SIZE];
+	const size_t length = dt_format_double(value, buffer);
+
+	double parsed = 0.0;
+	if (dt_parse_double(buffer, length, &parsed) != length || memcmp(&parsed, &value, sizeof(value)) != 0)
+	{
+		fprintf(stderr, "%.17g was formatted as %s which reads back as %.17g.\n", value, buffer, parsed);
+		return false;
+	}
+
+	int shortest = 17;
+	char expected[64];
+	for (int precision = 1; precision < 17; ++precision)
+	{
+		snprintf(expected, sizeof(expected), "%.*e", precision - 1, value);
+		if (strtod(expected, NULL) == value)
+		{
+			shortest = precision;
+			break;
+		}
+	}
+
+	if (value != 0.0 && significant_digits(buffer) > shortest)
+	{
+		fprintf(stderr, "%.17g was formatted as %s but %d digits are enough.\n", value, buffer, shortest);
+		return false;
+	}
+
+	const float float_value = (float)value;
+	if (isinf(float_value))
+		return true;
+
+	const size_t float_length = dt_format_float(float_value, buffer);
+	float float_parsed = 0.0f;
+	if (dt_parse_float(buffer, float_length, &float_parsed) != float_length
+			|| memcmp(&float_parsed, &float_value, sizeof(float_value)) != 0)
+	{
+		fprintf(stderr, "%.9g was formatted as %s which reads back as %.9g.\n", float_value, buffer, float_parsed);
+		return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	char buffer[DT_FORMAT_BUFFER_SIZE];
+
+	if (dt_format_uint64(0, buffer) != 1 || strcmp(buffer, "0") != 0
+			|| dt_format_uint64(UINT64_MAX, buffer) != 20 || strcmp(buffer, "18446744073709551615") != 0
+			|| dt_format_int64(INT64_MIN, buffer) != 20 || strcmp(buffer, "-9223372036854775808") != 0
+			|| dt_format_int64(-705, buffer) != 4 || strcmp(buffer, "-705") != 0)
+	{
+		fprintf(stderr, "Unexpected integer formatting: %s.\n", buffer);
+		return -1;
+	}
+
+	for (uint64_t value = 1; value < UINT64_MAX / 7; value = value * 7 + 3)
+	{
+		uint64_t parsed = 0;
+		const size_t length = dt_format_uint64(value, buffer);
+		if (dt_parse_uint64(buffer, length, &parsed) != length || parsed != value)
+		{
+			fprintf(stderr, "%llu was formatted as %s.\n", (unsigned long long)value, buffer);
+			return -1;
+		}
+	}
+
+	if (!formats_as(0.1, "0.1") || !formats_as(100.0, "100.0") || !formats_as(-2.5, "-2.5")
+			|| !formats_as(0.0, "0.0") || !formats_as(-0.0, "-0.0")
+			|| !formats_as(1.0 / 3.0, "0.3333333333333333")
+			|| !formats_as(0.0001, "0.0001") || !formats_as(0.00001, "1e-05")
+			|| !formats_as(1e15, "1000000000000000.0") || !formats_as(1e16, "1e+16")
+			|| !formats_as(123456789012345678.0, "1.2345678901234568e+17")
+			|| !formats_as(5e-324, "5e-324") || !formats_as(1.7976931348623157e308, "1.7976931348623157e+308")
+			|| !formats_as(INFINITY, "inf") || !formats_as(-INFINITY, "-inf") || !formats_as(NAN, "nan"))
+		return -1;
+
+	if (dt_format_float(0.1f, buffer) != 3 || strcmp(buffer, "0.1") != 0
+			|| dt_format_float(3.4028235e38f, buffer) == 0 || strcmp(buffer, "3.4028235e+38") != 0)
+	{
+		fprintf(stderr, "Unexpected float formatting: %s.\n", buffer);
+		return -1;
+	}
+
+	// random bit patterns, decimal fractions, integers and powers of two
+	uint64_t state = 88172645463325252ULL;
+	for (size_t i = 0; i < N_RANDOM; ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+
+		double value = 0.0;
+		switch (i % 4)
+		{
+			case 0:
+				memcpy(&value, &state, sizeof(value));
+				break;
+			case 1:
+				value = (double)(state % 100000000) / (double)(1 + (state >> 40) % 10000);
+				break;
+			case 2:
+				value = (double)(int64_t)(state >> (state % 64));
+				break;
+			case 3:
+				value = ldexp(1.0, (int)(state % 2100) - 1075);
+				break;
+		}
+
+		if (!isnan(value) && !isinf(value) && !round_trips(value))
+			return -1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,155 @@
+#include "DataTable.h"
+#include <stdio.h>
+#include <math.h>
+
+#define N_RANDOM 200000
+
+// parse [str] with dt_parse_double/dt_parse_float and strtod/strtof and compare the bits
+// and the number of characters parsed
+static bool
+same_as_libc(
+	const char* str)
+{
+	const size_t length = strlen(str);
+
+	double value = 0.0;
+	char* end = NULL;
+	const double expected = strtod(str, &end);
+	const size_t n_parsed = dt_parse_double(str, length, &value);
+	if (n_parsed != (size_t)(end - str) || (n_parsed > 0 && memcmp(&value, &expected, sizeof(value)) != 0
+			&& !(isnan(value) && isnan(expected))))
+	{
+		fprintf(stderr, "double \"%s\": got %.17g (%zu chars), expected %.17g (%zu chars).\n",
+			str, value, n_parsed, expected, (size_t)(end - str));
+		return false;
+	}
+
+	float float_value = 0.0f;
+	const float float_expected = strtof(str, &end);
+	const size_t n_float_parsed = dt_parse_float(str, length, &float_value);
+	if (n_float_parsed != (size_t)(end - str) || (n_float_parsed > 0
+			&& memcmp(&float_value, &float_expected, sizeof(float_value)) != 0
+			&& !(isnan(float_value) && isnan(float_expected))))
+	{
+		fprintf(stderr, "float \"%s\": got %.9g (%zu chars), expected %.9g (%zu chars).\n",
+			str, float_value, n_float_parsed, float_expected, (size_t)(end - str));
+		return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	int status = -1;
+
+	struct DataColumn* column = NULL;
+
+	// integers, parsed 8 digits at a time
+	uint64_t unsigned_value = 0;
+	int64_t signed_value = 0;
+	if (dt_parse_uint64("18446744073709551615", 20, &unsigned_value) != 20 || unsigned_value != UINT64_MAX
+			|| dt_parse_uint64("  +000123456789012345xyz", 24, &unsigned_value) != 21
+			|| unsigned_value != 123456789012345ULL
+			|| dt_parse_int64("-9223372036854775808", 20, &signed_value) != 20 || signed_value != INT64_MIN
+			|| dt_parse_int64("9223372036854775807", 19, &signed_value) != 19 || signed_value != INT64_MAX
+			|| dt_parse_int64("-42,", 4, &signed_value) != 3 || signed_value != -42
+			|| dt_parse_uint64("123456789", 4, &unsigned_value) != 4 || unsigned_value != 1234)
+	{
+		fprintf(stderr, "Unexpected integer parsed.\n");
+		goto cleanup;
+	}
+
+	// overflow and missing numbers are reported as nothing parsed
+	if (dt_parse_uint64("18446744073709551616", 20, &unsigned_value) != 0
+			|| dt_parse_uint64("100000000000000000000", 21, &unsigned_value) != 0
+			|| dt_parse_uint64("-1", 2, &unsigned_value) != 0
+			|| dt_parse_int64("9223372036854775808", 19, &signed_value) != 0
+			|| dt_parse_int64("-9223372036854775809", 20, &signed_value) != 0
+			|| dt_parse_int64("-", 1, &signed_value) != 0
+			|| dt_parse_int64("", 0, &signed_value) != 0)
+	{
+		fprintf(stderr, "Expected out of range integers to be rejected.\n");
+		goto cleanup;
+	}
+
+	char buffer[512];
+	for (uint64_t i = 0; i < N_RANDOM; ++i)
+	{
+		const uint64_t expected = ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+		const uint64_t digits = expected >> (rand() % 64);
+		sprintf(buffer, "%llu", (unsigned long long)digits);
+		if (dt_parse_uint64(buffer, strlen(buffer), &unsigned_value) != strlen(buffer) || unsigned_value != digits)
+		{
+			fprintf(stderr, "Expected %s but got %llu.\n", buffer, (unsigned long long)unsigned_value);
+			goto cleanup;
+		}
+	}
+
+	// floating-point values: tricky cases, then random ones compared bit for bit
+	const char* cases[] =
+	{
+		"0", "-0", "0.0", "1", "-1.5", ".5", "5.", ".", "-", "+.e1", "1e", "1e+", "1e-5x", "  \t12.5",
+		"0.1", "0.2", "0.3", "3.14159265358979323846", "1.7976931348623157e308", "1.7976931348623159e308",
+		"2.2250738585072011e-308", "2.2250738585072014e-308", "4.9e-324", "2.4703282292062327e-324",
+		"2.4703282292062328e-324", "1e-400", "1e400", "9007199254740993", "9007199254740992.000000000001",
+		"9007199254740993.000000000000000000000000000000000000000000000000000000000000000000000000001",
+		"123456789012345678901234567890", "0.000000000000000000000000000000000000000000001234",
+		"7.038531e-26", "3.4028235e38", "3.4028236e38", "1.17549435e-38", "1.4e-45", "16777217",
+		"inf", "-Infinity", "nan", "0x1p-2", "0X1.8", "1e99999999999999999999", "00000000000000000000001.5",
+		"1.000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+			"000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001",
+		"2.225073858507201136057409796709131975934819546351645648023426109724822222021076945516529523908135"
+			"087914149158913039621106870086438694594645527657207407820621743379988141063267329253552286881372"
+			"149012981122451451889849057222307285255133155755015914397476397983411801999323962548289017107081"
+			"850690630666655994938275772572015763062690663332647565300009245888316433037779791869612049497390"
+			"377829704905051080609940730262937128958950003583799967207254304360284078895771796150945516748243"
+			"471030702609144621572289880258182545180325707018860872113128079512233426288368622321503775666622"
+			"503982534335974568884423900265498198385487948292206894721689831099698365846814022854243330660339"
+			"850886445804001034933970427567186443383770486037861622771738545623065874679014086723327636718751"
+	};
+	for (size_t i = 0; i < sizeof(cases) / sizeof(*cases); ++i)
+	{
+		if (!same_as_libc(cases[i]))
+			goto cleanup;
+	}
+
+	for (size_t i = 0; i < N_RANDOM; ++i)
+	{
+		const double value = ldexp((double)rand() / RAND_MAX, rand() % 2100 - 1075);
+		const int precision = 1 + rand() % 25;
+		sprintf(buffer, "%.*g", precision, i % 2 ? value : -value);
+		if (!same_as_libc(buffer))
+			goto cleanup;
+
+		// random digits with the decimal point anywhere
+		const size_t n_digits = 1 + rand() % 40;
+		size_t k = 0;
+		for (; k < n_digits; ++k)
+			buffer[k] = (char)('0' + rand() % 10);
+		buffer[rand() % n_digits] = '.';
+		k += sprintf(buffer + k, "e%d", rand() % 700 - 350);
+		if (!same_as_libc(buffer))
+			goto cleanup;
+	}
+
+	// the cast from STRING uses the same parsers
+	dt_column_create(&column, 0, STRING);
+	dt_column_append_value(column, "0.1");
+	dt_column_append_value(column, "-2.5e3");
+	dt_column_append_value(column, "x");
+	dt_column_cast(column, DOUBLE);
+	if (*(double*)dt_column_get_value_ptr(column, 0) != 0.1
+			|| *(double*)dt_column_get_value_ptr(column, 1) != -2500.0
+			|| *(double*)dt_column_get_value_ptr(column, 2) != 0.0)
+	{
+		fprintf(stderr, "Expected strings to be cast to doubles.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (column)
+		dt_column_free(&column);
+	return status;
+}
@@ -0,0 +1,137 @@
+#include "DataTable.h"
+#include <stdio.h>
+
+// counts live allocations to verify everything goes through the allocator
+static void*
+counting_allocate(
+	void* context,
+	size_t size)
+{
+	(*(size_t*)context)++;
+	return malloc(size);
+}
+
+static void*
+counting_reallocate(
+	void* context,
+	void* ptr,
+	size_t old_size,
+	size_t new_size)
+{
+	(void)context;
+	(void)old_size;
+	return realloc(ptr, new_size);
+}
+
+static void
+counting_deallocate(
+	void* context,
+	void* ptr)
+{
+	(*(size_t*)context)--;
+	free(ptr);
+}
+
+static bool
+is_even(
+	void* item,
+	void* user_data)
+{
+	(void)user_data;
+	return *(int32_t*)item % 2 == 0;
+}
+
+int main()
+{
+	int status = -1;
+
+	char colnames[2][DT_MAX_COL_LEN] = { "id", "name" };
+	enum data_type_e types[2] = { INT32, STRING };
+	char* names[4] = { "zero", "one", "two", "three" };
+
+	// custom global allocator
+	size_t live_allocations = 0;
+	struct dt_allocator counting = {
+		.allocate = &counting_allocate,
+		.reallocate = &counting_reallocate,
+		.deallocate = &counting_deallocate,
+		.context = &live_allocations
+	};
+
+	dt_set_default_allocator(&counting);
+	struct DataTable* table = dt_table_create(2, colnames, types);
+	dt_set_default_allocator(NULL);
+
+	for (int32_t i = 0; i < 4; ++i)
+		dt_table_insert_row(table, 2, &i, names[i]);
+
+	struct DataTable* filtered = dt_table_filter_by_index(table, 0, &is_even, NULL);
+	if (filtered->allocator != &counting || filtered->n_rows != 2)
+	{
+		fprintf(stderr, "Expected filtered table to use the custom allocator and have 2 rows.\n");
+		goto cleanup;
+	}
+
+	dt_table_free(&filtered);
+	dt_table_free(&table);
+	if (live_allocations != 0)
+	{
+		fprintf(stderr, "Expected every allocation to be released but %zu are still live.\n", live_allocations);
+		goto cleanup;
+	}
+
+	// arena allocator
+	struct dt_arena* arena = dt_arena_create(4096);
+	const struct dt_allocator* arena_allocator = dt_arena_allocator(arena);
+	for (size_t round = 0; round < 3; ++round)
+	{
+		struct DataTable* left = dt_table_create_with_allocator(2, colnames, types, arena_allocator);
+		struct DataTable* right = dt_table_create_with_allocator(2, colnames, types, arena_allocator);
+		for (int32_t i = 0; i < 100; ++i)
+		{
+			dt_table_insert_row(left, 2, &i, names[i % 4]);
+			if (i % 3 == 0)
+				dt_table_insert_row(right, 2, &i, names[i % 4]);
+		}
+
+		char join_columns[1][DT_MAX_COL_LEN] = { "id" };
+		struct DataTable* joined = dt_table_join_inner(left, right, 1, join_columns);
+		if (!joined || joined->n_rows != 34 || joined->allocator != arena_allocator)
+		{
+			fprintf(stderr, "Expected inner join to have 34 rows allocated from the arena.\n");
+			dt_arena_free(&arena);
+			goto cleanup;
+		}
+
+		const int32_t* value = dt_table_get_value(joined, 10, 0);
+		if (*value != 30)
+		{
+			fprintf(stderr, "Expected joined[10, 0] to be 30 but got %d.\n", *value);
+			dt_arena_free(&arena);
+			goto cleanup;
+		}
+
+		if (dt_arena_bytes_used(arena) == 0)
+		{
+			fprintf(stderr, "Expected arena to be in use.\n");
+			dt_arena_free(&arena);
+			goto cleanup;
+		}
+
+		// release every table at once (no need to call dt_table_free)
+		dt_arena_reset(arena);
+		if (dt_arena_bytes_used(arena) != 0)
+		{
+			fprintf(stderr, "Expected arena to be empty after reset.\n");
+			dt_arena_free(&arena);
+			goto cleanup;
+		}
+	}
+	dt_arena_free(&arena);
+
+	status = 0;
+cleanup:
+	dt_table_free(&filtered);
+	dt_table_free(&table);
+	return status;
+}
@@ -0,0 +1,195 @@
+#include "DataTable.h"
+#include <stdio.h>
+
+#define N_ROWS 1000
+
+// fails every allocation once the number left in [context] runs out
+static void*
+limited_allocate(
+	void* context,
+	size_t size)
+{
+	size_t* n_left = context;
+	if (*n_left == 0)
+		return NULL;
+
+	(*n_left)--;
+	return malloc(size);
+}
+
+static void*
+limited_reallocate(
+	void* context,
+	void* ptr,
+	size_t old_size,
+	size_t new_size)
+{
+	(void)context;
+	(void)old_size;
+	return realloc(ptr, new_size);
+}
+
+static void
+limited_deallocate(
+	void* context,
+	void* ptr)
+{
+	(void)context;
+	free(ptr);
+}
+
+int main()
+{
+	int status = -1;
+
+	char colnames[3][DT_MAX_COL_LEN] = { "id", "score", "name" };
+	enum data_type_e types[3] = { INT32, DOUBLE, STRING };
+	struct DataTable* table = dt_table_create(3, colnames, types);
+
+	int32_t ids[N_ROWS];
+	double scores[N_ROWS];
+	const char* names[N_ROWS];
+	bool score_valid[N_ROWS];
+	for (int32_t i = 0; i < N_ROWS; ++i)
+	{
+		ids[i] = i;
+		scores[i] = i * 0.5;
+		names[i] = i % 2 == 0 ? "even" : "odd";
+		score_valid[i] = i % 10 != 0;
+	}
+	names[7] = NULL;
+
+	if (dt_table_reserve(table, 2 * N_ROWS) != DT_SUCCESS)
+	{
+		fprintf(stderr, "Failed to reserve rows.\n");
+		goto cleanup;
+	}
+
+	// reserving must not reallocate on the following appends
+	const void* reserved_buffer = table->columns[0].column->value;
+
+	const void* buffers[3] = { ids, scores, names };
+	const bool* validity[3] = { NULL, score_valid, NULL };
+
+	// append in two batches, the second without validity
+	if (dt_table_append_rows(table, N_ROWS, buffers, validity) != DT_SUCCESS
+			|| dt_table_append_rows(table, N_ROWS, buffers, NULL) != DT_SUCCESS)
+	{
+		fprintf(stderr, "Failed to append rows.\n");
+		goto cleanup;
+	}
+
+	if (table->n_rows != 2 * N_ROWS || table->columns[2].column->n_values != 2 * N_ROWS)
+	{
+		fprintf(stderr, "Expected %d rows but got %zu.\n", 2 * N_ROWS, table->n_rows);
+		goto cleanup;
+	}
+
+	if (table->columns[0].column->value != reserved_buffer)
+	{
+		fprintf(stderr, "Expected reserved buffer to be reused.\n");
+		goto cleanup;
+	}
+
+	for (size_t r = 0; r < 2 * N_ROWS; ++r)
+	{
+		const size_t i = r % N_ROWS;
+		const int32_t id = *(const int32_t*)dt_table_get_value(table, r, 0);
+		const double score = *(const double*)dt_table_get_value(table, r, 1);
+		const char* name = *(char* const*)dt_table_get_value(table, r, 2);
+
+		const bool score_null = r < N_ROWS && i % 10 == 0;
+		if (id != (int32_t)i
+				|| dt_table_check_isnull(table, r, 1) != score_null
+				|| (!score_null && score != i * 0.5))
+		{
+			fprintf(stderr, "Unexpected id/score at row %zu.\n", r);
+			goto cleanup;
+		}
+
+		if (i == 7)
+		{
+			if (name != NULL || !dt_table_check_isnull(table, r, 2))
+			{
+				fprintf(stderr, "Expected NULL string at row %zu to be null.\n", r);
+				goto cleanup;
+			}
+		}
+		else if (strcmp(name, names[i]) != 0 || name == names[i])
+		{
+			fprintf(stderr, "Expected a copy of '%s' at row %zu.\n", names[i], r);
+			goto cleanup;
+		}
+	}
+
+	// NULL buffers are rejected
+	buffers[1] = NULL;
+	if (dt_table_append_rows(table, 1, buffers, NULL) != DT_BAD_ARG || table->n_rows != 2 * N_ROWS)
+	{
+		fprintf(stderr, "Expected DT_BAD_ARG for a NULL column buffer.\n");
+		goto cleanup;
+	}
+
+	// rows appended in bulk can still be appended one at a time afterwards
+	int32_t id = -1;
+	double score = -1.0;
+	if (dt_table_insert_row(table, 3, &id, &score, "last") != DT_SUCCESS
+			|| *(const int32_t*)dt_table_get_value(table, 2 * N_ROWS, 0) != -1)
+	{
+		fprintf(stderr, "Failed to insert a row after bulk append.\n");
+		goto cleanup;
+	}
+
+	// a string that can't be copied leaves every column as it was
+	dt_table_free(&table);
+	size_t n_left = SIZE_MAX;
+	const struct dt_allocator limited = {
+		&limited_allocate, &limited_reallocate, &limited_deallocate, &n_left, NULL
+	};
+	char failing_colnames[3][DT_MAX_COL_LEN] = { "name", "id", "other_name" };
+	enum data_type_e failing_types[3] = { STRING, INT32, STRING };
+	table = dt_table_create_with_allocator(3, failing_colnames, failing_types, &limited);
+	const void* failing_buffers[3] = { names + 8, ids, names + 8 };
+	const bool* failing_validity[3] = { NULL, score_valid, NULL };
+	if (!table || dt_table_append_rows(table, 10, failing_buffers, failing_validity) != DT_SUCCESS
+			|| dt_table_reserve(table, 100) != DT_SUCCESS)
+	{
+		fprintf(stderr, "Failed to append rows with a custom allocator.\n");
+		goto cleanup;
+	}
+
+	// the 10 strings of the first column are copied but not all of the last one
+	n_left = 13;
+	if (dt_table_append_rows(table, 10, failing_buffers, failing_validity) != DT_ALLOC_ERROR
+			|| table->n_rows != 10)
+	{
+		fprintf(stderr, "Expected DT_ALLOC_ERROR when a string can't be copied.\n");
+		goto cleanup;
+	}
+
+	for (size_t c = 0; c < table->n_columns; ++c)
+	{
+		const struct DataColumn* column = table->columns[c].column;
+		if (column->n_values != 10 || column->n_null_values != (c == 1 ? 1 : 0))
+		{
+			fprintf(stderr, "Expected column %zu to be left with 10 values.\n", c);
+			goto cleanup;
+		}
+	}
+
+	n_left = SIZE_MAX;
+	if (dt_table_append_rows(table, 10, failing_buffers, failing_validity) != DT_SUCCESS
+			|| table->n_rows != 20
+			|| strcmp(*(char* const*)dt_table_get_value(table, 19, 2), names[17]) != 0
+			|| !dt_table_check_isnull(table, 10, 1))
+	{
+		fprintf(stderr, "Expected rows to be appended after a failure.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (table)
+		dt_table_free(&table);
+	return status;
+}
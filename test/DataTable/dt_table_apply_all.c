@@ -14,6 +14,18 @@ double_values(
 	*value *= 2;
 }
 
+// user callback to flip all values in a table of BOOL values
+void
+flip_values(
+	void* current_cell_value,
+	void* user_data)
+{
+	(void)user_data; // unused
+
+	bool* value = current_cell_value;
+	*value = !*value;
+}
+
 int main()
 {
 	int status = -1;
@@ -49,6 +61,34 @@ int main()
 		}
 	}
 
+	// BOOL values are bits: the callback gets a copy which is written back
+	dt_table_free(&table);
+	char bool_colnames[1][DT_MAX_COL_LEN] = { "flag" };
+	enum data_type_e bool_types[1] = { BOOL };
+	table = dt_table_create(1, bool_colnames, bool_types);
+	const bool flags[3] = { true, false, true };
+	for (size_t r = 0; r < 3; ++r)
+		dt_table_insert_row(table, 1, &flags[r]);
+	dt_table_insert_row(table, 1, NULL);
+
+	dt_table_apply_all(table, &flip_values, NULL);
+
+	for (size_t r = 0; r < 3; ++r)
+	{
+		const bool* get = dt_table_get_value(table, r, 0);
+		if (*get == flags[r])
+		{
+			fprintf(stderr, "Expected BOOL value at row %zu to be flipped.\n", r);
+			goto cleanup;
+		}
+	}
+
+	if (*(const bool*)dt_table_get_value(table, 3, 0) != true || dt_table_check_isnull(table, 3, 0))
+	{
+		fprintf(stderr, "Expected the NULL BOOL value to be flipped to true.\n");
+		goto cleanup;
+	}
+
 	status = 0;
 cleanup:
 	dt_table_free(&table);
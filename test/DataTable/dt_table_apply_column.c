@@ -14,6 +14,21 @@ add_columns(
 	*value = *col1 + *col2;
 }
 
+void
+compare_columns(
+	void* current_row_value,
+	void* user_data,
+	const void** const column_values)
+{
+	(void)user_data; // unused
+
+	bool* value = current_row_value;
+	const int32_t* const col1 = column_values[0];
+	const int32_t* const col2 = column_values[1];
+
+	*value = *value || *col1 > *col2;
+}
+
 int main()
 {
 	int status = -1;
@@ -78,6 +93,28 @@ int main()
 		goto cleanup;
 	}
 
+	// BOOL values are bits: the callback gets a copy which is written back
+	dt_table_free(&table);
+	char bool_colnames[3][DT_MAX_COL_LEN] = { "col1", "col2", "flag" };
+	enum data_type_e bool_types[3] = { INT32, INT32, BOOL };
+	table = dt_table_create(3, bool_colnames, bool_types);
+	const bool flag = true;
+	set1 = 1;
+	set2 = 2;
+	dt_table_insert_row(table, 3, &set1, &set2, NULL);
+	dt_table_insert_row(table, 3, &set2, &set1, NULL);
+	dt_table_insert_row(table, 3, &set1, &set2, &flag);
+
+	if (dt_table_apply_column(table, "flag", &compare_columns, NULL, 2, column_value_names) != DT_SUCCESS
+			|| *(const bool*)dt_table_get_value(table, 0, 2) != false
+			|| *(const bool*)dt_table_get_value(table, 1, 2) != true
+			|| *(const bool*)dt_table_get_value(table, 2, 2) != true
+			|| dt_table_get_column_ptr_by_index(table, 2)->n_null_values > 0)
+	{
+		fprintf(stderr, "Expected the BOOL column to be set by the callback.\n");
+		goto cleanup;
+	}
+
 	status = 0;
 cleanup:
 	dt_table_free(&table);
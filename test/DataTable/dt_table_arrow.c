@@ -0,0 +1,181 @@
+#include "DataTable.h"
+#include "ArrowInterface.h"
+#include "dt_test_helpers.h"
+#include <stdio.h>
+
+#define N_ROWS 5000
+#define N_COLUMNS 6
+
+// export [table] and import it back (sharing its buffers)
+static bool
+round_trip(
+	const struct DataTable* table)
+{
+	struct ArrowSchema schema;
+	struct ArrowArray array;
+	if (dt_table_export_arrow(table, &schema, &array) != DT_SUCCESS)
+		return false;
+
+	struct DataTable* imported = dt_table_import_arrow(&schema, &array);
+	const bool same = imported && !array.release && tables_identical(table, imported);
+	if (imported)
+		dt_table_free(&imported);
+	else
+		array.release(&array);
+	schema.release(&schema);
+
+	return same && !schema.release;
+}
+
+static size_t n_released = 0;
+
+// release callback of the arrays built by hand below (their buffers are static)
+static void
+release_array(
+	struct ArrowArray* array)
+{
+	for (int64_t i = 0; i < array->n_children; ++i)
+		array->children[i]->release = NULL;
+	array->release = NULL;
+	n_released++;
+}
+
+int main()
+{
+	int status = -1;
+	struct DataTable* table = NULL;
+	struct DataTable* slice = NULL;
+	struct DataTable* imported = NULL;
+
+	const char names[N_COLUMNS][DT_MAX_COL_LEN] = { "id", "score", "name", "flag", "day", "time" };
+	const enum data_type_e types[N_COLUMNS] = { INT64, FLOAT, STRING, BOOL, DATE, TIMESTAMP };
+	table = dt_table_create(N_COLUMNS, names, types);
+	char name[32];
+	for (size_t i = 0; i < N_ROWS; ++i)
+	{
+		const int64_t id = (int64_t)i - 100;
+		const float score = (float)i * 0.25f;
+		const bool flag = i % 3 == 0;
+		const int32_t day = (int32_t)i;
+		const int64_t time = (int64_t)i * 1000000007;
+		snprintf(name, sizeof(name), "name %zu", i);
+		dt_table_insert_row(table, N_COLUMNS, &id, i % 7 == 0 ? NULL : &score, i % 11 == 0 ? NULL : name,
+			i % 13 == 0 ? NULL : &flag, &day, &time);
+	}
+	dt_column_set_time_unit(table->columns[5].column, DT_TIME_UNIT_NANOSECONDS);
+
+	// fixed-width columns are shared, the types map to Arrow formats
+	struct ArrowSchema schema;
+	struct ArrowArray array;
+	if (dt_table_export_arrow(table, &schema, &array) != DT_SUCCESS
+			|| strcmp(schema.format, "+s") != 0 || schema.n_children != N_COLUMNS
+			|| array.length != N_ROWS || array.n_children != N_COLUMNS
+			|| strcmp(schema.children[0]->format, "l") != 0
+			|| strcmp(schema.children[2]->format, "u") != 0
+			|| strcmp(schema.children[4]->format, "tdD") != 0
+			|| strcmp(schema.children[5]->format, "tsn:UTC") != 0
+			|| strcmp(schema.children[2]->name, "name") != 0
+			|| array.children[0]->buffers[1] != table->columns[0].column->value
+			|| array.children[1]->null_count != (N_ROWS + 6) / 7
+			|| ((const uint8_t*)array.children[1]->buffers[0])[0] != 0x7E
+			|| ((const int32_t*)array.children[2]->buffers[1])[2] != 6
+			|| memcmp(array.children[2]->buffers[2], "name 1name 2", 12) != 0)
+	{
+		fprintf(stderr, "Expected the table to be exported as a struct array.\n");
+		goto cleanup;
+	}
+	array.release(&array);
+	schema.release(&schema);
+	if (array.release || schema.release)
+	{
+		fprintf(stderr, "Expected release to mark the structures released.\n");
+		goto cleanup;
+	}
+
+	if (!round_trip(table))
+	{
+		fprintf(stderr, "Expected the table back from Arrow.\n");
+		goto cleanup;
+	}
+
+	// views start in the middle of BOOL words, chunked columns are copied
+	slice = dt_table_slice(table, 77, 3000);
+	if (!slice || !round_trip(slice))
+	{
+		fprintf(stderr, "Expected a slice back from Arrow.\n");
+		goto cleanup;
+	}
+	dt_table_free(&slice);
+
+	if (dt_column_make_chunked(table->columns[0].column, 256) != DT_SUCCESS || !round_trip(table))
+	{
+		fprintf(stderr, "Expected chunked columns back from Arrow.\n");
+		goto cleanup;
+	}
+
+	// arrays from other producers: offsets, validity bitmaps and time zones
+	static const int32_t values[6] = { 10, 20, 30, 40, 50, 60 };
+	static const uint8_t validity[1] = { 0x3B }; // value 2 (30) is null
+	static const int64_t offsets[7] = { 0, 1, 3, 3, 6, 6, 10 };
+	static const char bytes[] = "abbcccdddd";
+	static const uint8_t bits[1] = { 0x2A };
+	const void* int_buffers[2] = { validity, values };
+	const void* string_buffers[3] = { NULL, offsets, bytes };
+	const void* bool_buffers[2] = { NULL, bits };
+	const void* struct_buffers[1] = { NULL };
+	struct ArrowArray children[3] = {
+		{ 5, 1, 1, 2, 0, int_buffers, NULL, NULL, &release_array, NULL },
+		{ 5, 0, 1, 3, 0, string_buffers, NULL, NULL, &release_array, NULL },
+		{ 6, 0, 0, 2, 0, bool_buffers, NULL, NULL, &release_array, NULL }
+	};
+	struct ArrowArray* child_arrays[3] = { &children[0], &children[1], &children[2] };
+	struct ArrowSchema child_schemas[3] = {
+		{ "i", "count", NULL, ARROW_FLAG_NULLABLE, 0, NULL, NULL, NULL, NULL },
+		{ "U", "text", NULL, ARROW_FLAG_NULLABLE, 0, NULL, NULL, NULL, NULL },
+		{ "b", "bit", NULL, ARROW_FLAG_NULLABLE, 0, NULL, NULL, NULL, NULL }
+	};
+	struct ArrowSchema* child_schema_ptrs[3] = { &child_schemas[0], &child_schemas[1], &child_schemas[2] };
+	struct ArrowSchema batch_schema = { "+s", "", NULL, 0, 3, child_schema_ptrs, NULL, NULL, NULL };
+	struct ArrowArray batch = { 4, 0, 1, 1, 3, struct_buffers, child_arrays, NULL, &release_array, NULL };
+
+	// rows 1 to 4 of the struct: values 2 to 5 of the first two children, 1 to 4 of the last
+	imported = dt_table_import_arrow(&batch_schema, &batch);
+	if (!imported || batch.release || imported->n_rows != 4 || imported->n_columns != 3
+			|| !dt_table_check_isnull(imported, 0, 0)
+			|| *(int32_t*)dt_table_get_value(imported, 1, 0) != 40
+			|| strcmp(imported->columns[1].name, "text") != 0
+			|| strcmp(*(char**)dt_table_get_value(imported, 1, 1), "ccc") != 0
+			|| strcmp(*(char**)dt_table_get_value(imported, 3, 1), "dddd") != 0
+			|| *(bool*)dt_table_get_value(imported, 0, 2) != true
+			|| *(bool*)dt_table_get_value(imported, 1, 2) != false
+			|| n_released != 0)
+	{
+		fprintf(stderr, "Expected the values of a hand-built array.\n");
+		goto cleanup;
+	}
+	dt_table_free(&imported);
+	if (n_released != 1)
+	{
+		fprintf(stderr, "Expected the array to be released with the table.\n");
+		goto cleanup;
+	}
+
+	// unsupported types leave the array to the caller
+	batch.release = &release_array;
+	child_schemas[0].format = "+l";
+	if ((imported = dt_table_import_arrow(&batch_schema, &batch)) || !batch.release)
+	{
+		fprintf(stderr, "Expected a list column to be rejected.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (table)
+		dt_table_free(&table);
+	if (slice)
+		dt_table_free(&slice);
+	if (imported)
+		dt_table_free(&imported);
+	return status;
+}
@@ -0,0 +1,213 @@
+#include "DataTable.h"
+#include <stdio.h>
+
+static bool
+is_even(void* item, void* user_data)
+{
+	(void)user_data;
+	return *(uint32_t*)item % 2 == 0;
+}
+
+static bool
+is_multiple_of_three(void* item, void* user_data)
+{
+	(void)user_data;
+	return *(uint32_t*)item % 3 == 0;
+}
+
+int main()
+{
+	int status = -1;
+
+	struct DataColumn* flags = NULL;
+	struct DataColumn* view = NULL;
+	struct DataColumn* numbers = NULL;
+	struct DataColumn* even = NULL;
+	struct DataColumn* three = NULL;
+	struct DataColumn* subset = NULL;
+	struct DataTable* table = NULL;
+	struct DataTable* filtered = NULL;
+	struct DataTable* csv_table = NULL;
+	struct DataTable* inferred_table = NULL;
+
+	// 200 flags: every third one is true
+	dt_column_create(&flags, 0, BOOL);
+	for (size_t i = 0; i < 200; ++i)
+	{
+		bool value = i % 3 == 0;
+		dt_column_append_value(flags, &value);
+	}
+
+	for (size_t i = 0; i < 200; ++i)
+	{
+		bool value = false;
+		dt_column_get_value(flags, i, &value);
+		if (value != (i % 3 == 0))
+		{
+			fprintf(stderr, "Expected flag %zu to be %d.\n", i, i % 3 == 0);
+			goto cleanup;
+		}
+	}
+
+	// one bit per value (rounded up to whole words)
+	if (((uint64_t*)flags->value)[0] != 0x9249249249249249ULL)
+	{
+		fprintf(stderr, "Expected flags to be packed into bits.\n");
+		goto cleanup;
+	}
+
+	size_t n_true = 0;
+	dt_column_sum(flags, &n_true);
+	if (n_true != 67)
+	{
+		fprintf(stderr, "Expected 67 true values but got %zu.\n", n_true);
+		goto cleanup;
+	}
+
+	// views don't have to start on a word boundary
+	view = dt_column_view(flags, 70, 100);
+	n_true = 0;
+	dt_column_sum(view, &n_true);
+	if (n_true != 33 || *(bool*)dt_column_get_value_ptr(view, 2) != true)
+	{
+		fprintf(stderr, "Expected view to have 33 true values but got %zu.\n", n_true);
+		goto cleanup;
+	}
+
+	// NOT on a view materializes it and leaves the parent untouched
+	dt_column_not(view);
+	n_true = 0;
+	dt_column_sum(view, &n_true);
+	if (view->is_view || n_true != 67)
+	{
+		fprintf(stderr, "Expected negated view to have 67 true values but got %zu.\n", n_true);
+		goto cleanup;
+	}
+	n_true = 0;
+	dt_column_sum(flags, &n_true);
+	if (n_true != 67)
+	{
+		fprintf(stderr, "Expected parent to be unchanged after negating the view.\n");
+		goto cleanup;
+	}
+
+	// masks built from filters and combined word at a time
+	dt_column_create(&numbers, 0, UINT32);
+	for (uint32_t i = 0; i < 150; ++i)
+		dt_column_append_value(numbers, &i);
+
+	even = dt_column_filter_to_mask(numbers, &is_even, NULL);
+	three = dt_column_filter_to_mask(numbers, &is_multiple_of_three, NULL);
+	if (!even || !three || even->type != BOOL || even->n_values != 150)
+	{
+		fprintf(stderr, "Expected filter masks with 150 values.\n");
+		goto cleanup;
+	}
+
+	if (dt_column_and(even, three) != DT_SUCCESS)
+	{
+		fprintf(stderr, "Expected AND to succeed.\n");
+		goto cleanup;
+	}
+
+	subset = dt_column_subset_by_mask(numbers, even);
+	if (!subset || subset->n_values != 25 || *(uint32_t*)dt_column_get_value_ptr(subset, 24) != 144)
+	{
+		fprintf(stderr, "Expected 25 multiples of six.\n");
+		goto cleanup;
+	}
+
+	if (dt_column_or(even, numbers) != DT_TYPE_MISMATCH
+			|| dt_column_xor(even, flags) != DT_SIZE_MISMATCH)
+	{
+		fprintf(stderr, "Expected bitwise kernels to reject mismatched columns.\n");
+		goto cleanup;
+	}
+
+	// casting to and from BOOL
+	dt_column_cast(numbers, BOOL);
+	n_true = 0;
+	dt_column_sum(numbers, &n_true);
+	if (numbers->type != BOOL || n_true != 149)
+	{
+		fprintf(stderr, "Expected every non-zero value to cast to true.\n");
+		goto cleanup;
+	}
+
+	dt_column_cast(numbers, STRING);
+	if (strcmp(*(char**)dt_column_get_value_ptr(numbers, 0), "false") != 0
+			|| strcmp(*(char**)dt_column_get_value_ptr(numbers, 1), "true") != 0)
+	{
+		fprintf(stderr, "Expected BOOL to cast to \"true\"/\"false\".\n");
+		goto cleanup;
+	}
+
+	// filtering a table by a mask
+	char col_names[2][DT_MAX_COL_LEN] = { "id", "flag" };
+	enum data_type_e col_types[2] = { UINT32, BOOL };
+	table = dt_table_create(2, (const char(*)[DT_MAX_COL_LEN])col_names, col_types);
+	for (uint32_t i = 0; i < 10; ++i)
+	{
+		bool flag = i < 4;
+		dt_table_insert_row(table, 2, &i, &flag);
+	}
+
+	filtered = dt_table_filter_by_mask(table, table->columns[1].column);
+	if (!filtered || filtered->n_rows != 4 || *(uint32_t*)dt_table_get_value(filtered, 3, 0) != 3)
+	{
+		fprintf(stderr, "Expected 4 rows after filtering by the flag column.\n");
+		goto cleanup;
+	}
+
+	// CSV parsing: true/false/0/1 with explicit types, true/false with inference
+	FILE* csv_file = fopen("bool_table.csv", "w");
+	fprintf(csv_file, "flag,word\n1,TRUE\n0,false\ntrue,True\nFalse,false\n");
+	fclose(csv_file);
+
+	enum data_type_e csv_types[2] = { BOOL, BOOL };
+	csv_table = dt_table_read_csv("bool_table.csv", ',', csv_types);
+	bool expected_flags[4] = { true, false, true, false };
+	bool expected_words[4] = { true, false, true, false };
+	for (size_t i = 0; i < 4; ++i)
+	{
+		if (*(bool*)dt_table_get_value(csv_table, i, 0) != expected_flags[i]
+				|| *(bool*)dt_table_get_value(csv_table, i, 1) != expected_words[i])
+		{
+			fprintf(stderr, "Unexpected BOOL value parsed from row %zu.\n", i);
+			goto cleanup;
+		}
+	}
+
+	inferred_table = dt_table_read_csv("bool_table.csv", ',', NULL);
+	if (inferred_table->columns[0].column->type != STRING
+			|| inferred_table->columns[1].column->type != BOOL)
+	{
+		fprintf(stderr, "Expected only the true/false column to be inferred as BOOL.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (flags)
+		dt_column_free(&flags);
+	if (view)
+		dt_column_free(&view);
+	if (numbers)
+		dt_column_free(&numbers);
+	if (even)
+		dt_column_free(&even);
+	if (three)
+		dt_column_free(&three);
+	if (subset)
+		dt_column_free(&subset);
+	if (table)
+		dt_table_free(&table);
+	if (filtered)
+		dt_table_free(&filtered);
+	if (csv_table)
+		dt_table_free(&csv_table);
+	if (inferred_table)
+		dt_table_free(&inferred_table);
+	remove("bool_table.csv");
+	return status;
+}
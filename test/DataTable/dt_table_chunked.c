@@ -0,0 +1,127 @@
+#include "DataTable.h"
+#include <stdio.h>
+
+static bool
+filter_multiple_of_100(
+	void* item,
+	void* user_data)
+{
+	(void)user_data;
+	return *(int64_t*)item % 100 == 0;
+}
+
+int main()
+{
+	int status = -1;
+
+	char colnames[2][DT_MAX_COL_LEN] = { "id", "name" };
+	enum data_type_e types[2] = { INT64, STRING };
+	struct DataTable* table = dt_table_create(2, colnames, types);
+	struct DataTable* filtered = NULL;
+	struct DataTable* slice = NULL;
+
+	// 100 is rounded up to a chunk size of 128
+	if (dt_table_make_chunked(table, 100) != DT_SUCCESS
+			|| table->columns[0].column->chunk_size != 128
+			|| dt_table_make_chunked(table, 0) != DT_BAD_ARG)
+	{
+		fprintf(stderr, "Failed to switch table to chunked storage.\n");
+		goto cleanup;
+	}
+
+	int64_t first = 0;
+	dt_table_insert_row(table, 2, &first, "first");
+	const void* first_value = dt_table_get_value(table, 0, 0);
+
+	// grow through several chunks one row at a time and in bulk
+	for (int64_t i = 1; i < 300; ++i)
+		dt_table_insert_row(table, 2, &i, "row");
+
+	int64_t ids[700];
+	const char* names[700];
+	for (int64_t i = 0; i < 700; ++i)
+	{
+		ids[i] = 300 + i;
+		names[i] = "bulk";
+	}
+	const void* buffers[2] = { ids, names };
+	if (dt_table_append_rows(table, 700, buffers, NULL) != DT_SUCCESS || table->n_rows != 1000)
+	{
+		fprintf(stderr, "Expected 1000 rows after appending.\n");
+		goto cleanup;
+	}
+
+	// existing values never move when a chunked column grows
+	if (dt_table_get_value(table, 0, 0) != first_value)
+	{
+		fprintf(stderr, "Expected first value to stay in place.\n");
+		goto cleanup;
+	}
+
+	struct DataColumn* id_column = table->columns[0].column;
+	for (int64_t i = 0; i < 1000; ++i)
+	{
+		if (*(const int64_t*)dt_table_get_value(table, i, 0) != i)
+		{
+			fprintf(stderr, "Unexpected id at row %ld.\n", (long)i);
+			goto cleanup;
+		}
+	}
+
+	int64_t sum = 0;
+	dt_column_sum(id_column, &sum);
+	if (sum != 999 * 1000 / 2)
+	{
+		fprintf(stderr, "Expected sum 499500 but got %ld.\n", (long)sum);
+		goto cleanup;
+	}
+
+	filtered = dt_table_filter_by_name(table, "id", &filter_multiple_of_100, NULL);
+	if (!filtered || filtered->n_rows != 10
+			|| *(const int64_t*)dt_table_get_value(filtered, 9, 0) != 900)
+	{
+		fprintf(stderr, "Expected 10 filtered rows.\n");
+		goto cleanup;
+	}
+
+	dt_table_set_value(table, 130, 0, NULL);
+	if (!dt_table_check_isnull(table, 130, 0))
+	{
+		fprintf(stderr, "Expected row 130 to be null.\n");
+		goto cleanup;
+	}
+
+	// a slice crossing a chunk boundary
+	slice = dt_table_slice(table, 120, 20);
+	if (!slice || *(const int64_t*)dt_table_get_value(slice, 19, 0) != 139
+			|| strcmp(*(char* const*)dt_table_get_value(slice, 0, 1), "row") != 0
+			|| !dt_table_check_isnull(slice, 10, 0))
+	{
+		fprintf(stderr, "Unexpected slice of chunked table.\n");
+		goto cleanup;
+	}
+
+	// casting keeps the chunked layout
+	dt_column_cast(id_column, DOUBLE);
+	if (id_column->chunk_size != 128 || *(const double*)dt_table_get_value(table, 999, 0) != 999.0
+			|| *(const double*)dt_table_get_value(table, 130, 0) != 0.0)
+	{
+		fprintf(stderr, "Expected cast column to remain chunked.\n");
+		goto cleanup;
+	}
+
+	if (dt_column_make_contiguous(id_column) != DT_SUCCESS
+			|| id_column->chunk_size != 0
+			|| *(const double*)dt_table_get_value(table, 500, 0) != 500.0)
+	{
+		fprintf(stderr, "Failed to switch column back to contiguous storage.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	dt_table_free(&slice);
+	dt_table_free(&filtered);
+	dt_table_free(&table);
+	return status;
+}
@@ -0,0 +1,225 @@
+#include "DataTable.h"
+#include <stdio.h>
+
+int main()
+{
+	int status = -1;
+
+	struct DataTable* table = NULL;
+	struct DataTable* written_table = NULL;
+	struct DataColumn* column = NULL;
+
+	// parsing
+	int32_t days = 0;
+	if (!dt_parse_date("1970-01-02", &days) || days != 1
+			|| !dt_parse_date("1969-12-31", &days) || days != -1
+			|| !dt_parse_date("2024-02-29", &days) || days != 19782)
+	{
+		fprintf(stderr, "Unexpected days parsed from a valid date.\n");
+		goto cleanup;
+	}
+
+	if (dt_parse_date("2023-02-29", &days) || dt_parse_date("2023-13-01", &days)
+			|| dt_parse_date("2023-1-01", &days) || dt_parse_date("2023-01-01x", &days))
+	{
+		fprintf(stderr, "Expected invalid dates to be rejected.\n");
+		goto cleanup;
+	}
+
+	int64_t timestamp = 0;
+	if (!dt_parse_timestamp("2021-03-04T05:06:07.123456789Z", DT_TIME_UNIT_MILLISECONDS, &timestamp)
+			|| timestamp != 1614834367123LL)
+	{
+		fprintf(stderr, "Expected fractions to be truncated to the unit.\n");
+		goto cleanup;
+	}
+
+	int64_t utc = 0;
+	if (!dt_parse_timestamp("2021-03-04 07:36:07+02:30", DT_TIME_UNIT_SECONDS, &timestamp)
+			|| !dt_parse_timestamp("2021-03-04T05:06:07", DT_TIME_UNIT_SECONDS, &utc)
+			|| timestamp != utc)
+	{
+		fprintf(stderr, "Expected offsets to be converted to UTC.\n");
+		goto cleanup;
+	}
+
+	if (dt_parse_timestamp("2021-03-04T24:00", DT_TIME_UNIT_SECONDS, &timestamp)
+			|| dt_parse_timestamp("2021-03-04T05:06:07.", DT_TIME_UNIT_SECONDS, &timestamp))
+	{
+		fprintf(stderr, "Expected invalid timestamps to be rejected.\n");
+		goto cleanup;
+	}
+
+	// nanoseconds since the epoch only fit in an int64_t from 1677 to 2262
+	if (dt_parse_timestamp("2263-01-01", DT_TIME_UNIT_NANOSECONDS, &timestamp)
+			|| dt_parse_timestamp("1600-01-01T00:00:00Z", DT_TIME_UNIT_NANOSECONDS, &timestamp)
+			|| dt_parse_timestamp("2262-04-11T23:47:16.854775808Z", DT_TIME_UNIT_NANOSECONDS, &timestamp)
+			|| !dt_parse_timestamp("2262-04-11T23:47:16.854775807Z", DT_TIME_UNIT_NANOSECONDS, &timestamp)
+			|| timestamp != INT64_MAX
+			|| !dt_parse_timestamp("2263-01-01", DT_TIME_UNIT_MICROSECONDS, &timestamp))
+	{
+		fprintf(stderr, "Expected timestamps out of the unit's range to be rejected.\n");
+		goto cleanup;
+	}
+
+	// before the epoch, down to INT64_MIN nanoseconds and the earliest 4-digit year for the others
+	if (!dt_parse_timestamp("1969-12-31T23:59:59.5", DT_TIME_UNIT_MILLISECONDS, &timestamp)
+			|| timestamp != -500
+			|| !dt_parse_timestamp("1900-01-01T00:00:00.5", DT_TIME_UNIT_MICROSECONDS, &timestamp)
+			|| timestamp != -2208988799500000LL
+			|| !dt_parse_timestamp("1677-09-21T00:12:43.145224192Z", DT_TIME_UNIT_NANOSECONDS, &timestamp)
+			|| timestamp != INT64_MIN
+			|| dt_parse_timestamp("1677-09-21T00:12:43.145224191Z", DT_TIME_UNIT_NANOSECONDS, &timestamp)
+			|| !dt_parse_timestamp("0000-01-01", DT_TIME_UNIT_SECONDS, &timestamp)
+			|| timestamp != -62167219200LL
+			|| !dt_parse_timestamp("0000-01-01T00:00:00.001", DT_TIME_UNIT_MILLISECONDS, &timestamp)
+			|| timestamp != -62167219200000LL + 1
+			|| !dt_parse_timestamp("0000-01-01T00:00:00.000001", DT_TIME_UNIT_MICROSECONDS, &timestamp)
+			|| timestamp != -62167219200000000LL + 1)
+	{
+		fprintf(stderr, "Expected timestamps before the epoch to be parsed.\n");
+		goto cleanup;
+	}
+
+	// formatting
+	char buffer[DT_TIMESTAMP_BUFFER_SIZE];
+	dt_format_date(-1, buffer);
+	if (strcmp(buffer, "1969-12-31") != 0)
+	{
+		fprintf(stderr, "Expected 1969-12-31 but got %s.\n", buffer);
+		goto cleanup;
+	}
+
+	dt_format_timestamp(-1, DT_TIME_UNIT_MICROSECONDS, buffer);
+	if (strcmp(buffer, "1969-12-31T23:59:59.999999") != 0)
+	{
+		fprintf(stderr, "Expected 1969-12-31T23:59:59.999999 but got %s.\n", buffer);
+		goto cleanup;
+	}
+
+	// reading a CSV: types are inferred and every value is an integer
+	FILE* csv_file = fopen("datetime_table.csv", "w");
+	fprintf(csv_file, "day,event_time,label\n");
+	fprintf(csv_file, "2024-01-31,2024-01-31T10:00:00.5,a\n");
+	fprintf(csv_file, "2023-12-25,2023-12-25,b\n");
+	fprintf(csv_file, ",2024-02-01T00:00:00Z,c\n");
+	fclose(csv_file);
+
+	table = dt_table_read_csv("datetime_table.csv", ',', NULL);
+	if (!table || table->columns[0].column->type != DATE
+			|| table->columns[1].column->type != TIMESTAMP
+			|| table->columns[2].column->type != STRING)
+	{
+		fprintf(stderr, "Expected DATE, TIMESTAMP and STRING columns.\n");
+		goto cleanup;
+	}
+
+	if (table->columns[0].column->n_null_values != 1)
+	{
+		fprintf(stderr, "Expected the empty date to be null.\n");
+		goto cleanup;
+	}
+
+	int32_t max_day = 0;
+	dt_column_max(table->columns[0].column, &max_day);
+	dt_format_date(max_day, buffer);
+	if (strcmp(buffer, "2024-01-31") != 0)
+	{
+		fprintf(stderr, "Expected max date 2024-01-31 but got %s.\n", buffer);
+		goto cleanup;
+	}
+
+	int64_t min_time = 0;
+	dt_column_min(table->columns[1].column, &min_time);
+	dt_format_timestamp(min_time, table->columns[1].column->time_unit, buffer);
+	if (strcmp(buffer, "2023-12-25T00:00:00.000000") != 0)
+	{
+		fprintf(stderr, "Expected min timestamp 2023-12-25T00:00:00.000000 but got %s.\n", buffer);
+		goto cleanup;
+	}
+
+	// writing and reading back gives the same values
+	if (!dt_table_to_csv(table, "datetime_output.csv", ','))
+	{
+		fprintf(stderr, "Failed to write CSV.\n");
+		goto cleanup;
+	}
+
+	written_table = dt_table_read_csv("datetime_output.csv", ',', NULL);
+	if (!written_table || written_table->columns[1].column->type != TIMESTAMP)
+	{
+		fprintf(stderr, "Expected written timestamps to be read back as TIMESTAMP.\n");
+		goto cleanup;
+	}
+
+	for (size_t i = 0; i < table->n_rows; ++i)
+	{
+		if (*(int64_t*)dt_table_get_value(table, i, 1) != *(int64_t*)dt_table_get_value(written_table, i, 1))
+		{
+			fprintf(stderr, "Timestamp at row %zu changed after writing.\n", i);
+			goto cleanup;
+		}
+	}
+
+	// casts and units
+	column = dt_column_copy(table->columns[1].column);
+	if (dt_column_set_time_unit(column, DT_TIME_UNIT_SECONDS) != DT_SUCCESS
+			|| *(int64_t*)dt_column_get_value_ptr(column, 0) != 1706695200LL)
+	{
+		fprintf(stderr, "Expected the timestamp to be rescaled to seconds.\n");
+		goto cleanup;
+	}
+
+	dt_column_cast(column, DATE);
+	if (column->type != DATE || *(int32_t*)dt_column_get_value_ptr(column, 0) != 19753)
+	{
+		fprintf(stderr, "Expected the timestamp to be cast to a date.\n");
+		goto cleanup;
+	}
+
+	dt_column_cast(column, STRING);
+	if (strcmp(*(char**)dt_column_get_value_ptr(column, 2), "2024-02-01") != 0)
+	{
+		fprintf(stderr, "Expected the date to be cast to a string.\n");
+		goto cleanup;
+	}
+
+	dt_column_cast(column, TIMESTAMP);
+	dt_format_timestamp(*(int64_t*)dt_column_get_value_ptr(column, 1), column->time_unit, buffer);
+	if (strcmp(buffer, "2023-12-25T00:00:00.000000") != 0)
+	{
+		fprintf(stderr, "Expected the string to be cast back to a timestamp but got %s.\n", buffer);
+		goto cleanup;
+	}
+
+	// dates and timestamps before the epoch are inferred too
+	dt_table_free(&table);
+	csv_file = fopen("datetime_table.csv", "w");
+	fprintf(csv_file, "day,event_time\n");
+	fprintf(csv_file, "1969-12-31,1900-01-01T00:00:00.5\n");
+	fprintf(csv_file, "1900-01-01,1969-12-31T23:59:59Z\n");
+	fclose(csv_file);
+
+	table = dt_table_read_csv("datetime_table.csv", ',', NULL);
+	if (!table || table->columns[0].column->type != DATE
+			|| table->columns[1].column->type != TIMESTAMP
+			|| *(int32_t*)dt_table_get_value(table, 0, 0) != -1
+			|| *(int64_t*)dt_table_get_value(table, 0, 1) != -2208988799500000LL
+			|| *(int64_t*)dt_table_get_value(table, 1, 1) != -1000000)
+	{
+		fprintf(stderr, "Expected DATE and TIMESTAMP columns before the epoch.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (table)
+		dt_table_free(&table);
+	if (written_table)
+		dt_table_free(&written_table);
+	if (column)
+		dt_column_free(&column);
+	remove("datetime_table.csv");
+	remove("datetime_output.csv");
+	return status;
+}
@@ -0,0 +1,120 @@
+#include "DataTable.h"
+#include "dt_test_helpers.h"
+#include <stdio.h>
+
+#define N_ROWS 100000
+
+int main()
+{
+	int status = -1;
+
+	struct DataTable* sampled = NULL;
+	struct DataTable* scanned = NULL;
+	struct DataTable* parallel = NULL;
+
+	// every column looks narrower in the first rows than it is
+	FILE* csv_file = fopen("inference_table.csv", "w");
+	fprintf(csv_file, "count,code,when,late,flag,part\n");
+	for (size_t i = 0; i < N_ROWS; ++i)
+	{
+		if (i == 60000)
+			fprintf(csv_file, "-5,");
+		else if (i == 90000)
+			fprintf(csv_file, "2.5,");
+		else
+			fprintf(csv_file, "%zu,", i);
+
+		if (i == 70000)
+			fprintf(csv_file, "n/a,");
+		else
+			fprintf(csv_file, "%03zu,", i % 1000);
+
+		if (i == 80000)
+			fprintf(csv_file, "2024-03-01T12:30:00,");
+		else
+			fprintf(csv_file, "2024-03-%02zu,", i % 28 + 1);
+
+		if (i >= 50000)
+			fprintf(csv_file, "%s", i % 2 ? "true" : "false");
+
+		fprintf(csv_file, ",%s,", i == 95000 ? "maybe" : i % 3 ? "true" : "false");
+
+		// a '-' inside a value makes it a string, whether it's sampled or not
+		if (i == 65000)
+			fprintf(csv_file, "12-3\n");
+		else
+			fprintf(csv_file, "%zu\n", i);
+	}
+	fclose(csv_file);
+
+	struct dt_csv_options options;
+	dt_csv_options_init(&options);
+	options.n_threads = 1;
+	options.n_inference_rows = 100;
+	sampled = dt_table_read_csv_with_options("inference_table.csv", &options);
+	if (!sampled)
+	{
+		fprintf(stderr, "Failed to read CSV.\n");
+		goto cleanup;
+	}
+
+	const enum data_type_e expected_types[6] = { DOUBLE, STRING, TIMESTAMP, BOOL, STRING, STRING };
+	for (size_t i = 0; i < 6; ++i)
+	{
+		if (sampled->columns[i].column->type != expected_types[i])
+		{
+			fprintf(stderr, "Expected column %zu to be promoted to %s but got %s.\n",
+				i,
+				dt_type_to_str(expected_types[i]),
+				dt_type_to_str(sampled->columns[i].column->type));
+			goto cleanup;
+		}
+	}
+
+	// values read before a promotion are kept (strings keep the exact text of the field)
+	if (*(double*)dt_table_get_value(sampled, 59999, 0) != 59999.0
+			|| *(double*)dt_table_get_value(sampled, 60000, 0) != -5.0
+			|| *(double*)dt_table_get_value(sampled, 90000, 0) != 2.5
+			|| strcmp(*(char**)dt_table_get_value(sampled, 7, 1), "007") != 0
+			|| strcmp(*(char**)dt_table_get_value(sampled, 70000, 1), "n/a") != 0
+			|| strcmp(*(char**)dt_table_get_value(sampled, 0, 4), "false") != 0
+			|| strcmp(*(char**)dt_table_get_value(sampled, 95000, 4), "maybe") != 0
+			|| strcmp(*(char**)dt_table_get_value(sampled, 64999, 5), "64999") != 0
+			|| strcmp(*(char**)dt_table_get_value(sampled, 65000, 5), "12-3") != 0
+			|| sampled->columns[3].column->n_null_values != 50000)
+	{
+		fprintf(stderr, "Expected values to be kept after promoting columns.\n");
+		goto cleanup;
+	}
+
+	// same result as looking at every record first, or splitting the file between threads
+	options.n_inference_rows = 0;
+	scanned = dt_table_read_csv_with_options("inference_table.csv", &options);
+
+	options.n_inference_rows = 100;
+	options.n_threads = 3;
+	parallel = dt_table_read_csv_with_options("inference_table.csv", &options);
+
+	if (!scanned || !tables_identical(sampled, scanned))
+	{
+		fprintf(stderr, "Expected sampled inference to match inference over every record.\n");
+		goto cleanup;
+	}
+
+	if (!parallel || !tables_identical(sampled, parallel))
+	{
+		fprintf(stderr, "Expected promotions in parallel chunks to match a single thread.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (sampled)
+		dt_table_free(&sampled);
+	if (scanned)
+		dt_table_free(&scanned);
+	if (parallel)
+		dt_table_free(&parallel);
+	remove("inference_table.csv");
+	return status;
+}
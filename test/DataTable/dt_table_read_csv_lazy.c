@@ -0,0 +1,173 @@
+#include "DataTable.h"
+#include <stdio.h>
+
+#define N_ROWS 120000
+
+// column [col] of [table1] must be identical to column [col] of [table2]
+static bool
+columns_identical(
+	const struct DataTable* table1,
+	const struct DataTable* table2,
+	const size_t col)
+{
+	const struct DataColumn* column1 = dt_table_get_column_ptr_by_index(table1, col);
+	const struct DataColumn* column2 = dt_table_get_column_ptr_by_index(table2, col);
+	if (!column1 || !column2 || column1->type != column2->type
+			|| column1->n_values != column2->n_values
+			|| column1->n_null_values != column2->n_null_values)
+		return false;
+
+	for (size_t row = 0; row < column1->n_values; ++row)
+	{
+		const void* value1 = dt_column_get_value_ptr(column1, row);
+		const void* value2 = dt_column_get_value_ptr(column2, row);
+		if (column1->type == STRING
+				? strcmp(*(char**)value1, *(char**)value2) != 0
+				: memcmp(value1, value2, column1->type_size) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+static bool
+is_even(void* item, void* user_data)
+{
+	(void)user_data;
+	return item && *(uint64_t*)item % 2 == 0;
+}
+
+int main()
+{
+	int status = -1;
+
+	struct DataTable* eager = NULL;
+	struct DataTable* lazy = NULL;
+	struct DataTable* subset = NULL;
+
+	// "code" is a number for the first 1000 rows (the sample) and then text,
+	// "amount" has nulls and quoted values and there are blank lines
+	FILE* csv_file = fopen("lazy_table.csv", "w");
+	fprintf(csv_file, "id,code,amount,label\n");
+	for (size_t i = 0; i < N_ROWS; ++i)
+	{
+		if (i % 1000 == 999)
+			fprintf(csv_file, "\n");
+
+		fprintf(csv_file, "%zu,", i);
+		if (i < 1000)
+			fprintf(csv_file, "%zu,", i % 7);
+		else
+			fprintf(csv_file, "c%zu,", i % 13);
+
+		if (i % 9 == 0)
+			fprintf(csv_file, ",");
+		else if (i % 9 == 1)
+			fprintf(csv_file, "\"%zu.25\",", i);
+		else
+			fprintf(csv_file, "%zu.5,", i);
+
+		fprintf(csv_file, "\"label %zu,\nnext line\"\n", i);
+	}
+	fclose(csv_file);
+
+	struct dt_csv_options options;
+	dt_csv_options_init(&options);
+	options.n_inference_rows = 1000;
+	options.n_threads = 3;
+	eager = dt_table_read_csv_with_options("lazy_table.csv", &options);
+
+	options.lazy = true;
+	lazy = dt_table_read_csv_with_options("lazy_table.csv", &options);
+	if (!eager || !lazy || !lazy->lazy || lazy->n_rows != N_ROWS || eager->n_rows != N_ROWS)
+	{
+		fprintf(stderr, "Expected a lazy table of %d rows.\n", N_ROWS);
+		goto cleanup;
+	}
+
+	// a column is parsed (and promoted) the first time it's used, on its own
+	if (strcmp(*(char**)dt_table_get_value(lazy, 5000, 1), "c8") != 0
+			|| !columns_identical(eager, lazy, 1)
+			|| !lazy->lazy)
+	{
+		fprintf(stderr, "Expected the code column to be parsed as STRING on first access.\n");
+		goto cleanup;
+	}
+
+	if (!dt_table_check_isnull(lazy, 9, 2) || !columns_identical(eager, lazy, 2))
+	{
+		fprintf(stderr, "Expected the amount column to have nulls.\n");
+		goto cleanup;
+	}
+
+	// operators parse what they need
+	const char selected[1][DT_MAX_COL_LEN] = { "id" };
+	subset = dt_table_select(lazy, 1, selected);
+	if (!subset || *(uint64_t*)dt_table_get_value(subset, 77, 0) != 77)
+	{
+		fprintf(stderr, "Expected the selected id column to be parsed.\n");
+		goto cleanup;
+	}
+	dt_table_free(&subset);
+
+	if (dt_table_load_columns(lazy) != DT_SUCCESS || lazy->lazy)
+	{
+		fprintf(stderr, "Expected every column to be parsed.\n");
+		goto cleanup;
+	}
+
+	for (size_t col = 0; col < eager->n_columns; ++col)
+	{
+		if (!columns_identical(eager, lazy, col))
+		{
+			fprintf(stderr, "Column %zu differs from the eagerly read one.\n", col);
+			goto cleanup;
+		}
+	}
+	dt_table_free(&lazy);
+
+	// dropped columns are never parsed, other operators parse the rest
+	lazy = dt_table_read_csv_with_options("lazy_table.csv", &options);
+	const char dropped[2][DT_MAX_COL_LEN] = { "label", "code" };
+	if (!lazy || dt_table_drop_columns_by_name(lazy, 2, dropped) != DT_SUCCESS || !lazy->lazy)
+	{
+		fprintf(stderr, "Failed to drop lazy columns.\n");
+		goto cleanup;
+	}
+
+	subset = dt_table_head(lazy, 10);
+	if (!subset || subset->n_rows != 10 || subset->n_columns != 2 || lazy->lazy
+			|| *(double*)dt_table_get_value(subset, 2, 1) != 2.5)
+	{
+		fprintf(stderr, "Expected the remaining columns to be parsed by dt_table_head.\n");
+		goto cleanup;
+	}
+	dt_table_free(&subset);
+	dt_table_free(&lazy);
+
+	// filters are applied while indexing
+	const char filter_columns[1][DT_MAX_COL_LEN] = { "id" };
+	bool (*filter_callbacks[1])(void*, void*) = { is_even };
+	options.n_filters = 1;
+	options.filter_columns = filter_columns;
+	options.filter_callbacks = filter_callbacks;
+	lazy = dt_table_read_csv_with_options("lazy_table.csv", &options);
+	if (!lazy || lazy->n_rows != N_ROWS / 2
+			|| *(uint64_t*)dt_table_get_value(lazy, 100, 0) != 200
+			|| strcmp(*(char**)dt_table_get_value(lazy, 600, 1), "c4") != 0)
+	{
+		fprintf(stderr, "Expected only the even ids.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (eager)
+		dt_table_free(&eager);
+	if (lazy)
+		dt_table_free(&lazy);
+	if (subset)
+		dt_table_free(&subset);
+	remove("lazy_table.csv");
+	return status;
+}
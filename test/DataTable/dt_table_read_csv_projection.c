@@ -0,0 +1,160 @@
+#include "DataTable.h"
+#include <stdio.h>
+
+#define N_ROWS 100000
+
+static bool
+city_is_paris(void* item, void* user_data)
+{
+	(void)user_data;
+	return item && strcmp(*(char**)item, "paris") == 0;
+}
+
+static bool
+score_above(void* item, void* user_data)
+{
+	return item && *(double*)item > *(double*)user_data;
+}
+
+int main()
+{
+	int status = -1;
+
+	struct DataTable* table = NULL;
+	struct DataTable* threaded = NULL;
+	struct DataTable* batch = NULL;
+	struct dt_csv_reader* reader = NULL;
+
+	// rows where i % 3 == 0 are in paris; every 7th score is missing
+	FILE* csv_file = fopen("projection_table.csv", "w");
+	fprintf(csv_file, "id,note,score,city\n");
+	for (size_t i = 0; i < N_ROWS; ++i)
+	{
+		fprintf(csv_file, "%zu,\"note %zu, quoted\",", i, i);
+		if (i % 7 != 0)
+			fprintf(csv_file, "%.1f", (double)(i % 100));
+		fprintf(csv_file, ",%s\n", i % 3 == 0 ? "paris" : "rome");
+	}
+	fclose(csv_file);
+
+	const char columns[2][DT_MAX_COL_LEN] = { "score", "id" };
+	const char filter_columns[2][DT_MAX_COL_LEN] = { "city", "score" };
+	bool (*filter_callbacks[2])(void*, void*) = { city_is_paris, score_above };
+	double min_score = 50.0;
+
+	struct dt_csv_options options;
+	dt_csv_options_init(&options);
+	options.columns = columns;
+	options.n_columns = 2;
+	options.n_filters = 2;
+	options.filter_columns = filter_columns;
+	options.filter_callbacks = filter_callbacks;
+	options.filter_user_data = &min_score;
+	options.n_threads = 1;
+
+	table = dt_table_read_csv_with_options("projection_table.csv", &options);
+	if (!table || table->n_columns != 2
+			|| strcmp(table->columns[0].name, "score") != 0
+			|| strcmp(table->columns[1].name, "id") != 0
+			|| table->columns[0].column->type != DOUBLE
+			|| table->columns[1].column->type != UINT64)
+	{
+		fprintf(stderr, "Expected the score and id columns only.\n");
+		goto cleanup;
+	}
+
+	size_t n_expected = 0;
+	for (size_t i = 0; i < N_ROWS; ++i)
+	{
+		if (i % 3 != 0 || i % 7 == 0 || (double)(i % 100) <= min_score)
+			continue;
+
+		if (n_expected >= table->n_rows
+				|| *(uint64_t*)dt_table_get_value(table, n_expected, 1) != i
+				|| *(double*)dt_table_get_value(table, n_expected, 0) != (double)(i % 100))
+		{
+			fprintf(stderr, "Unexpected row %zu (id %zu).\n", n_expected, i);
+			goto cleanup;
+		}
+		n_expected++;
+	}
+
+	if (table->n_rows != n_expected || table->columns[0].column->n_null_values != 0)
+	{
+		fprintf(stderr, "Expected %zu rows but got %zu.\n", n_expected, table->n_rows);
+		goto cleanup;
+	}
+
+	// splitting the input between threads gives the same rows
+	options.n_threads = 3;
+	threaded = dt_table_read_csv_with_options("projection_table.csv", &options);
+	if (!threaded || threaded->n_rows != table->n_rows)
+	{
+		fprintf(stderr, "Expected the same rows with 3 threads.\n");
+		goto cleanup;
+	}
+
+	for (size_t i = 0; i < table->n_rows; ++i)
+	{
+		if (*(uint64_t*)dt_table_get_value(table, i, 1) != *(uint64_t*)dt_table_get_value(threaded, i, 1))
+		{
+			fprintf(stderr, "Row %zu differs with 3 threads.\n", i);
+			goto cleanup;
+		}
+	}
+
+	// the streaming reader reads the same columns and rows
+	options.n_threads = 0;
+	reader = dt_csv_reader_open("projection_table.csv", &options);
+	if (!reader || dt_csv_reader_schema(reader)->n_columns != 2)
+	{
+		fprintf(stderr, "Expected the reader to read 2 columns.\n");
+		goto cleanup;
+	}
+
+	size_t n_read = 0;
+	while ((batch = dt_csv_reader_next(reader, 1000)))
+	{
+		for (size_t i = 0; i < batch->n_rows; ++i, ++n_read)
+		{
+			if (*(uint64_t*)dt_table_get_value(batch, i, 1) != *(uint64_t*)dt_table_get_value(table, n_read, 1))
+			{
+				fprintf(stderr, "Reader row %zu differs.\n", n_read);
+				goto cleanup;
+			}
+		}
+		dt_table_free(&batch);
+	}
+
+	if (dt_csv_reader_status(reader) != DT_SUCCESS || n_read != table->n_rows)
+	{
+		fprintf(stderr, "Expected the reader to read %zu rows but got %zu.\n", table->n_rows, n_read);
+		goto cleanup;
+	}
+
+	// unknown columns are an error
+	const char missing[1][DT_MAX_COL_LEN] = { "missing" };
+	options.columns = missing;
+	options.n_columns = 1;
+	options.n_filters = 0;
+	dt_table_free(&threaded);
+	threaded = dt_table_read_csv_with_options("projection_table.csv", &options);
+	if (threaded)
+	{
+		fprintf(stderr, "Expected an unknown column to fail.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (table)
+		dt_table_free(&table);
+	if (threaded)
+		dt_table_free(&threaded);
+	if (batch)
+		dt_table_free(&batch);
+	if (reader)
+		dt_csv_reader_close(&reader);
+	remove("projection_table.csv");
+	return status;
+}
@@ -0,0 +1,103 @@
+#include "DataTable.h"
+#include <stdio.h>
+
+#define N_WIDE_COLUMNS 600
+#define LONG_VALUE_LEN 10000
+
+int main()
+{
+	int status = -1;
+
+	struct DataTable* table = NULL;
+	struct DataTable* wide_table = NULL;
+
+	// quoted fields with delimiters, newlines and doubled quotes, CRLF line endings,
+	// a blank line and a last record without a line ending
+	FILE* csv_file = fopen("rfc4180_table.csv", "w");
+	fprintf(csv_file, "id,\"text, quoted\",note\r\n");
+	fprintf(csv_file, "1,\"line one\r\nline two\",\"she said \"\"hi\"\"\"\r\n");
+	fprintf(csv_file, "\r\n");
+	fprintf(csv_file, "2,,\"\"\r\n");
+	fprintf(csv_file, "3,plain,'a,b' kept");
+	fclose(csv_file);
+
+	table = dt_table_read_csv("rfc4180_table.csv", ',', NULL);
+	if (!table || table->n_columns != 3 || table->n_rows != 3)
+	{
+		fprintf(stderr, "Expected 3 columns and 3 rows.\n");
+		goto cleanup;
+	}
+
+	if (strcmp(table->columns[1].name, "text, quoted") != 0)
+	{
+		fprintf(stderr, "Expected quoted header to be unquoted but got %s.\n", table->columns[1].name);
+		goto cleanup;
+	}
+
+	const char* expected_strings[3][2] = {
+		{ "line one\r\nline two", "she said \"hi\"" },
+		{ NULL, "" },
+		{ "plain", "'a,b' kept" }
+	};
+	for (size_t i = 0; i < 3; ++i)
+	{
+		for (size_t j = 0; j < 2; ++j)
+		{
+			const char* value = *(char**)dt_table_get_value(table, i, j + 1);
+			const char* expected = expected_strings[i][j];
+			if ((expected == NULL) != (value == NULL) || (expected && strcmp(value, expected) != 0))
+			{
+				fprintf(stderr, "Unexpected value at (%zu, %zu): %s\n", i, j + 1, value ? value : "(null)");
+				goto cleanup;
+			}
+		}
+	}
+
+	if (table->columns[0].column->type != UINT64 || *(uint64_t*)dt_table_get_value(table, 2, 0) != 3)
+	{
+		fprintf(stderr, "Expected id column to be UINT64.\n");
+		goto cleanup;
+	}
+
+	// wide rows with a field far longer than any fixed line buffer
+	csv_file = fopen("wide_table.csv", "w");
+	for (size_t i = 0; i < N_WIDE_COLUMNS; ++i)
+		fprintf(csv_file, "column_%zu%c", i, i == N_WIDE_COLUMNS - 1 ? '\n' : ',');
+	for (size_t row = 0; row < 2; ++row)
+	{
+		for (size_t i = 0; i < N_WIDE_COLUMNS; ++i)
+		{
+			if (i == 1)
+				for (size_t c = 0; c < LONG_VALUE_LEN; ++c)
+					fputc('x', csv_file);
+			else
+				fprintf(csv_file, "%zu", row * N_WIDE_COLUMNS + i);
+			fputc(i == N_WIDE_COLUMNS - 1 ? '\n' : ',', csv_file);
+		}
+	}
+	fclose(csv_file);
+
+	wide_table = dt_table_read_csv("wide_table.csv", ',', NULL);
+	if (!wide_table || wide_table->n_columns != N_WIDE_COLUMNS || wide_table->n_rows != 2)
+	{
+		fprintf(stderr, "Expected %d columns and 2 rows.\n", N_WIDE_COLUMNS);
+		goto cleanup;
+	}
+
+	if (strlen(*(char**)dt_table_get_value(wide_table, 1, 1)) != LONG_VALUE_LEN
+			|| *(uint64_t*)dt_table_get_value(wide_table, 1, N_WIDE_COLUMNS - 1) != 2 * N_WIDE_COLUMNS - 1)
+	{
+		fprintf(stderr, "Expected long value and last column to be read in full.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (table)
+		dt_table_free(&table);
+	if (wide_table)
+		dt_table_free(&wide_table);
+	remove("rfc4180_table.csv");
+	remove("wide_table.csv");
+	return status;
+}
@@ -0,0 +1,92 @@
+#include "DataTable.h"
+#include "dt_test_helpers.h"
+#include <stdio.h>
+
+#define N_ROWS 60000
+
+int main()
+{
+	int status = -1;
+
+	struct DataTable* sequential = NULL;
+	struct DataTable* parallel = NULL;
+	struct DataTable* typed = NULL;
+
+	// a few MB of records with quoted fields spanning lines (some of them much
+	// longer than the window used to guess record boundaries), nulls and booleans
+	FILE* csv_file = fopen("threads_table.csv", "w");
+	fprintf(csv_file, "id,amount,text,flag,day\n");
+	for (size_t i = 0; i < N_ROWS; ++i)
+	{
+		fprintf(csv_file, "%zu,", i);
+		if (i % 7 != 0)
+			fprintf(csv_file, "%.2f", (double)i * 0.25 - 100.0);
+		if (i % 1000 == 500)
+		{
+			fprintf(csv_file, ",\"");
+			for (size_t k = 0; k < 20000; ++k)
+				fprintf(csv_file, "\"\"\n%zu,", k);
+			fprintf(csv_file, "\"");
+		}
+		else if (i % 3 == 0)
+			fprintf(csv_file, ",\"line %zu\nwith \"\"quotes\"\", and commas\"", i);
+		else
+			fprintf(csv_file, ",plain %zu", i);
+		fprintf(csv_file, ",%s,2024-01-%02zu\n", i % 2 ? "true" : "false", i % 28 + 1);
+	}
+	fclose(csv_file);
+
+	struct dt_csv_options options;
+	dt_csv_options_init(&options);
+	options.n_threads = 1;
+	sequential = dt_table_read_csv_with_options("threads_table.csv", &options);
+
+	options.n_threads = 7;
+	parallel = dt_table_read_csv_with_options("threads_table.csv", &options);
+
+	if (!sequential || !parallel || sequential->n_rows != N_ROWS)
+	{
+		fprintf(stderr, "Failed to read CSV.\n");
+		goto cleanup;
+	}
+
+	const enum data_type_e expected_types[5] = { UINT64, DOUBLE, STRING, BOOL, DATE };
+	for (size_t i = 0; i < 5; ++i)
+	{
+		if (parallel->columns[i].column->type != expected_types[i])
+		{
+			fprintf(stderr, "Expected column %zu to be %s.\n", i, dt_type_to_str(expected_types[i]));
+			goto cleanup;
+		}
+	}
+
+	if (!tables_identical(sequential, parallel))
+	{
+		fprintf(stderr, "Expected the multi-threaded result to match the single-threaded one.\n");
+		goto cleanup;
+	}
+
+	// explicit types are converted per chunk
+	const enum data_type_e column_types[5] = { UINT32, FLOAT, STRING, BOOL, STRING };
+	options.column_types = column_types;
+	options.n_threads = 4;
+	typed = dt_table_read_csv_with_options("threads_table.csv", &options);
+	if (!typed || typed->n_rows != N_ROWS || *(uint32_t*)dt_table_get_value(typed, N_ROWS - 1, 0) != N_ROWS - 1
+			|| strcmp(*(char**)dt_table_get_value(typed, 3, 2), "line 3\nwith \"quotes\", and commas") != 0
+			|| typed->columns[1].column->n_null_values != sequential->columns[1].column->n_null_values)
+	{
+		fprintf(stderr, "Unexpected values with explicit column types.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (sequential)
+		dt_table_free(&sequential);
+	if (parallel)
+		dt_table_free(&parallel);
+	if (typed)
+		dt_table_free(&typed);
+	remove("threads_table.csv");
+	return status;
+}
@@ -0,0 +1,122 @@
+#include "DataTable.h"
+#include <stdio.h>
+
+#define N_ROWS 20000
+
+// counts every allocation made while reading
+static void*
+counting_allocate(
+	void* context,
+	size_t size)
+{
+	(*(size_t*)context)++;
+	return malloc(size);
+}
+
+static void*
+counting_reallocate(
+	void* context,
+	void* ptr,
+	size_t old_size,
+	size_t new_size)
+{
+	(void)context;
+	(void)old_size;
+	return realloc(ptr, new_size);
+}
+
+static void
+counting_deallocate(
+	void* context,
+	void* ptr)
+{
+	(void)context;
+	free(ptr);
+}
+
+int main()
+{
+	int status = -1;
+
+	struct DataTable* table = NULL;
+	struct DataTable* typed_table = NULL;
+
+	FILE* csv_file = fopen("typed_table.csv", "w");
+	fprintf(csv_file, "id,value,offset,flag\n");
+	for (size_t i = 0; i < N_ROWS; ++i)
+	{
+		if (i % 10 == 0)
+			fprintf(csv_file, "%zu,,%d,\n", i, -(int)i);
+		else
+			fprintf(csv_file, "%zu,%zu.5,%d,%s\n", i, i, -(int)i, i % 2 ? "true" : "false");
+	}
+	fclose(csv_file);
+
+	size_t n_allocations = 0;
+	struct dt_allocator counting = {
+		.allocate = &counting_allocate,
+		.reallocate = &counting_reallocate,
+		.deallocate = &counting_deallocate,
+		.context = &n_allocations
+	};
+	dt_set_default_allocator(&counting);
+
+	// values are parsed in place: no allocation per value
+	struct dt_csv_options options;
+	dt_csv_options_init(&options);
+	options.n_threads = 1;
+	const enum data_type_e types[4] = { UINT32, DOUBLE, INT32, BOOL };
+	options.column_types = types;
+	typed_table = dt_table_read_csv_with_options("typed_table.csv", &options);
+	dt_set_default_allocator(NULL);
+
+	if (!typed_table || typed_table->n_rows != N_ROWS)
+	{
+		fprintf(stderr, "Failed to read CSV.\n");
+		goto cleanup;
+	}
+
+	if (n_allocations > 1000)
+	{
+		fprintf(stderr, "Expected no allocation per value but got %zu allocations.\n", n_allocations);
+		goto cleanup;
+	}
+
+	if (*(uint32_t*)dt_table_get_value(typed_table, N_ROWS - 1, 0) != N_ROWS - 1
+			|| *(double*)dt_table_get_value(typed_table, 11, 1) != 11.5
+			|| *(int32_t*)dt_table_get_value(typed_table, 7, 2) != -7
+			|| *(bool*)dt_table_get_value(typed_table, 7, 3) != true)
+	{
+		fprintf(stderr, "Unexpected parsed values.\n");
+		goto cleanup;
+	}
+
+	// empty fields are null values
+	if (typed_table->columns[1].column->n_null_values != N_ROWS / 10
+			|| typed_table->columns[3].column->n_null_values != N_ROWS / 10
+			|| !dt_table_check_isnull(typed_table, 20, 1))
+	{
+		fprintf(stderr, "Expected empty fields to be null values.\n");
+		goto cleanup;
+	}
+
+	// inferred types are parsed in place as well
+	table = dt_table_read_csv("typed_table.csv", ',', NULL);
+	if (!table || table->columns[0].column->type != UINT64 || table->columns[1].column->type != DOUBLE
+			|| table->columns[2].column->type != INT64 || table->columns[3].column->type != BOOL
+			|| *(bool*)dt_table_get_value(table, 3, 3) != true)
+	{
+		fprintf(stderr, "Unexpected inferred types or values.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	dt_set_default_allocator(NULL);
+	if (table)
+		dt_table_free(&table);
+	if (typed_table)
+		dt_table_free(&typed_table);
+	remove("typed_table.csv");
+	return status;
+}
@@ -0,0 +1,147 @@
+#include "DataTable.h"
+#include "dt_test_helpers.h"
+#include <stdio.h>
+
+#define N_ROWS 10000
+#define N_COLUMNS 6
+
+int main()
+{
+	int status = -1;
+	struct DataTable* table = NULL;
+	struct DataTable* loaded = NULL;
+	struct DataTable* slice = NULL;
+	struct DataTable* copy = NULL;
+
+	const char names[N_COLUMNS][DT_MAX_COL_LEN] = { "id", "ratio", "name", "flag", "day", "time" };
+	const enum data_type_e types[N_COLUMNS] = { UINT64, DOUBLE, STRING, BOOL, DATE, TIMESTAMP };
+	table = dt_table_create(N_COLUMNS, names, types);
+	char name[32];
+	for (size_t i = 0; i < N_ROWS; ++i)
+	{
+		// doubles that don't survive a round trip through short decimal text
+		const double ratio = (double)i / 3.0 + 0.1;
+		const bool flag = i % 3 == 0;
+		const int32_t day = (int32_t)i - 5000;
+		const int64_t time = (int64_t)i * 1000003;
+		snprintf(name, sizeof(name), i % 10 == 0 ? "" : "name %zu", i);
+		dt_table_insert_row(table, N_COLUMNS, &i, i % 7 == 0 ? NULL : &ratio, i % 11 == 0 ? NULL : name,
+			i % 13 == 0 ? NULL : &flag, &day, &time);
+	}
+	dt_column_set_time_unit(table->columns[5].column, DT_TIME_UNIT_MILLISECONDS);
+	dt_column_make_chunked(table->columns[0].column, 1024);
+
+	if (dt_table_save(table, "save_load_table.dtbl") != DT_SUCCESS)
+	{
+		fprintf(stderr, "Failed to save the table.\n");
+		goto cleanup;
+	}
+
+	loaded = dt_table_load("save_load_table.dtbl");
+	if (!loaded || !tables_identical(table, loaded))
+	{
+		fprintf(stderr, "Expected the loaded table to be identical.\n");
+		goto cleanup;
+	}
+
+	// the columns use the mapped file in place
+	for (size_t col = 0; col < loaded->n_columns; ++col)
+	{
+		const struct DataColumn* column = loaded->columns[col].column;
+		if (!column->is_view || (column->type != STRING && (uintptr_t)column->value % DT_BUFFER_ALIGNMENT != 0))
+		{
+			fprintf(stderr, "Expected column %zu to be an aligned view.\n", col);
+			goto cleanup;
+		}
+	}
+
+	// modifying a loaded table copies the column and leaves the file untouched
+	const double ratio = 42.5;
+	dt_table_set_value(loaded, 1, 1, &ratio);
+	if (*(double*)dt_table_get_value(loaded, 1, 1) != 42.5
+			|| dt_table_insert_row(loaded, N_COLUMNS, &ratio, &ratio, "new", NULL, NULL, NULL) != DT_SUCCESS
+			|| loaded->n_rows != N_ROWS + 1)
+	{
+		fprintf(stderr, "Expected a loaded table to be modifiable.\n");
+		goto cleanup;
+	}
+	dt_table_free(&loaded);
+
+	loaded = dt_table_load("save_load_table.dtbl");
+	if (!loaded || !tables_identical(table, loaded))
+	{
+		fprintf(stderr, "Expected the file to be unchanged.\n");
+		goto cleanup;
+	}
+
+	// tables derived from a loaded table own their values
+	copy = dt_table_copy(loaded);
+	dt_table_free(&loaded);
+	if (!copy || !tables_identical(table, copy))
+	{
+		fprintf(stderr, "Expected a copy to outlive the loaded table.\n");
+		goto cleanup;
+	}
+	dt_table_free(&copy);
+
+	// slices start in the middle of the BOOL words
+	slice = dt_table_slice(table, 77, 5000);
+	if (!slice || dt_table_save(slice, "save_load_table.dtbl") != DT_SUCCESS
+			|| !(loaded = dt_table_load("save_load_table.dtbl"))
+			|| !tables_identical(slice, loaded))
+	{
+		fprintf(stderr, "Expected a saved slice to be loaded back.\n");
+		goto cleanup;
+	}
+	dt_table_free(&loaded);
+
+	// empty tables
+	dt_table_free(&slice);
+	slice = dt_table_slice(table, 0, 0);
+	if (!slice || dt_table_save(slice, "save_load_table.dtbl") != DT_SUCCESS
+			|| !(loaded = dt_table_load("save_load_table.dtbl"))
+			|| !tables_identical(slice, loaded))
+	{
+		fprintf(stderr, "Expected an empty table to be loaded back.\n");
+		goto cleanup;
+	}
+	dt_table_free(&loaded);
+
+	// truncated files and other files are rejected
+	dt_table_save(table, "save_load_table.dtbl");
+	static char data[1 << 20];
+	FILE* file = fopen("save_load_table.dtbl", "rb");
+	const size_t size = fread(data, 1, sizeof(data), file);
+	fclose(file);
+	file = fopen("save_load_table.dtbl", "wb");
+	fwrite(data, 1, size - 1, file);
+	fclose(file);
+	if ((loaded = dt_table_load("save_load_table.dtbl"))
+			|| (loaded = dt_table_load("missing_table.dtbl")))
+	{
+		fprintf(stderr, "Expected a truncated file to be rejected.\n");
+		goto cleanup;
+	}
+
+	file = fopen("save_load_table.dtbl", "wb");
+	fprintf(file, "id,ratio\n1,2.5\n");
+	fclose(file);
+	if ((loaded = dt_table_load("save_load_table.dtbl")))
+	{
+		fprintf(stderr, "Expected a CSV file to be rejected.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (table)
+		dt_table_free(&table);
+	if (loaded)
+		dt_table_free(&loaded);
+	if (slice)
+		dt_table_free(&slice);
+	if (copy)
+		dt_table_free(&copy);
+	remove("save_load_table.dtbl");
+	return status;
+}
@@ -0,0 +1,99 @@
+#include "DataTable.h"
+#include <stdio.h>
+
+int main()
+{
+	int status = -1;
+
+	struct DataTable* table = NULL;
+	struct DataColumn* column = NULL;
+
+	FILE* csv_file = fopen("shrink_table.csv", "w");
+	fprintf(csv_file, "small,negative,large,exact,inexact,name\n");
+	fprintf(csv_file, "0,-1000,5000000000,0.5,0.1,a\n");
+	fprintf(csv_file, "100,1000,1,1.25,0.2,b\n");
+	fprintf(csv_file, ",-3,2,-2.75,0.3,c\n");
+	fclose(csv_file);
+
+	struct dt_csv_options options;
+	dt_csv_options_init(&options);
+	options.shrink = true;
+	table = dt_table_read_csv_with_options("shrink_table.csv", &options);
+	if (!table)
+	{
+		fprintf(stderr, "Failed to read CSV.\n");
+		goto cleanup;
+	}
+
+	const enum data_type_e expected_types[6] = { UINT8, INT16, UINT64, FLOAT, DOUBLE, STRING };
+	for (size_t i = 0; i < 6; ++i)
+	{
+		if (table->columns[i].column->type != expected_types[i]
+				|| table->columns[i].column->type_size != dt_type_to_size(expected_types[i]))
+		{
+			fprintf(stderr, "Expected column %zu to be %s but got %s.\n",
+				i,
+				dt_type_to_str(expected_types[i]),
+				dt_type_to_str(table->columns[i].column->type));
+			goto cleanup;
+		}
+	}
+
+	if (*(uint8_t*)dt_table_get_value(table, 1, 0) != 100
+			|| *(int16_t*)dt_table_get_value(table, 2, 1) != -3
+			|| *(float*)dt_table_get_value(table, 2, 3) != -2.75f
+			|| table->columns[0].column->n_null_values != 1)
+	{
+		fprintf(stderr, "Expected values (and nulls) to be kept after shrinking.\n");
+		goto cleanup;
+	}
+
+	// appending after shrinking uses the new type
+	uint8_t value = 200;
+	dt_column_append_value(table->columns[0].column, &value);
+	uint8_t max = 0;
+	dt_column_max(table->columns[0].column, &max);
+	if (max != 200)
+	{
+		fprintf(stderr, "Expected max of 200 but got %u.\n", max);
+		goto cleanup;
+	}
+
+	// chunked columns are narrowed too
+	dt_column_create(&column, 0, INT64);
+	dt_column_make_chunked(column, 4);
+	for (int64_t i = -20; i < 20; ++i)
+		dt_column_append_value(column, &i);
+
+	if (dt_column_shrink(column) != DT_SUCCESS || column->type != INT8 || column->chunk_size != 4)
+	{
+		fprintf(stderr, "Expected chunked column to be shrunk to INT8.\n");
+		goto cleanup;
+	}
+
+	int8_t sum = 0;
+	dt_column_sum(column, &sum);
+	if (sum != -20 || *(int8_t*)dt_column_get_value_ptr(column, 0) != -20)
+	{
+		fprintf(stderr, "Expected sum of -20 but got %d.\n", sum);
+		goto cleanup;
+	}
+
+	// widening casts are done in place and keep null values
+	dt_column_set_value(column, 3, NULL);
+	dt_column_cast(column, INT64);
+	if (column->n_null_values != 1 || *(int64_t*)dt_column_get_value_ptr(column, 39) != 19)
+	{
+		fprintf(stderr, "Expected widening cast to keep values and nulls.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	if (table)
+		dt_table_free(&table);
+	if (column)
+		dt_column_free(&column);
+	remove("shrink_table.csv");
+	return status;
+}
@@ -0,0 +1,122 @@
+#include "DataTable.h"
+#include <stdio.h>
+
+int main()
+{
+	int status = -1;
+
+	char colnames[2][DT_MAX_COL_LEN] = { "col1", "col2" };
+	enum data_type_e types[2] = { INT32, STRING };
+	struct DataTable* table = dt_table_create(2, colnames, types);
+	struct DataTable* slice = NULL;
+	struct DataTable* head = NULL;
+	struct DataTable* tail = NULL;
+	struct DataTable* truncated = NULL;
+
+	char* words[10] = { "a", "b", "c", "d", "e", "f", "g", "h", "i", "j" };
+	for (int32_t i = 0; i < 10; ++i)
+	{
+		if (i == 4)
+			dt_table_insert_row(table, 2, NULL, words[i]);
+		else
+			dt_table_insert_row(table, 2, &i, words[i]);
+	}
+
+	slice = dt_table_slice(table, 3, 4);
+	if (!slice || slice->n_rows != 4)
+	{
+		fprintf(stderr, "Expected slice to have 4 rows.\n");
+		goto cleanup;
+	}
+
+	// the slice must reference (not copy) the parent buffers
+	if (dt_table_get_value(slice, 0, 0) != dt_table_get_value(table, 3, 0))
+	{
+		fprintf(stderr, "Expected slice to reference the parent's column buffer.\n");
+		goto cleanup;
+	}
+
+	const char** get_str = (const char**)dt_table_get_value(slice, 3, 1);
+	if (strcmp(*get_str, "g") != 0)
+	{
+		fprintf(stderr, "Expected slice[3, 1] to be 'g' but got '%s'.\n", *get_str);
+		goto cleanup;
+	}
+
+	// NULL at parent row 4 becomes row 1 in the slice
+	if (!dt_table_check_isnull(slice, 1, 0) || dt_table_check_isnull(slice, 0, 0))
+	{
+		fprintf(stderr, "Expected only slice[1, 0] to be NULL.\n");
+		goto cleanup;
+	}
+
+	// aggregates work directly on the slice: 3 + 0 (NULL) + 5 + 6
+	int32_t sum = 0;
+	dt_column_sum(dt_table_get_column_ptr_by_index(slice, 0), &sum);
+	if (sum != 14)
+	{
+		fprintf(stderr, "Expected sum of slice to be 14 but got %d.\n", sum);
+		goto cleanup;
+	}
+
+	if (!dt_table_to_csv(slice, "slice_output.csv", ','))
+	{
+		fprintf(stderr, "Failed to write slice to CSV.\n");
+		goto cleanup;
+	}
+
+	// modifying the slice must not modify the parent
+	int32_t new_value = 100;
+	dt_table_set_value(slice, 0, 0, &new_value);
+	const int32_t* get = dt_table_get_value(table, 3, 0);
+	if (*get != 3)
+	{
+		fprintf(stderr, "Expected parent value to remain 3 but got %d.\n", *get);
+		goto cleanup;
+	}
+
+	get = dt_table_get_value(slice, 0, 0);
+	if (*get != 100)
+	{
+		fprintf(stderr, "Expected slice value to be 100 but got %d.\n", *get);
+		goto cleanup;
+	}
+
+	head = dt_table_head(table, 2);
+	get = dt_table_get_value(head, 1, 0);
+	if (head->n_rows != 2 || *get != 1)
+	{
+		fprintf(stderr, "Expected head to have 2 rows ending with 1.\n");
+		goto cleanup;
+	}
+
+	tail = dt_table_tail(table, 3);
+	get = dt_table_get_value(tail, 0, 0);
+	if (tail->n_rows != 3 || *get != 7)
+	{
+		fprintf(stderr, "Expected tail to have 3 rows starting with 7.\n");
+		goto cleanup;
+	}
+
+	truncated = dt_table_slice(table, 8, 100);
+	if (!truncated || truncated->n_rows != 2)
+	{
+		fprintf(stderr, "Expected slice past the end to be truncated to 2 rows.\n");
+		goto cleanup;
+	}
+
+	if (dt_table_slice(table, 11, 1) != NULL)
+	{
+		fprintf(stderr, "Expected slice with offset past the end to be NULL.\n");
+		goto cleanup;
+	}
+
+	status = 0;
+cleanup:
+	dt_table_free(&slice);
+	dt_table_free(&head);
+	dt_table_free(&tail);
+	dt_table_free(&truncated);
+	dt_table_free(&table);
+	return status;
+}
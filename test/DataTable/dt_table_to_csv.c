@@ -2,9 +2,34 @@
 #include <stdio.h>
 #include <math.h>
 
+// the file at [filepath] must contain exactly [expected]
+static bool
+file_equals(
+	const char* filepath,
+	const char* expected)
+{
+	char content[256] = {0};
+	FILE* file = fopen(filepath, "rb");
+	if (!file)
+		return false;
+
+	const size_t size = fread(content, 1, sizeof(content) - 1, file);
+	fclose(file);
+	if (size != strlen(expected) || memcmp(content, expected, size) != 0)
+	{
+		fprintf(stderr, "Expected:\n%s\nbut got:\n%s\n", expected, content);
+		return false;
+	}
+
+	return true;
+}
+
 int main()
 {
 	int status = -1;
+	struct DataTable* strings = NULL;
+	struct DataTable* read = NULL;
+	char* long_value = NULL;
 
 	char colnames[2][DT_MAX_COL_LEN] = { "col1", "col2" };
 	enum data_type_e types[2] = { INT32, FLOAT };
@@ -27,8 +52,58 @@ int main()
     goto cleanup;
   }
 
+	// floats are written as the shortest value that reads back the same, nulls are empty
+	if (!file_equals("output.csv", "col1,col2\n10,5.5\n20,12.52\n,21.21\n"))
+		goto cleanup;
+
+	// strings are quoted when needed, and rows have no length limit
+	char string_colnames[3][DT_MAX_COL_LEN] = { "name", "value", "score" };
+	enum data_type_e string_types[3] = { STRING, STRING, DOUBLE };
+	strings = dt_table_create(3, string_colnames, string_types);
+
+	const size_t long_length = 100000;
+	long_value = calloc(long_length + 1, 1);
+	memset(long_value, 'x', long_length);
+
+	const char* names[4] = { "plain", "comma, \"quoted\"\nline", "", "long" };
+	const char* values[4] = { "a", "it's", "b", long_value };
+	const double scores[4] = { 0.1, 1e-7, 123456.789, -0.0 };
+	for (size_t i = 0; i < 4; ++i)
+		dt_table_insert_row(strings, 3, names[i], values[i], &scores[i]);
+
+	if (!dt_table_to_csv(strings, "output.csv", ','))
+	{
+		fprintf(stderr, "Failed to write strings to CSV.\n");
+		goto cleanup;
+	}
+
+	enum data_type_e read_types[3] = { STRING, STRING, DOUBLE };
+	read = dt_table_read_csv("output.csv", ',', read_types);
+	if (!read || read->n_rows != 4)
+	{
+		fprintf(stderr, "Expected to read 4 rows back.\n");
+		goto cleanup;
+	}
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		if (strcmp(*(char**)dt_table_get_value(read, i, 0), names[i]) != 0
+				|| strcmp(*(char**)dt_table_get_value(read, i, 1), values[i]) != 0
+				|| *(double*)dt_table_get_value(read, i, 2) != scores[i])
+		{
+			fprintf(stderr, "Row %zu changed after writing.\n", i);
+			goto cleanup;
+		}
+	}
+
 	status = 0;
 cleanup:
 	dt_table_free(&table);
+	if (strings)
+		dt_table_free(&strings);
+	if (read)
+		dt_table_free(&read);
+	free(long_value);
+	remove("output.csv");
 	return status;
 }
@@ -0,0 +1,56 @@
+#include "DataTable.h"
+#include "dt_test_helpers.h"
+#include <stdio.h>
+
+#define N_ROWS 150000
+
+int main()
+{
+	int status = -1;
+
+	// rows of very different lengths, with nulls and quoted strings
+	char colnames[4][DT_MAX_COL_LEN] = { "id", "name", "score", "day" };
+	enum data_type_e types[4] = { UINT64, STRING, DOUBLE, DATE };
+	struct DataTable* table = dt_table_create(4, colnames, types);
+
+	char name[512];
+	for (uint64_t i = 0; i < N_ROWS; ++i)
+	{
+		const size_t length = (size_t)(i * 7919 % 400);
+		memset(name, i % 5 == 0 ? ',' : 'n', length);
+		name[length] = '\0';
+
+		const double score = (double)i / 7.0;
+		const int32_t day = (int32_t)(i % 20000);
+		dt_table_insert_row(table, 4, &i, i % 11 == 0 ? NULL : name, i % 13 == 0 ? NULL : &score, &day);
+	}
+
+	struct dt_csv_write_options options;
+	dt_csv_write_options_init(&options);
+	options.n_threads = 1;
+	if (!dt_table_to_csv_with_options(table, "threads_serial.csv", &options))
+	{
+		fprintf(stderr, "Failed to write the table with one thread.\n");
+		goto cleanup;
+	}
+
+	// blocks are formatted in parallel but written in order
+	const size_t n_threads[3] = { 2, 5, 0 };
+	for (size_t i = 0; i < 3; ++i)
+	{
+		options.n_threads = n_threads[i];
+		if (!dt_table_to_csv_with_options(table, "threads_parallel.csv", &options)
+				|| !files_identical("threads_serial.csv", "threads_parallel.csv"))
+		{
+			fprintf(stderr, "Expected the same file with %zu threads.\n", n_threads[i]);
+			goto cleanup;
+		}
+	}
+
+	status = 0;
+cleanup:
+	dt_table_free(&table);
+	remove("threads_serial.csv");
+	remove("threads_parallel.csv");
+	return status;
+}
@@ -0,0 +1,78 @@
+#ifndef DT_TEST_HELPERS_H
+#define DT_TEST_HELPERS_H
+
+#include "DataTable.h"
+#include <stdio.h>
+
+/*
+ * comparisons shared by the tests checking that two ways of producing a table
+ * (or a file) give the same result.
+ */
+
+// every column name, type, time unit, null value and value of [table1] must be
+// identical to [table2]'s
+static inline bool
+tables_identical(
+	const struct DataTable* table1,
+	const struct DataTable* table2)
+{
+	if (table1->n_rows != table2->n_rows || table1->n_columns != table2->n_columns)
+		return false;
+
+	for (size_t col = 0; col < table1->n_columns; ++col)
+	{
+		const struct DataColumn* column1 = table1->columns[col].column;
+		const struct DataColumn* column2 = table2->columns[col].column;
+		if (strcmp(table1->columns[col].name, table2->columns[col].name) != 0
+				|| column1->type != column2->type
+				|| column1->time_unit != column2->time_unit
+				|| column1->n_null_values != column2->n_null_values)
+			return false;
+
+		for (size_t row = 0; row < table1->n_rows; ++row)
+		{
+			const bool is_null = dt_table_check_isnull(table1, row, col);
+			if (is_null != dt_table_check_isnull(table2, row, col))
+				return false;
+			if (is_null)
+				continue;
+
+			// (BOOL values are bits, their pointers are to a shared true/false value)
+			const void* value1 = dt_table_get_value(table1, row, col);
+			const void* value2 = dt_table_get_value(table2, row, col);
+			if (column1->type == BOOL ? *(const bool*)value1 != *(const bool*)value2
+					: column1->type == STRING ? strcmp(*(char* const*)value1, *(char* const*)value2) != 0
+					: memcmp(value1, value2, column1->type_size) != 0)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+// the files at [filepath1] and [filepath2] must be byte-identical
+static inline bool
+files_identical(
+	const char* filepath1,
+	const char* filepath2)
+{
+	FILE* file1 = fopen(filepath1, "rb");
+	FILE* file2 = fopen(filepath2, "rb");
+	bool identical = file1 && file2;
+	while (identical)
+	{
+		const int c1 = fgetc(file1);
+		const int c2 = fgetc(file2);
+		identical = c1 == c2;
+		if (c1 == EOF)
+			break;
+	}
+
+	if (file1)
+		fclose(file1);
+	if (file2)
+		fclose(file2);
+	return identical;
+}
+
+#endif